@@ -1,5 +1,6 @@
 #include "config.hpp"
 
+#include <cstdlib>
 #include <fstream>
 
 #include <nlohmann/json.hpp>
@@ -26,6 +27,7 @@ AppConfig getDefaultConfig() {
     config.playback.end_time_ms = 0;
     config.playback.speed = 1.0;
     config.playback.arm_delay_ms = 3000;
+    config.playback.collapse_duplicates = true;
 
     // Safety defaults
     config.safety.arm_channel = 4;  // CH5
@@ -35,12 +37,125 @@ AppConfig getDefaultConfig() {
     config.safety.arm_delay_ms = 3000;
     config.safety.disarm_frames = 10;
 
+    // Scheduling defaults
+    config.realtime.priority = 49;
+    config.realtime.prefer_isolated_cpus = true;
+    config.realtime.pin_uart_irq = false;
+    config.realtime.irq_priority = 50;
+    config.realtime.timer_slack_ns = 1;
+    config.realtime.prefault_stack_kb = 512;
+    config.realtime.prefault_heap_kb = 4096;
+
     // Logging defaults
     config.log_level = "info";
 
     return config;
 }
 
+namespace {
+
+Result<int> parseChannel(const json& value) {
+    int channel = value.get<int>();  // 1-indexed
+    if (channel < 1 || channel > static_cast<int>(CRSF_MAX_CHANNELS)) {
+        return Result<int>::failure(
+            ErrorCode::ConfigError,
+            "channel must be 1-16, got " + std::to_string(channel)
+        );
+    }
+    return Result<int>::success(channel - 1);
+}
+
+// One "transforms" entry; json type errors propagate to the caller
+Result<playback::TransformStep> parseTransformStep(const json& entry) {
+    using Op = playback::TransformStep::Op;
+    playback::TransformStep step;
+    auto fail = [](const std::string& message) {
+        return Result<playback::TransformStep>::failure(ErrorCode::ConfigError,
+                                                        "transforms: " + message);
+    };
+
+    std::string op = entry.at("op").get<std::string>();
+    if (op == "remap") {
+        step.op = Op::Remap;
+    } else if (op == "reverse") {
+        step.op = Op::Reverse;
+    } else if (op == "scale") {
+        step.op = Op::Scale;
+    } else if (op == "expo") {
+        step.op = Op::Expo;
+    } else if (op == "override") {
+        step.op = Op::Override;
+    } else {
+        return fail("unknown op '" + op + "'");
+    }
+
+    if (step.op == Op::Remap) {
+        const auto& map = entry.at("map");
+        if (!map.is_array() || map.size() != CRSF_MAX_CHANNELS) {
+            return fail("remap needs a map of 16 source channels");
+        }
+        for (size_t ch = 0; ch < CRSF_MAX_CHANNELS; ch++) {
+            auto source = parseChannel(map[ch]);
+            if (!source.ok()) {
+                return fail(source.message);
+            }
+            step.map[ch] = source.value;
+        }
+        return Result<playback::TransformStep>::success(step);
+    }
+
+    std::vector<json> channels;
+    if (entry.contains("channel")) {
+        channels.push_back(entry["channel"]);
+    }
+    if (entry.contains("channels")) {
+        for (const auto& value : entry["channels"]) {
+            channels.push_back(value);
+        }
+    }
+    if (channels.empty()) {
+        return fail(op + " needs \"channel\" or \"channels\"");
+    }
+    for (const auto& value : channels) {
+        auto channel = parseChannel(value);
+        if (!channel.ok()) {
+            return fail(channel.message);
+        }
+        step.channels.push_back(channel.value);
+    }
+
+    if (entry.contains("scale")) {
+        step.scale = entry["scale"].get<double>();
+    }
+    if (entry.contains("offset")) {
+        step.offset = entry["offset"].get<double>();
+    }
+    if (entry.contains("center")) {
+        step.center = entry["center"].get<double>();
+    }
+    if (entry.contains("expo")) {
+        step.expo = entry["expo"].get<double>();
+    }
+    if (entry.contains("value")) {
+        step.value = entry["value"].get<int16_t>();
+    }
+
+    if (step.op == Op::Expo && (step.expo < 0.0 || step.expo > 1.0)) {
+        return fail("expo must be 0.0-1.0");
+    }
+    if (step.op == Op::Override) {
+        if (!entry.contains("value")) {
+            return fail("override needs a value");
+        }
+        if (step.value < CRSF_CHANNEL_MIN || step.value > CRSF_CHANNEL_MAX) {
+            return fail("override value out of range");
+        }
+    }
+    return Result<playback::TransformStep>::success(step);
+}
+
+}  // namespace
+
 Result<AppConfig> loadConfig(const std::string& filepath) {
     std::ifstream file(filepath);
     if (!file.is_open()) {
@@ -61,6 +176,7 @@ Result<AppConfig> loadConfig(const std::string& filepath) {
     }
 
     AppConfig config = getDefaultConfig();
+    config.config_path = filepath;
 
     try {
         // Device settings
@@ -89,6 +205,9 @@ Result<AppConfig> loadConfig(const std::string& filepath) {
             if (playback.contains("arm_delay_ms")) {
                 config.playback.arm_delay_ms = playback["arm_delay_ms"].get<uint32_t>();
             }
+            if (playback.contains("collapse_duplicates")) {
+                config.playback.collapse_duplicates = playback["collapse_duplicates"].get<bool>();
+            }
         }
 
         // Safety settings
@@ -112,6 +231,59 @@ Result<AppConfig> loadConfig(const std::string& filepath) {
             if (safety.contains("disarm_frames")) {
                 config.safety.disarm_frames = safety["disarm_frames"].get<int>();
             }
+            if (safety.contains("limits")) {
+                for (const auto& entry : safety["limits"]) {
+                    int channel = entry.at("channel").get<int>();  // 1-indexed
+                    if (channel < 1 || channel > static_cast<int>(CRSF_MAX_CHANNELS)) {
+                        return Result<AppConfig>::failure(
+                            ErrorCode::ConfigError,
+                            "safety.limits: channel must be 1-16, got " + std::to_string(channel)
+                        );
+                    }
+                    auto& limit = config.safety.limits[static_cast<size_t>(channel - 1)];
+                    if (entry.contains("min")) {
+                        limit.min = entry["min"].get<int16_t>();
+                    }
+                    if (entry.contains("max")) {
+                        limit.max = entry["max"].get<int16_t>();
+                    }
+                    if (entry.contains("max_delta_per_ms")) {
+                        limit.max_delta_per_ms = entry["max_delta_per_ms"].get<float>();
+                    }
+                    if (entry.contains("deadband")) {
+                        limit.deadband = entry["deadband"].get<int16_t>();
+                    }
+                    if (limit.min > limit.max || limit.max_delta_per_ms < 0 || limit.deadband < 0) {
+                        return Result<AppConfig>::failure(
+                            ErrorCode::ConfigError,
+                            "safety.limits: invalid limit for channel " + std::to_string(channel)
+                        );
+                    }
+                }
+            }
+            if (safety.contains("watchdog")) {
+                const auto& watchdog = safety["watchdog"];
+                if (watchdog.contains("enabled")) {
+                    config.watchdog.enabled = watchdog["enabled"].get<bool>();
+                }
+                if (watchdog.contains("interval_ms")) {
+                    config.watchdog.interval_ms = watchdog["interval_ms"].get<uint32_t>();
+                }
+                if (watchdog.contains("priority")) {
+                    config.watchdog.priority = watchdog["priority"].get<int>();
+                }
+            }
+        }
+
+        // Channel transforms (applied in order)
+        if (j.contains("transforms")) {
+            for (const auto& entry : j["transforms"]) {
+                auto step = parseTransformStep(entry);
+                if (!step.ok()) {
+                    return Result<AppConfig>::failure(step.error, step.message);
+                }
+                config.transforms.push_back(step.value);
+            }
         }
 
         // Scheduling settings
@@ -121,6 +293,108 @@ Result<AppConfig> loadConfig(const std::string& filepath) {
                 // "realtime": true means RT enabled, so no_realtime is the inverse
                 config.no_realtime = !scheduling["realtime"].get<bool>();
             }
+            if (scheduling.contains("priority")) {
+                config.realtime.priority = scheduling["priority"].get<int>();
+            }
+            if (scheduling.contains("cpu_affinity")) {
+                config.realtime.cpu_affinity =
+                    scheduling["cpu_affinity"].get<std::vector<int>>();
+            }
+            if (scheduling.contains("prefer_isolated_cpus")) {
+                config.realtime.prefer_isolated_cpus =
+                    scheduling["prefer_isolated_cpus"].get<bool>();
+            }
+            if (scheduling.contains("pin_uart_irq")) {
+                config.realtime.pin_uart_irq = scheduling["pin_uart_irq"].get<bool>();
+            }
+            if (scheduling.contains("irq_cpu_affinity")) {
+                config.realtime.irq_cpu_affinity =
+                    scheduling["irq_cpu_affinity"].get<std::vector<int>>();
+            }
+            if (scheduling.contains("irq_priority")) {
+                config.realtime.irq_priority = scheduling["irq_priority"].get<int>();
+            }
+            if (scheduling.contains("timer_slack_ns")) {
+                config.realtime.timer_slack_ns = scheduling["timer_slack_ns"].get<long>();
+            }
+            if (scheduling.contains("prefault_stack_kb")) {
+                int64_t stack_kb = scheduling["prefault_stack_kb"].get<int64_t>();
+                if (stack_kb < 0 ||
+                    stack_kb > static_cast<int64_t>(elrs::scheduling::MAX_PREFAULT_STACK_KB)) {
+                    return Result<AppConfig>::failure(
+                        ErrorCode::ConfigError,
+                        "scheduling.prefault_stack_kb must be 0-" +
+                            std::to_string(elrs::scheduling::MAX_PREFAULT_STACK_KB) + ", got " +
+                            std::to_string(stack_kb)
+                    );
+                }
+                config.realtime.prefault_stack_kb = static_cast<size_t>(stack_kb);
+            }
+            if (scheduling.contains("prefault_heap_kb")) {
+                config.realtime.prefault_heap_kb = scheduling["prefault_heap_kb"].get<size_t>();
+            }
+        }
+
+        // Parsed-history cache
+        if (j.contains("history_cache")) {
+            const auto& history_cache = j["history_cache"];
+            if (history_cache.contains("enabled")) {
+                config.history_cache.enabled = history_cache["enabled"].get<bool>();
+            }
+            if (history_cache.contains("dir")) {
+                config.history_cache.dir = history_cache["dir"].get<std::string>();
+            }
+        }
+
+        // Flight recorder
+        if (j.contains("recorder")) {
+            const auto& recorder = j["recorder"];
+            if (recorder.contains("path")) {
+                config.record_path = recorder["path"].get<std::string>();
+            }
+            if (recorder.contains("ring_records")) {
+                config.recorder.ring_records = recorder["ring_records"].get<size_t>();
+            }
+            if (recorder.contains("flush_interval_ms")) {
+                config.recorder.flush_interval_ms = recorder["flush_interval_ms"].get<uint32_t>();
+            }
+        }
+
+        // Latency self-test thresholds
+        if (j.contains("latency_test")) {
+            const auto& latency_test = j["latency_test"];
+            if (latency_test.contains("duration_s")) {
+                config.latency_test.duration_s = latency_test["duration_s"].get<uint32_t>();
+            }
+            if (latency_test.contains("max_p99_us")) {
+                config.latency_test.max_p99_us = latency_test["max_p99_us"].get<int64_t>();
+            }
+            if (latency_test.contains("max_latency_us")) {
+                config.latency_test.max_latency_us = latency_test["max_latency_us"].get<int64_t>();
+            }
+            if (latency_test.contains("max_missed_slots")) {
+                config.latency_test.max_missed_slots =
+                    latency_test["max_missed_slots"].get<uint64_t>();
+            }
+        }
+
+        // Config hot reload
+        if (j.contains("reload")) {
+            const auto& reload = j["reload"];
+            if (reload.contains("enabled")) {
+                config.reload.enabled = reload["enabled"].get<bool>();
+            }
+            if (reload.contains("debounce_ms")) {
+                config.reload.debounce_ms = reload["debounce_ms"].get<uint32_t>();
+            }
+        }
+
+        // Control socket
+        if (j.contains("control")) {
+            const auto& control = j["control"];
+            if (control.contains("socket")) {
+                config.control_socket = control["socket"].get<std::string>();
+            }
         }
 
         // Logging settings
@@ -152,5 +426,23 @@ Result<AppConfig> loadConfig(const std::string& filepath) {
     return Result<AppConfig>::success(config);
 }
 
+std::string resolveHistoryCacheDir(const HistoryCacheConfig& cache) {
+    if (!cache.enabled) {
+        return "";
+    }
+    if (!cache.dir.empty()) {
+        return cache.dir;
+    }
+    const char* xdg = std::getenv("XDG_CACHE_HOME");
+    if (xdg && *xdg) {
+        return std::string(xdg) + "/expresslrs_sender";
+    }
+    const char* home = std::getenv("HOME");
+    if (home && *home) {
+        return std::string(home) + "/.cache/expresslrs_sender";
+    }
+    return "";
+}
+
 }  // namespace config
 }  // namespace elrs
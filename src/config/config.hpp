@@ -3,14 +3,41 @@
 #include <string>
 
 #include "expresslrs_sender/types.hpp"
+#include "playback/channel_transform.hpp"
 #include "playback/playback_controller.hpp"
+#include "recorder/flight_recorder.hpp"
+#include "safety/failsafe_watchdog.hpp"
 #include "safety/safety_monitor.hpp"
+#include "scheduling/realtime.hpp"
 
 namespace elrs {
 namespace config {
 
+// latency-test pass/fail thresholds (config "latency_test" section)
+struct LatencyTestConfig {
+    uint32_t duration_s = 10;       // Test length
+    int64_t max_p99_us = 200;       // 99th percentile wakeup latency limit
+    int64_t max_latency_us = 1000;  // Worst-case wakeup latency limit
+    uint64_t max_missed_slots = 0;  // Dropped slot limit
+};
+
+// Parsed-history cache (config "history_cache" section)
+struct HistoryCacheConfig {
+    bool enabled = true;
+    std::string dir;                // empty = $XDG_CACHE_HOME or ~/.cache + /expresslrs_sender
+};
+
+// Config file watching during play (config "reload" section)
+struct ReloadConfig {
+    bool enabled = false;
+    uint32_t debounce_ms = 200;     // Quiet time after the last file event before reloading
+};
+
 // Application configuration
 struct AppConfig {
+    // File this configuration was loaded from (empty = defaults)
+    std::string config_path;
+
     // Device settings
     std::string device_port = "/dev/ttyAMA0";
     int baudrate = CRSF_BAUDRATE;
@@ -20,11 +47,30 @@ struct AppConfig {
     // Playback defaults
     playback::PlaybackOptions playback;
 
+    // Channel transforms between playback and safety/encoding
+    playback::TransformConfig transforms;
+
     // Safety settings
     safety::SafetyConfig safety;
+    safety::WatchdogOptions watchdog;
 
     // Scheduling
     bool no_realtime = false;
+    scheduling::RealtimeOptions realtime;
+    LatencyTestConfig latency_test;
+
+    // History cache
+    HistoryCacheConfig history_cache;
+
+    // Flight recorder (empty path = disabled)
+    std::string record_path;
+    recorder::FlightRecorderOptions recorder;
+
+    // Config hot reload
+    ReloadConfig reload;
+
+    // Control socket during play (empty = disabled)
+    std::string control_socket;
 
     // Logging
     std::string log_level = "info";
@@ -37,5 +83,8 @@ Result<AppConfig> loadConfig(const std::string& filepath);
 // Get default configuration
 AppConfig getDefaultConfig();
 
+// Effective history cache directory (empty if disabled or no home found)
+std::string resolveHistoryCacheDir(const HistoryCacheConfig& cache);
+
 }  // namespace config
 }  // namespace elrs
@@ -0,0 +1,304 @@
+#include "config_watcher.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <spdlog/spdlog.h>
+
+namespace elrs {
+namespace config {
+
+std::vector<std::string> restartRequiredChanges(const AppConfig& before, const AppConfig& after) {
+    std::vector<std::string> changed;
+    auto check = [&changed](const char* key, bool differs) {
+        if (differs) {
+            changed.emplace_back(key);
+        }
+    };
+
+    check("device.port", before.device_port != after.device_port);
+    check("device.baudrate", before.baudrate != after.baudrate);
+    check("device.half_duplex", before.half_duplex != after.half_duplex);
+    check("device.gpio_tx", before.gpio_tx != after.gpio_tx);
+
+    check("playback.default_rate_hz", before.playback.rate_hz != after.playback.rate_hz);
+    check("playback.arm_delay_ms", before.playback.arm_delay_ms != after.playback.arm_delay_ms);
+    check("playback.collapse_duplicates",
+          before.playback.collapse_duplicates != after.playback.collapse_duplicates);
+    // Loop, direction and timing are fixed when the controller starts
+    const auto& pb_before = before.playback;
+    const auto& pb_after = after.playback;
+    check("playback.loop", pb_before.loop != pb_after.loop ||
+                           pb_before.loop_count != pb_after.loop_count ||
+                           pb_before.loop_mode != pb_after.loop_mode ||
+                           pb_before.crossfade_ms != pb_after.crossfade_ms);
+    check("playback.reverse", pb_before.reverse != pb_after.reverse);
+    check("playback.speed", pb_before.speed != pb_after.speed);
+    check("playback.range", pb_before.start_time_ms != pb_after.start_time_ms ||
+                            pb_before.end_time_ms != pb_after.end_time_ms);
+
+    // What counts as "armed" and the pre-encoded disarm/failsafe frames
+    check("safety.arm_channel", before.safety.arm_channel != after.safety.arm_channel);
+    check("safety.arm_threshold", before.safety.arm_threshold != after.safety.arm_threshold);
+    check("safety.throttle_min", before.safety.throttle_min != after.safety.throttle_min);
+    check("safety.disarm_frames", before.safety.disarm_frames != after.safety.disarm_frames);
+    check("safety.watchdog", before.watchdog.enabled != after.watchdog.enabled ||
+                             before.watchdog.interval_ms != after.watchdog.interval_ms ||
+                             before.watchdog.priority != after.watchdog.priority);
+
+    const auto& rt_before = before.realtime;
+    const auto& rt_after = after.realtime;
+    check("scheduling", before.no_realtime != after.no_realtime ||
+                        rt_before.priority != rt_after.priority ||
+                        rt_before.cpu_affinity != rt_after.cpu_affinity ||
+                        rt_before.prefer_isolated_cpus != rt_after.prefer_isolated_cpus ||
+                        rt_before.pin_uart_irq != rt_after.pin_uart_irq ||
+                        rt_before.irq_cpu_affinity != rt_after.irq_cpu_affinity ||
+                        rt_before.irq_priority != rt_after.irq_priority ||
+                        rt_before.timer_slack_ns != rt_after.timer_slack_ns ||
+                        rt_before.prefault_stack_kb != rt_after.prefault_stack_kb ||
+                        rt_before.prefault_heap_kb != rt_after.prefault_heap_kb);
+
+    check("history_cache", before.history_cache.enabled != after.history_cache.enabled ||
+                           before.history_cache.dir != after.history_cache.dir);
+    check("recorder", before.record_path != after.record_path ||
+                      before.recorder.ring_records != after.recorder.ring_records ||
+                      before.recorder.flush_interval_ms != after.recorder.flush_interval_ms);
+    check("reload", before.reload.enabled != after.reload.enabled ||
+                    before.reload.debounce_ms != after.reload.debounce_ms);
+    check("control.socket", before.control_socket != after.control_socket);
+    check("logging.file", before.log_file != after.log_file);
+    return changed;
+}
+
+ConfigWatcher::ConfigWatcher()
+    : m_debounce_ms(200)
+    , m_inotify_fd(-1)
+    , m_generation(0)
+    , m_running(false)
+    , m_reloads(0)
+    , m_rejected(0) {}
+
+ConfigWatcher::~ConfigWatcher() {
+    stop();
+}
+
+Result<void> ConfigWatcher::start(const AppConfig& running, ReloadCallback on_reload) {
+    stop();
+
+    if (running.config_path.empty()) {
+        return Result<void>::failure(ErrorCode::ConfigError, "No config file to watch (use -c)");
+    }
+    auto baseline = loadConfig(running.config_path);
+    if (!baseline.ok()) {
+        return Result<void>::failure(baseline.error, baseline.message);
+    }
+
+    m_path = running.config_path;
+    m_debounce_ms = running.reload.debounce_ms;
+    m_file_config = baseline.value;
+    m_on_reload = std::move(on_reload);
+    m_reloads = 0;
+    m_rejected = 0;
+
+    auto snapshot = std::make_shared<LiveConfig>();
+    snapshot->safety = running.safety;
+    snapshot->transforms = running.transforms;
+    snapshot->transform.compile(running.transforms);
+    snapshot->log_level = running.log_level;
+    {
+        std::lock_guard<std::mutex> lock(m_reload_mutex);
+        publish(std::move(snapshot));
+    }
+
+#ifdef __linux__
+    // Watch the directory: editors usually save by writing a new file and
+    // renaming it over the old one. Registered before returning so no
+    // change after start() is missed.
+    std::filesystem::path path(m_path);
+    std::string dir = path.has_parent_path() ? path.parent_path().string() : ".";
+    m_inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotify_fd >= 0 &&
+        inotify_add_watch(m_inotify_fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0) {
+        ::close(m_inotify_fd);
+        m_inotify_fd = -1;
+    }
+    if (m_inotify_fd < 0) {
+        spdlog::warn("inotify unavailable for {}, polling for config changes", dir);
+    }
+#endif
+
+    m_running = true;
+    m_thread = std::thread(&ConfigWatcher::run, this);
+    spdlog::info("Watching {} for config changes", m_path);
+    return Result<void>::success();
+}
+
+void ConfigWatcher::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_stop_mutex);
+        if (!m_running.exchange(false)) {
+            return;
+        }
+    }
+    m_stop_cv.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+#ifdef __linux__
+    if (m_inotify_fd >= 0) {
+        ::close(m_inotify_fd);
+        m_inotify_fd = -1;
+    }
+#endif
+}
+
+std::shared_ptr<const LiveConfig> ConfigWatcher::current() const {
+    return std::atomic_load(&m_current);
+}
+
+bool ConfigWatcher::reload() {
+    std::lock_guard<std::mutex> lock(m_reload_mutex);
+
+    auto result = loadConfig(m_path);
+    if (!result.ok()) {
+        m_rejected.fetch_add(1);
+        spdlog::error("Config reload failed, keeping current settings: {}", result.message);
+        return false;
+    }
+    const AppConfig& file = result.value;
+
+    auto changes = restartRequiredChanges(m_file_config, file);
+    if (!changes.empty()) {
+        std::string keys;
+        for (const auto& key : changes) {
+            keys += (keys.empty() ? "" : ", ") + key;
+        }
+        m_rejected.fetch_add(1);
+        spdlog::error("Config reload rejected, restart required to change: {}", keys);
+        return false;
+    }
+
+    // Everything not reloadable stays as published at start()
+    auto snapshot = std::make_shared<LiveConfig>(*current());
+    snapshot->safety.failsafe_timeout_ms = file.safety.failsafe_timeout_ms;
+    snapshot->safety.arm_delay_ms = file.safety.arm_delay_ms;
+    snapshot->safety.limits = file.safety.limits;
+    snapshot->transforms = file.transforms;
+    snapshot->transform.compile(file.transforms);
+    snapshot->log_level = file.log_level;
+    m_file_config = file;
+
+    publish(snapshot);
+    m_reloads.fetch_add(1);
+    spdlog::info("Config reloaded (generation {}): failsafe_timeout={}ms arm_delay={}ms "
+        "transforms={} steps log_level={}", snapshot->generation,
+        snapshot->safety.failsafe_timeout_ms, snapshot->safety.arm_delay_ms,
+        snapshot->transforms.size(), snapshot->log_level);
+    if (m_on_reload) {
+        m_on_reload(*snapshot);
+    }
+    collectRetired();
+    return true;
+}
+
+void ConfigWatcher::publish(std::shared_ptr<LiveConfig> snapshot) {
+    auto previous = std::atomic_load(&m_current);
+    snapshot->generation = previous ? previous->generation + 1 : 1;
+    uint64_t generation = snapshot->generation;
+
+    // Snapshot first: a reader that sees the new generation gets it
+    std::atomic_store(&m_current, std::shared_ptr<const LiveConfig>(std::move(snapshot)));
+    m_generation.store(generation, std::memory_order_release);
+    if (previous) {
+        m_retired.push_back(std::move(previous));
+    }
+}
+
+void ConfigWatcher::collectRetired() {
+    // No new reference to a retired snapshot can appear, so once ours is
+    // the last one every reader has moved on
+    m_retired.erase(std::remove_if(m_retired.begin(), m_retired.end(),
+                                   [](const auto& snapshot) { return snapshot.use_count() == 1; }),
+                    m_retired.end());
+}
+
+void ConfigWatcher::run() {
+#ifdef __linux__
+    int fd = m_inotify_fd;
+    if (fd < 0) {
+        pollModificationTime();
+        return;
+    }
+    std::string name = std::filesystem::path(m_path).filename().string();
+
+    bool pending = false;
+    auto last_event = std::chrono::steady_clock::now();
+    const auto debounce = std::chrono::milliseconds(m_debounce_ms);
+
+    while (m_running.load()) {
+        struct pollfd pfd{fd, POLLIN, 0};
+        int timeout_ms = pending ? static_cast<int>(m_debounce_ms) : 100;
+        if (::poll(&pfd, 1, timeout_ms) > 0) {
+            alignas(struct inotify_event) char buffer[4096];
+            ssize_t len;
+            while ((len = ::read(fd, buffer, sizeof(buffer))) > 0) {
+                for (char* p = buffer; p < buffer + len;) {
+                    const auto* event = reinterpret_cast<const struct inotify_event*>(p);
+                    if (event->len > 0 && name == event->name) {
+                        pending = true;
+                        last_event = std::chrono::steady_clock::now();
+                    }
+                    p += sizeof(struct inotify_event) + event->len;
+                }
+            }
+        }
+
+        if (pending && std::chrono::steady_clock::now() - last_event >= debounce) {
+            pending = false;
+            reload();
+        }
+
+        std::lock_guard<std::mutex> lock(m_reload_mutex);
+        collectRetired();
+    }
+#else
+    pollModificationTime();
+#endif
+}
+
+void ConfigWatcher::pollModificationTime() {
+    std::error_code ec;
+    auto last_write = std::filesystem::last_write_time(m_path, ec);
+
+    std::unique_lock<std::mutex> stop_lock(m_stop_mutex);
+    while (m_running.load()) {
+        m_stop_cv.wait_for(stop_lock, std::chrono::milliseconds(500));
+        if (!m_running.load()) {
+            break;
+        }
+
+        stop_lock.unlock();
+        auto write_time = std::filesystem::last_write_time(m_path, ec);
+        if (!ec && write_time != last_write) {
+            last_write = write_time;
+            std::this_thread::sleep_for(std::chrono::milliseconds(m_debounce_ms));
+            reload();
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_reload_mutex);
+            collectRetired();
+        }
+        stop_lock.lock();
+    }
+}
+
+}  // namespace config
+}  // namespace elrs
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "config/config.hpp"
+#include "expresslrs_sender/types.hpp"
+#include "playback/channel_transform.hpp"
+#include "safety/safety_monitor.hpp"
+
+namespace elrs {
+namespace config {
+
+// Settings that can change during playback, as one immutable snapshot.
+// Reloadable: safety.failsafe_timeout_ms, safety.arm_delay_ms,
+// safety.limits, transforms and logging.level. Everything else keeps its
+// startup value.
+struct LiveConfig {
+    uint64_t generation = 0;
+    safety::SafetyConfig safety;
+    playback::TransformConfig transforms;
+    playback::ChannelTransform transform;   // Compiled `transforms`
+    std::string log_level;
+};
+
+// Config keys that differ between two loaded configurations and only take
+// effect on restart (device, rates, arming, scheduling, ...)
+std::vector<std::string> restartRequiredChanges(const AppConfig& before, const AppConfig& after);
+
+// Watches the config file (inotify on Linux, mtime polling elsewhere) and
+// publishes a new LiveConfig when it changes. Parsing, validation and
+// transform compilation run on the watch thread; a file that fails to load
+// or changes a restart-only key is rejected as a whole and logged.
+//
+// Publication is RCU-style: the newest snapshot is swapped in atomically
+// and the generation counter bumped. The sender polls generation() (one
+// atomic load) each slot and calls current() only when it changed.
+// Replaced snapshots are kept until no reader holds them and freed on the
+// watch thread, so the sender never frees one.
+class ConfigWatcher {
+public:
+    // Runs on the watch thread after a snapshot is published
+    using ReloadCallback = std::function<void(const LiveConfig&)>;
+
+    ConfigWatcher();
+    ~ConfigWatcher();
+
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+    // Publish the first snapshot from `running` (the configuration in use,
+    // command-line overrides included) and start watching
+    // running.config_path. Restart-only keys are compared file to file, so
+    // overrides do not count as changes.
+    Result<void> start(const AppConfig& running, ReloadCallback on_reload = nullptr);
+
+    void stop();
+
+    bool isRunning() const { return m_running.load(); }
+
+    // Re-read the file now (the watch thread calls this after a change).
+    // Returns true if a new snapshot was published.
+    bool reload();
+
+    // Lock-free; changes whenever a new snapshot is published
+    uint64_t generation() const { return m_generation.load(std::memory_order_acquire); }
+
+    // Newest snapshot (nullptr before start())
+    std::shared_ptr<const LiveConfig> current() const;
+
+    uint64_t reloads() const { return m_reloads.load(); }
+    uint64_t rejected() const { return m_rejected.load(); }
+
+private:
+    void run();
+    void pollModificationTime();
+    void publish(std::shared_ptr<LiveConfig> snapshot);
+    void collectRetired();
+
+    std::string m_path;
+    uint32_t m_debounce_ms;
+    int m_inotify_fd;                                   // -1 = poll the modification time
+    AppConfig m_file_config;                            // Last accepted file contents
+    ReloadCallback m_on_reload;
+
+    std::shared_ptr<const LiveConfig> m_current;        // std::atomic_load/atomic_store only
+    std::atomic<uint64_t> m_generation;
+    std::mutex m_reload_mutex;                          // reload() and the retired list
+    std::vector<std::shared_ptr<const LiveConfig>> m_retired;
+
+    std::atomic<bool> m_running;
+    std::mutex m_stop_mutex;
+    std::condition_variable m_stop_cv;
+    std::thread m_thread;
+
+    std::atomic<uint64_t> m_reloads;
+    std::atomic<uint64_t> m_rejected;
+};
+
+}  // namespace config
+}  // namespace elrs
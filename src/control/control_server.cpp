@@ -0,0 +1,447 @@
+#include "control_server.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <spdlog/spdlog.h>
+
+namespace elrs {
+namespace control {
+
+namespace {
+
+static_assert(std::is_trivially_copyable<ControlStatus>::value, "status is copied as words");
+static_assert((ControlChannel::QUEUE_CAPACITY & (ControlChannel::QUEUE_CAPACITY - 1)) == 0,
+              "queue capacity must be a power of two");
+
+constexpr size_t MAX_CLIENTS = 8;
+constexpr size_t MAX_LINE = 256;
+
+#ifdef MSG_NOSIGNAL
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+constexpr int SEND_FLAGS = 0;
+#endif
+
+const char* playbackStateName(uint8_t state) {
+    switch (static_cast<PlaybackState>(state)) {
+        case PlaybackState::Stopped: return "stopped";
+        case PlaybackState::Playing: return "playing";
+        case PlaybackState::Paused: return "paused";
+    }
+    return "unknown";
+}
+
+const char* safetyStateName(uint8_t state) {
+    switch (static_cast<safety::SafetyState>(state)) {
+        case safety::SafetyState::Disarmed: return "disarmed";
+        case safety::SafetyState::ArmPending: return "arm_pending";
+        case safety::SafetyState::Armed: return "armed";
+        case safety::SafetyState::Failsafe: return "failsafe";
+        case safety::SafetyState::EmergencyStop: return "emergency_stop";
+    }
+    return "unknown";
+}
+
+// Request arguments: the remaining words, at most `max`; false if more
+bool readArguments(std::istringstream& in, size_t max, std::vector<std::string>& args) {
+    std::string word;
+    while (in >> word) {
+        if (args.size() == max) {
+            return false;
+        }
+        args.push_back(word);
+    }
+    return true;
+}
+
+// Whole-word numbers: "100abc" or "2x" are rejected, not truncated
+bool parseInteger(const std::string& text, long long& value) {
+    char* end = nullptr;
+    errno = 0;
+    value = std::strtoll(text.c_str(), &end, 10);
+    return !text.empty() && *end == '\0' && errno != ERANGE;
+}
+
+bool parseNumber(const std::string& text, double& value) {
+    char* end = nullptr;
+    errno = 0;
+    value = std::strtod(text.c_str(), &end);
+    return !text.empty() && *end == '\0' && errno != ERANGE;
+}
+
+// Write the whole response; false if the client went away or is not reading
+bool sendAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, SEND_FLAGS);
+        if (n <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+}  // namespace
+
+ControlChannel::ControlChannel(std::string name)
+    : m_name(std::move(name))
+    , m_head(0)
+    , m_tail(0)
+    , m_sequence(0) {
+    for (auto& word : m_published) {
+        word.store(0, std::memory_order_relaxed);
+    }
+    publishStatus();
+}
+
+bool ControlChannel::push(const ControlCommand& command) {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    if (head - m_tail.load(std::memory_order_acquire) >= QUEUE_CAPACITY) {
+        return false;
+    }
+    m_queue[head & (QUEUE_CAPACITY - 1)] = command;
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+size_t ControlChannel::available() const {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    return QUEUE_CAPACITY - (head - m_tail.load(std::memory_order_acquire));
+}
+
+bool ControlChannel::pop(ControlCommand& command) {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail == m_head.load(std::memory_order_acquire)) {
+        return false;
+    }
+    command = m_queue[tail & (QUEUE_CAPACITY - 1)];
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+void ControlChannel::publishStatus() {
+    uint64_t words[STATUS_WORDS] = {};
+    std::memcpy(words, &m_status, sizeof(ControlStatus));
+
+    uint32_t sequence = m_sequence.load(std::memory_order_relaxed);
+    m_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < STATUS_WORDS; i++) {
+        m_published[i].store(words[i], std::memory_order_relaxed);
+    }
+    m_sequence.store(sequence + 2, std::memory_order_release);
+}
+
+ControlStatus ControlChannel::readStatus() const {
+    uint64_t words[STATUS_WORDS];
+    while (true) {
+        uint32_t before = m_sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (size_t i = 0; i < STATUS_WORDS; i++) {
+            words[i] = m_published[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_sequence.load(std::memory_order_relaxed) == before) {
+            break;
+        }
+    }
+
+    ControlStatus status;
+    std::memcpy(&status, words, sizeof(ControlStatus));
+    return status;
+}
+
+void applyCommands(ControlChannel& channel, playback::PlaybackController& playback) {
+    ControlCommand command;
+    while (channel.pop(command)) {
+        switch (command.type) {
+            case ControlCommand::Type::Pause:
+                playback.pause();
+                break;
+            case ControlCommand::Type::Resume:
+                playback.resume();
+                break;
+            case ControlCommand::Type::Seek:
+                playback.seek(command.time_ms);
+                break;
+            case ControlCommand::Type::Speed:
+                playback.setSpeed(command.speed);
+                break;
+            case ControlCommand::Type::Loop:
+                playback.setLoop(command.loop, command.loop_count);
+                break;
+        }
+    }
+}
+
+void publishStatus(ControlChannel& channel, const playback::PlaybackController& playback,
+                   const safety::SafetyMonitor& safety_monitor) {
+    auto stats = playback.getStats();
+    const auto& options = playback.getOptions();
+
+    ControlStatus& status = channel.status();
+    status.playback_state = static_cast<uint8_t>(playback.getState());
+    status.safety_state = static_cast<uint8_t>(safety_monitor.getState());
+    status.loop = options.loop ? 1 : 0;
+    status.loop_count = options.loop_count;
+    status.speed = options.speed;
+    status.playback_time_ms = playback.getPlaybackTimeMs();
+    status.frames_sent = stats.frames_sent;
+    status.missed_slots = stats.missed_slots;
+    status.loops_completed = stats.loops_completed;
+    status.max_jitter_us = stats.max_jitter_us;
+    channel.publishStatus();
+}
+
+ControlServer::ControlServer()
+    : m_listen_fd(-1)
+    , m_running(false) {}
+
+ControlServer::~ControlServer() {
+    stop();
+}
+
+Result<void> ControlServer::start(const std::string& socket_path,
+                                  std::vector<ControlChannel*> channels) {
+    stop();
+
+    struct sockaddr_un addr{};
+    if (socket_path.empty() || socket_path.size() >= sizeof(addr.sun_path)) {
+        return Result<void>::failure(ErrorCode::ArgumentError,
+                                     "Invalid control socket path: " + socket_path);
+    }
+
+    // Replace a socket left behind by a previous run, nothing else
+    struct stat st{};
+    if (::lstat(socket_path.c_str(), &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) {
+            return Result<void>::failure(ErrorCode::ArgumentError,
+                                         socket_path + " exists and is not a socket");
+        }
+        ::unlink(socket_path.c_str());
+    }
+
+    m_listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (m_listen_fd < 0) {
+        return Result<void>::failure(ErrorCode::GeneralError,
+                                     std::string("socket() failed: ") + strerror(errno));
+    }
+    ::fcntl(m_listen_fd, F_SETFD, FD_CLOEXEC);
+
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+    if (::bind(m_listen_fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        ::listen(m_listen_fd, static_cast<int>(MAX_CLIENTS)) < 0) {
+        int err = errno;
+        ::close(m_listen_fd);
+        m_listen_fd = -1;
+        return Result<void>::failure(ErrorCode::GeneralError,
+                                     "Cannot listen on " + socket_path + ": " + strerror(err));
+    }
+    ::chmod(socket_path.c_str(), 0660);
+
+    m_socket_path = socket_path;
+    m_channels = std::move(channels);
+    m_running = true;
+    m_thread = std::thread(&ControlServer::run, this);
+    spdlog::info("Control socket: {}", socket_path);
+    return Result<void>::success();
+}
+
+void ControlServer::stop() {
+    if (m_running.exchange(false) && m_thread.joinable()) {
+        m_thread.join();
+    }
+    if (m_listen_fd >= 0) {
+        ::close(m_listen_fd);
+        m_listen_fd = -1;
+        ::unlink(m_socket_path.c_str());
+    }
+}
+
+std::string ControlServer::handleRequest(const std::string& line) {
+    std::istringstream in(line);
+    std::string verb;
+    in >> verb;
+
+    ControlCommand command;
+    if (verb == "pause") {
+        command.type = ControlCommand::Type::Pause;
+    } else if (verb == "resume") {
+        command.type = ControlCommand::Type::Resume;
+    } else if (verb == "seek") {
+        std::vector<std::string> args;
+        long long time_ms = -1;
+        if (!readArguments(in, 1, args) || args.size() != 1 ||
+            !parseInteger(args[0], time_ms) || time_ms < 0 || time_ms > UINT32_MAX) {
+            return "error usage: seek <ms>";
+        }
+        command.type = ControlCommand::Type::Seek;
+        command.time_ms = static_cast<uint32_t>(time_ms);
+    } else if (verb == "speed") {
+        std::vector<std::string> args;
+        double speed = 0;
+        if (!readArguments(in, 1, args) || args.size() != 1 ||
+            !parseNumber(args[0], speed) || !(speed > 0) || speed > 100) {
+            return "error usage: speed <factor> (0 < factor <= 100)";
+        }
+        command.type = ControlCommand::Type::Speed;
+        command.speed = speed;
+    } else if (verb == "loop") {
+        // loop on, loop on <count> or loop off
+        std::vector<std::string> args;
+        long long count = 0;
+        if (!readArguments(in, 2, args) || args.empty() ||
+            (args[0] != "on" && args[0] != "off") ||
+            (args.size() == 2 && (args[0] == "off" || !parseInteger(args[1], count) ||
+                                  count < 0 || count > INT32_MAX))) {
+            return "error usage: loop on [count] | loop off";
+        }
+        command.type = ControlCommand::Type::Loop;
+        command.loop = args[0] == "on";
+        command.loop_count = static_cast<int>(count);
+    } else if (verb == "stats" || verb == "telemetry") {
+        std::string out;
+        char buffer[320];
+        for (const auto* channel : m_channels) {
+            ControlStatus status = channel->readStatus();
+            if (verb == "stats") {
+                std::snprintf(buffer, sizeof(buffer),
+                    "port=%s state=%s safety=%s time_ms=%u speed=%.3f loop=%s loop_count=%d "
+                    "loops=%llu frames=%llu missed_slots=%llu max_jitter_us=%.1f\n",
+                    channel->name().c_str(), playbackStateName(status.playback_state),
+                    safetyStateName(status.safety_state), status.playback_time_ms,
+                    status.speed, status.loop ? "on" : "off", status.loop_count,
+                    static_cast<unsigned long long>(status.loops_completed),
+                    static_cast<unsigned long long>(status.frames_sent),
+                    static_cast<unsigned long long>(status.missed_slots),
+                    status.max_jitter_us);
+                out += buffer;
+            } else {
+                std::snprintf(buffer, sizeof(buffer), "port=%s bytes=%llu last=",
+                    channel->name().c_str(),
+                    static_cast<unsigned long long>(status.telemetry_bytes));
+                out += buffer;
+                size_t size = std::min<size_t>(status.telemetry_size, sizeof(status.telemetry));
+                for (size_t i = 0; i < size; i++) {
+                    std::snprintf(buffer, sizeof(buffer), "%02x", status.telemetry[i]);
+                    out += buffer;
+                }
+                out += "\n";
+            }
+        }
+        return out + "ok";
+    } else if (verb == "help") {
+        return "pause | resume | seek <ms> | speed <factor> | loop on [count] | loop off | "
+               "stats | telemetry\nok";
+    } else {
+        return "error unknown command '" + verb + "' (try help)";
+    }
+
+    // All ports or none, so they never disagree about playback state
+    for (const auto* channel : m_channels) {
+        if (channel->available() == 0) {
+            return "error command queue full on " + channel->name();
+        }
+    }
+    for (auto* channel : m_channels) {
+        channel->push(command);
+    }
+    return "ok";
+}
+
+void ControlServer::run() {
+    struct Client {
+        int fd;
+        std::string buffer;
+    };
+    std::vector<Client> clients;
+    std::vector<struct pollfd> fds;
+
+    while (m_running.load()) {
+        fds.clear();
+        fds.push_back({m_listen_fd, POLLIN, 0});
+        for (const auto& client : clients) {
+            fds.push_back({client.fd, POLLIN, 0});
+        }
+        if (::poll(fds.data(), static_cast<nfds_t>(fds.size()), 100) <= 0) {
+            continue;
+        }
+
+        for (size_t i = 0; i < clients.size(); i++) {
+            if ((fds[i + 1].revents & (POLLIN | POLLHUP | POLLERR)) == 0) {
+                continue;
+            }
+            Client& client = clients[i];
+            char data[512];
+            ssize_t n = ::read(client.fd, data, sizeof(data));
+            bool keep = n > 0;
+            if (keep) {
+                client.buffer.append(data, static_cast<size_t>(n));
+            }
+
+            size_t newline;
+            while (keep && (newline = client.buffer.find('\n')) != std::string::npos) {
+                std::string line = client.buffer.substr(0, newline);
+                client.buffer.erase(0, newline + 1);
+                if (!line.empty() && line.back() == '\r') {
+                    line.pop_back();
+                }
+                if (!line.empty()) {
+                    keep = sendAll(client.fd, handleRequest(line) + "\n");
+                }
+            }
+            if (keep && client.buffer.size() > MAX_LINE) {
+                sendAll(client.fd, "error line too long\n");
+                keep = false;
+            }
+            if (!keep) {
+                ::close(client.fd);
+                client.fd = -1;
+            }
+        }
+        clients.erase(std::remove_if(clients.begin(), clients.end(),
+                                     [](const Client& client) { return client.fd < 0; }),
+                      clients.end());
+
+        if (fds[0].revents & POLLIN) {
+            int fd = ::accept(m_listen_fd, nullptr, nullptr);
+            if (fd >= 0 && clients.size() >= MAX_CLIENTS) {
+                sendAll(fd, "error too many clients\n");
+                ::close(fd);
+            } else if (fd >= 0) {
+                // A client that stops reading cannot hold the thread up
+                struct timeval timeout{0, 100000};
+                ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+                ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+                clients.push_back({fd, ""});
+            }
+        }
+    }
+
+    for (const auto& client : clients) {
+        ::close(client.fd);
+    }
+}
+
+}  // namespace control
+}  // namespace elrs
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "expresslrs_sender/types.hpp"
+#include "playback/playback_controller.hpp"
+#include "safety/safety_monitor.hpp"
+
+namespace elrs {
+namespace control {
+
+// One control request, applied by the sender between slots
+struct ControlCommand {
+    enum class Type : uint8_t {
+        Pause,
+        Resume,
+        Seek,       // time_ms
+        Speed,      // speed
+        Loop        // loop, loop_count
+    };
+
+    Type type = Type::Pause;
+    uint32_t time_ms = 0;
+    double speed = 1.0;
+    bool loop = false;
+    int loop_count = 0;
+};
+
+// Per-port status published by the sender (read by "stats"/"telemetry")
+struct ControlStatus {
+    uint8_t playback_state = 0;     // PlaybackState
+    uint8_t safety_state = 0;       // SafetyState
+    uint8_t loop = 0;
+    uint8_t telemetry_size = 0;     // Bytes in telemetry[]
+    uint32_t playback_time_ms = 0;
+    int32_t loop_count = 0;
+    double speed = 1.0;
+    uint64_t frames_sent = 0;
+    uint64_t missed_slots = 0;
+    uint64_t loops_completed = 0;
+    double max_jitter_us = 0;
+    uint64_t telemetry_bytes = 0;   // Total received
+    uint8_t telemetry[32] = {};     // Start of the latest telemetry burst
+};
+
+// Control endpoint of one port. The command queue is single-producer
+// (control thread) / single-consumer (sender) and the status is a
+// seqlock written by the sender, so neither side ever waits for the other.
+class ControlChannel {
+public:
+    static constexpr size_t QUEUE_CAPACITY = 64;   // Power of two
+
+    explicit ControlChannel(std::string name = "");
+
+    ControlChannel(const ControlChannel&) = delete;
+    ControlChannel& operator=(const ControlChannel&) = delete;
+
+    const std::string& name() const { return m_name; }
+
+    // Control thread: false if the queue is full
+    bool push(const ControlCommand& command);
+    // Control thread: free queue slots. Only the producer fills the queue,
+    // so this many pushes are guaranteed to succeed.
+    size_t available() const;
+    // Control thread: latest published status (retries while a publish is
+    // in progress, which is a short copy)
+    ControlStatus readStatus() const;
+
+    // Sender: next queued command, if any
+    bool pop(ControlCommand& command);
+    // Sender: working copy, published by publishStatus()
+    ControlStatus& status() { return m_status; }
+    void publishStatus();
+
+private:
+    static constexpr size_t STATUS_WORDS = (sizeof(ControlStatus) + 7) / 8;
+
+    std::string m_name;
+
+    std::array<ControlCommand, QUEUE_CAPACITY> m_queue;
+    std::atomic<size_t> m_head;     // Next slot to write (producer)
+    std::atomic<size_t> m_tail;     // Next slot to read (consumer)
+
+    ControlStatus m_status;
+    std::atomic<uint32_t> m_sequence;                           // Odd while writing
+    std::array<std::atomic<uint64_t>, STATUS_WORDS> m_published;
+};
+
+// Sender side: apply queued commands to playback (call between slots)
+void applyCommands(ControlChannel& channel, playback::PlaybackController& playback);
+
+// Sender side: fill the status from playback and safety and publish it
+void publishStatus(ControlChannel& channel, const playback::PlaybackController& playback,
+                   const safety::SafetyMonitor& safety_monitor);
+
+// Unix stream socket serving a line protocol on a normal-priority thread:
+//   pause | resume | seek <ms> | speed <factor> | loop on [count] | loop off
+//   stats | telemetry | help
+// Each request is answered by zero or more data lines followed by "ok" or
+// "error <reason>". Commands go to every port, or to none if any port's
+// queue is full.
+class ControlServer {
+public:
+    ControlServer();
+    ~ControlServer();
+
+    ControlServer(const ControlServer&) = delete;
+    ControlServer& operator=(const ControlServer&) = delete;
+
+    // Bind `socket_path` (a stale socket file is replaced) and start the
+    // thread. The channels must outlive the server.
+    Result<void> start(const std::string& socket_path, std::vector<ControlChannel*> channels);
+
+    // Stop the thread, close clients and remove the socket file
+    void stop();
+
+    bool isRunning() const { return m_running.load(); }
+
+    // Answer one request line (what the thread does per line)
+    std::string handleRequest(const std::string& line);
+
+private:
+    void run();
+
+    std::string m_socket_path;
+    std::vector<ControlChannel*> m_channels;
+    int m_listen_fd;
+    std::atomic<bool> m_running;
+    std::thread m_thread;
+};
+
+}  // namespace control
+}  // namespace elrs
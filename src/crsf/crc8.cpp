@@ -4,7 +4,7 @@ namespace elrs {
 namespace crsf {
 
 // CRC-8 DVB-S2 lookup table (polynomial 0xD5)
-static const uint8_t crc8_table[256] = {
+const uint8_t crc8_dvb_s2_table[256] = {
     0x00, 0xD5, 0x7F, 0xAA, 0xFE, 0x2B, 0x81, 0x54,
     0x29, 0xFC, 0x56, 0x83, 0xD7, 0x02, 0xA8, 0x7D,
     0x52, 0x87, 0x2D, 0xF8, 0xAC, 0x79, 0xD3, 0x06,
@@ -40,7 +40,7 @@ static const uint8_t crc8_table[256] = {
 };
 
 uint8_t crc8_dvb_s2(uint8_t crc, uint8_t data) {
-    return crc8_table[crc ^ data];
+    return crc8_dvb_s2_table[crc ^ data];
 }
 
 uint8_t crc8_dvb_s2(const uint8_t* data, size_t len) {
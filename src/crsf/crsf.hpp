@@ -14,6 +14,9 @@ namespace crsf {
 uint8_t crc8_dvb_s2(uint8_t crc, uint8_t data);
 uint8_t crc8_dvb_s2(const uint8_t* data, size_t len);
 
+// CRC-8 DVB-S2 lookup table (for inlined fixed-length CRCs)
+extern const uint8_t crc8_dvb_s2_table[256];
+
 // Channel value conversion
 int16_t pwmToCrsf(int16_t pwm);
 int16_t crsfToPwm(int16_t crsf);
@@ -0,0 +1,168 @@
+#include "columnar_history.hpp"
+
+#include <algorithm>
+
+namespace elrs {
+namespace history {
+
+namespace {
+
+constexpr unsigned PACKED_BITS = 11;
+constexpr uint32_t PACKED_MASK = (1u << PACKED_BITS) - 1;
+
+// Bytes needed for `count` packed values, plus 2 bytes so every value can
+// be read with a fixed 3-byte load
+size_t packedBytes(size_t count) {
+    return (count * PACKED_BITS + 7) / 8 + 2;
+}
+
+void packValue(std::vector<uint8_t>& packed, size_t index, uint32_t value) {
+    size_t bit = index * PACKED_BITS;
+    size_t byte = bit >> 3;
+    uint32_t shifted = (value & PACKED_MASK) << (bit & 7);
+    packed[byte] |= static_cast<uint8_t>(shifted);
+    packed[byte + 1] |= static_cast<uint8_t>(shifted >> 8);
+    packed[byte + 2] |= static_cast<uint8_t>(shifted >> 16);
+}
+
+uint32_t unpackValue(const std::vector<uint8_t>& packed, size_t index) {
+    size_t bit = index * PACKED_BITS;
+    const uint8_t* p = packed.data() + (bit >> 3);
+    uint32_t word = static_cast<uint32_t>(p[0]) |
+        (static_cast<uint32_t>(p[1]) << 8) |
+        (static_cast<uint32_t>(p[2]) << 16);
+    return (word >> (bit & 7)) & PACKED_MASK;
+}
+
+}  // namespace
+
+ColumnarHistory ColumnarHistory::fromFrames(const std::vector<HistoryFrame>& source,
+                                            bool collapse_duplicates) {
+    ColumnarHistory history;
+    history.m_source_frames = source.size();
+    if (!source.empty()) {
+        history.m_end_timestamp = source.back().timestamp_ms;
+    }
+
+    // Keyframes: first frame of every run of identical channels
+    std::vector<HistoryFrame> keyframes;
+    if (collapse_duplicates) {
+        for (const auto& frame : source) {
+            if (keyframes.empty() || keyframes.back().channels != frame.channels) {
+                keyframes.push_back(frame);
+            }
+        }
+    }
+    const std::vector<HistoryFrame>& frames = collapse_duplicates ? keyframes : source;
+    size_t count = frames.size();
+
+    history.m_timestamps.reserve(count);
+    history.m_change_points.assign((count + 63) / 64, 0);
+    for (size_t i = 0; i < count; i++) {
+        history.m_timestamps.push_back(frames[i].timestamp_ms);
+        if (i == 0 || frames[i].channels != frames[i - 1].channels) {
+            history.m_change_points[i >> 6] |= uint64_t{1} << (i & 63);
+        }
+    }
+
+    for (size_t ch = 0; ch < CRSF_MAX_CHANNELS; ch++) {
+        Column& column = history.m_columns[ch];
+        if (count == 0) {
+            continue;
+        }
+
+        int16_t first = frames[0].channels[ch];
+        bool constant = true;
+        bool fits = true;
+        for (const auto& frame : frames) {
+            int16_t value = frame.channels[ch];
+            constant = constant && value == first;
+            fits = fits && value >= 0 && static_cast<uint32_t>(value) <= PACKED_MASK;
+        }
+
+        if (constant) {
+            column.encoding = Encoding::Constant;
+            column.constant = first;
+            history.m_constant_mask |= static_cast<uint16_t>(1u << ch);
+        } else if (fits) {
+            column.encoding = Encoding::Packed11;
+            column.packed.assign(packedBytes(count), 0);
+            for (size_t i = 0; i < count; i++) {
+                packValue(column.packed, i, static_cast<uint32_t>(frames[i].channels[ch]));
+            }
+        } else {
+            column.encoding = Encoding::Raw16;
+            column.raw.reserve(count);
+            for (const auto& frame : frames) {
+                column.raw.push_back(frame.channels[ch]);
+            }
+        }
+    }
+
+    return history;
+}
+
+uint32_t ColumnarHistory::duration(size_t index) const {
+    uint32_t end = (index + 1 < m_timestamps.size()) ? m_timestamps[index + 1] : m_end_timestamp;
+    return end - m_timestamps[index];
+}
+
+size_t ColumnarHistory::nextChangePoint(size_t index) const {
+    size_t i = index + 1;
+    while (i < m_timestamps.size()) {
+        uint64_t word = m_change_points[i >> 6] >> (i & 63);
+        if (word) {
+            i += static_cast<size_t>(__builtin_ctzll(word));
+            return std::min(i, m_timestamps.size());
+        }
+        i = (i | 63) + 1;
+    }
+    return m_timestamps.size();
+}
+
+int16_t ColumnarHistory::channel(size_t index, size_t ch) const {
+    const Column& column = m_columns[ch];
+    switch (column.encoding) {
+        case Encoding::Packed11:
+            return static_cast<int16_t>(unpackValue(column.packed, index));
+        case Encoding::Raw16:
+            return column.raw[index];
+        case Encoding::Constant:
+        default:
+            return column.constant;
+    }
+}
+
+void ColumnarHistory::readChannels(size_t index, ChannelData& out) const {
+    for (size_t ch = 0; ch < CRSF_MAX_CHANNELS; ch++) {
+        out[ch] = channel(index, ch);
+    }
+}
+
+HistoryFrame ColumnarHistory::frame(size_t index) const {
+    HistoryFrame frame{};
+    frame.timestamp_ms = m_timestamps[index];
+    readChannels(index, frame.channels);
+    return frame;
+}
+
+std::vector<HistoryFrame> ColumnarHistory::toFrames() const {
+    std::vector<HistoryFrame> frames(size());
+    for (size_t i = 0; i < frames.size(); i++) {
+        frames[i] = frame(i);
+    }
+    return frames;
+}
+
+size_t ColumnarHistory::memoryBytes() const {
+    size_t bytes = m_timestamps.capacity() * sizeof(uint32_t);
+    bytes += m_change_points.capacity() * sizeof(uint64_t);
+    for (const auto& column : m_columns) {
+        bytes += column.packed.capacity();
+        bytes += column.raw.capacity() * sizeof(int16_t);
+    }
+    return bytes;
+}
+
+}  // namespace history
+}  // namespace elrs
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "expresslrs_sender/types.hpp"
+
+namespace elrs {
+namespace history {
+
+// Structure-of-arrays history storage.
+// Timestamps are kept in their own column; each channel is stored as a
+// constant (elided, flagged in the constant mask), a bit-packed 11-bit
+// column (values 0-2047) or, if any value falls outside that range, a raw
+// int16_t column. Conversion from/to HistoryFrame is lossless.
+//
+// With collapse_duplicates, runs of consecutive frames with identical
+// channels are stored once as a keyframe lasting until the next keyframe
+// (the last one until endTimestamp()). "Frame at or before t" lookups give
+// the same channels as the uncollapsed history.
+class ColumnarHistory {
+public:
+    ColumnarHistory() = default;
+
+    // Build from row-oriented frames
+    static ColumnarHistory fromFrames(const std::vector<HistoryFrame>& frames,
+                                      bool collapse_duplicates = false);
+
+    size_t size() const { return m_timestamps.size(); }
+    bool empty() const { return m_timestamps.empty(); }
+
+    uint32_t timestamp(size_t index) const { return m_timestamps[index]; }
+    const std::vector<uint32_t>& timestamps() const { return m_timestamps; }
+
+    // Timestamp of the last source frame (end of the last keyframe)
+    uint32_t endTimestamp() const { return m_end_timestamp; }
+
+    // How long frame `index` stays current
+    uint32_t duration(size_t index) const;
+
+    // Number of frames before collapsing
+    size_t sourceFrameCount() const { return m_source_frames; }
+
+    // Change-point index: true if frame `index` differs from frame index-1
+    // (frame 0 is always a change point)
+    bool isChangePoint(size_t index) const {
+        return (m_change_points[index >> 6] >> (index & 63)) & 1u;
+    }
+
+    // First change point after `index`, size() if none
+    size_t nextChangePoint(size_t index) const;
+
+    // Single channel value of frame `index`
+    int16_t channel(size_t index, size_t ch) const;
+
+    // Decode all channels of frame `index` into `out` (no allocation)
+    void readChannels(size_t index, ChannelData& out) const;
+
+    HistoryFrame frame(size_t index) const;
+    std::vector<HistoryFrame> toFrames() const;
+
+    // Bit n set = channel n+1 has the same value in every frame
+    uint16_t constantMask() const { return m_constant_mask; }
+    bool isConstant(size_t ch) const { return (m_constant_mask >> ch) & 1u; }
+
+    // Approximate heap usage of the columns in bytes
+    size_t memoryBytes() const;
+
+private:
+    enum class Encoding : uint8_t { Constant, Packed11, Raw16 };
+
+    struct Column {
+        Encoding encoding = Encoding::Constant;
+        int16_t constant = CRSF_CHANNEL_MID;
+        std::vector<uint8_t> packed;    // 11 bits per frame, LSB first
+        std::vector<int16_t> raw;
+    };
+
+    std::vector<uint32_t> m_timestamps;
+    std::array<Column, CRSF_MAX_CHANNELS> m_columns;
+    uint16_t m_constant_mask = 0;
+    uint32_t m_end_timestamp = 0;
+    size_t m_source_frames = 0;
+    std::vector<uint64_t> m_change_points;  // bitmap, one bit per frame
+};
+
+}  // namespace history
+}  // namespace elrs
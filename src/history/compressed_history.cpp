@@ -0,0 +1,333 @@
+#include "compressed_history.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace elrs {
+namespace history {
+
+namespace {
+
+constexpr char MAGIC[4] = {'E', 'L', 'R', 'Z'};
+constexpr size_t HEADER_SIZE = 20;
+constexpr size_t INDEX_ENTRY_SIZE = 16;
+
+void putU16(std::vector<uint8_t>& out, uint16_t v) {
+    out.push_back(static_cast<uint8_t>(v));
+    out.push_back(static_cast<uint8_t>(v >> 8));
+}
+
+void putU32(std::vector<uint8_t>& out, uint32_t v) {
+    for (int i = 0; i < 4; i++) {
+        out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+    }
+}
+
+void setU32(std::vector<uint8_t>& out, size_t at, uint32_t v) {
+    for (int i = 0; i < 4; i++) {
+        out[at + i] = static_cast<uint8_t>(v >> (8 * i));
+    }
+}
+
+uint16_t getU16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t getU32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+        (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+void putVarint(std::vector<uint8_t>& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+uint64_t zigzag(int64_t v) {
+    return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+int64_t unzigzag(uint64_t v) {
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+void encodeBlock(std::vector<uint8_t>& out, const HistoryFrame* frames, size_t count) {
+    const HistoryFrame& first = frames[0];
+    putVarint(out, first.timestamp_ms);
+    for (int16_t value : first.channels) {
+        putVarint(out, zigzag(value));
+    }
+
+    size_t i = 1;
+    while (i < count) {
+        const HistoryFrame& prev = frames[i - 1];
+        const HistoryFrame& cur = frames[i];
+        int64_t dt = static_cast<int64_t>(cur.timestamp_ms) - static_cast<int64_t>(prev.timestamp_ms);
+
+        if (cur.channels == prev.channels) {
+            // Run of unchanged channels with a constant timestamp step
+            size_t run = 1;
+            while (i + run < count &&
+                   frames[i + run].channels == cur.channels &&
+                   static_cast<int64_t>(frames[i + run].timestamp_ms) -
+                       static_cast<int64_t>(frames[i + run - 1].timestamp_ms) == dt) {
+                run++;
+            }
+            putVarint(out, (static_cast<uint64_t>(run) << 1) | 1);
+            putVarint(out, zigzag(dt));
+            i += run;
+            continue;
+        }
+
+        uint32_t mask = 0;
+        for (size_t ch = 0; ch < CRSF_MAX_CHANNELS; ch++) {
+            if (cur.channels[ch] != prev.channels[ch]) {
+                mask |= 1u << ch;
+            }
+        }
+        putVarint(out, static_cast<uint64_t>(mask) << 1);
+        putVarint(out, zigzag(dt));
+        for (size_t ch = 0; ch < CRSF_MAX_CHANNELS; ch++) {
+            if (mask & (1u << ch)) {
+                putVarint(out, zigzag(static_cast<int64_t>(cur.channels[ch]) - prev.channels[ch]));
+            }
+        }
+        i++;
+    }
+}
+
+}  // namespace
+
+std::vector<uint8_t> encodeCompressedHistory(const std::vector<HistoryFrame>& frames,
+                                             uint32_t block_frames) {
+    block_frames = std::max<uint32_t>(1, block_frames);
+    uint32_t block_count = static_cast<uint32_t>((frames.size() + block_frames - 1) / block_frames);
+
+    std::vector<uint8_t> out;
+    out.reserve(HEADER_SIZE + block_count * INDEX_ENTRY_SIZE + frames.size() * 4);
+    for (char c : MAGIC) {
+        out.push_back(static_cast<uint8_t>(c));
+    }
+    putU16(out, COMPRESSED_HISTORY_VERSION);
+    putU16(out, CRSF_MAX_CHANNELS);
+    putU32(out, static_cast<uint32_t>(frames.size()));
+    putU32(out, block_frames);
+    putU32(out, block_count);
+
+    size_t index_at = out.size();
+    out.resize(out.size() + block_count * INDEX_ENTRY_SIZE);
+    size_t data_at = out.size();
+
+    for (uint32_t b = 0; b < block_count; b++) {
+        size_t first = static_cast<size_t>(b) * block_frames;
+        size_t count = std::min<size_t>(block_frames, frames.size() - first);
+        size_t start = out.size();
+        encodeBlock(out, frames.data() + first, count);
+
+        size_t entry = index_at + b * INDEX_ENTRY_SIZE;
+        setU32(out, entry, static_cast<uint32_t>(first));
+        setU32(out, entry + 4, frames[first].timestamp_ms);
+        setU32(out, entry + 8, static_cast<uint32_t>(start - data_at));
+        setU32(out, entry + 12, static_cast<uint32_t>(out.size() - start));
+    }
+
+    return out;
+}
+
+Result<void> saveCompressedHistory(const std::string& filepath,
+                                   const std::vector<HistoryFrame>& frames,
+                                   uint32_t block_frames) {
+    auto data = encodeCompressedHistory(frames, block_frames);
+
+    std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return Result<void>::failure(ErrorCode::HistoryError, "Cannot create file: " + filepath);
+    }
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    if (!file) {
+        return Result<void>::failure(ErrorCode::HistoryError, "Write failed: " + filepath);
+    }
+    return Result<void>::success();
+}
+
+bool isCompressedHistory(const uint8_t* data, size_t size) {
+    return size >= sizeof(MAGIC) && std::memcmp(data, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+CompressedHistoryReader::CompressedHistoryReader()
+    : m_data(nullptr)
+    , m_size(0)
+    , m_blocks(nullptr)
+    , m_frame_count(0)
+    , m_block_frames(0) {}
+
+Result<void> CompressedHistoryReader::open(const std::string& filepath) {
+    auto result = m_file.open(filepath);
+    if (!result.ok()) {
+        return result;
+    }
+    return openBuffer(reinterpret_cast<const uint8_t*>(m_file.data()), m_file.size());
+}
+
+Result<void> CompressedHistoryReader::openBuffer(const uint8_t* data, size_t size) {
+    m_error.clear();
+    m_index.clear();
+
+    if (size < HEADER_SIZE || !isCompressedHistory(data, size)) {
+        return Result<void>::failure(ErrorCode::HistoryError, "Not a compressed history file");
+    }
+
+    uint16_t version = getU16(data + 4);
+    uint16_t channels = getU16(data + 6);
+    if (version != COMPRESSED_HISTORY_VERSION || channels != CRSF_MAX_CHANNELS) {
+        return Result<void>::failure(
+            ErrorCode::HistoryError,
+            "Unsupported compressed history version " + std::to_string(version)
+        );
+    }
+
+    m_frame_count = getU32(data + 8);
+    m_block_frames = getU32(data + 12);
+    uint32_t block_count = getU32(data + 16);
+
+    size_t data_at = HEADER_SIZE + static_cast<size_t>(block_count) * INDEX_ENTRY_SIZE;
+    if (data_at > size || m_block_frames == 0 ||
+        static_cast<uint64_t>(block_count) * m_block_frames < m_frame_count) {
+        return Result<void>::failure(ErrorCode::HistoryError, "Corrupt compressed history header");
+    }
+
+    m_index.reserve(block_count);
+    for (uint32_t b = 0; b < block_count; b++) {
+        const uint8_t* p = data + HEADER_SIZE + b * INDEX_ENTRY_SIZE;
+        BlockIndex entry{getU32(p), getU32(p + 4), getU32(p + 8), getU32(p + 12)};
+        if (data_at + entry.offset + entry.size > size || entry.first_frame >= m_frame_count) {
+            return Result<void>::failure(ErrorCode::HistoryError, "Corrupt compressed history index");
+        }
+        m_index.push_back(entry);
+    }
+
+    m_data = data;
+    m_size = size;
+    m_blocks = data + data_at;
+    seekBlock(0);
+
+    return Result<void>::success();
+}
+
+void CompressedHistoryReader::seekBlock(size_t block) {
+    m_cursor = Cursor{};
+    m_cursor.block = block;
+    if (block < m_index.size()) {
+        size_t next_first = (block + 1 < m_index.size())
+            ? m_index[block + 1].first_frame
+            : m_frame_count;
+        m_cursor.frames_left = next_first - m_index[block].first_frame;
+    }
+}
+
+void CompressedHistoryReader::seek(uint32_t timestamp_ms) {
+    // Last block starting at or before the timestamp
+    auto it = std::upper_bound(
+        m_index.begin(), m_index.end(), timestamp_ms,
+        [](uint32_t ts, const BlockIndex& entry) { return ts < entry.first_timestamp; });
+    size_t block = (it == m_index.begin()) ? 0 : static_cast<size_t>(it - m_index.begin()) - 1;
+    seekBlock(block);
+
+    // Decode forward while frames are not after the target, then rewind to
+    // the last one so next() returns it
+    Cursor candidate = m_cursor;
+    HistoryFrame frame{};
+    while (true) {
+        Cursor before = m_cursor;
+        if (!next(frame) || frame.timestamp_ms > timestamp_ms) {
+            break;
+        }
+        candidate = before;
+    }
+    m_cursor = candidate;
+}
+
+bool CompressedHistoryReader::next(HistoryFrame& frame) {
+    Cursor& c = m_cursor;
+
+    while (c.frames_left == 0) {
+        if (c.block + 1 >= m_index.size()) {
+            return false;
+        }
+        seekBlock(c.block + 1);
+    }
+
+    if (!c.started) {
+        uint64_t value = 0;
+        if (!readVarint(value)) return false;
+        c.timestamp = static_cast<uint32_t>(value);
+        for (size_t ch = 0; ch < CRSF_MAX_CHANNELS; ch++) {
+            if (!readVarint(value)) return false;
+            c.channels[ch] = static_cast<int16_t>(unzigzag(value));
+        }
+        c.started = true;
+    } else if (c.run_left > 0) {
+        c.timestamp = static_cast<uint32_t>(c.timestamp + c.run_delta);
+        c.run_left--;
+    } else {
+        uint64_t tag = 0;
+        uint64_t value = 0;
+        if (!readVarint(tag) || !readVarint(value)) return false;
+        int64_t dt = unzigzag(value);
+
+        if (tag & 1) {
+            uint64_t run = tag >> 1;
+            if (run == 0 || run > c.frames_left) {
+                return fail("Corrupt run length in compressed history");
+            }
+            c.run_delta = dt;
+            c.run_left = static_cast<uint32_t>(run - 1);
+        } else {
+            uint64_t mask = tag >> 1;
+            if (mask == 0 || mask >> CRSF_MAX_CHANNELS) {
+                return fail("Corrupt channel mask in compressed history");
+            }
+            for (size_t ch = 0; ch < CRSF_MAX_CHANNELS; ch++) {
+                if (mask & (1u << ch)) {
+                    if (!readVarint(value)) return false;
+                    c.channels[ch] = static_cast<int16_t>(c.channels[ch] + unzigzag(value));
+                }
+            }
+        }
+        c.timestamp = static_cast<uint32_t>(c.timestamp + dt);
+    }
+
+    c.frames_left--;
+    frame.timestamp_ms = c.timestamp;
+    frame.channels = c.channels;
+    return true;
+}
+
+bool CompressedHistoryReader::readVarint(uint64_t& value) {
+    const BlockIndex& entry = m_index[m_cursor.block];
+    const uint8_t* p = m_blocks + entry.offset;
+    value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        if (m_cursor.pos >= entry.size) {
+            return fail("Truncated block in compressed history");
+        }
+        uint8_t byte = p[m_cursor.pos++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return fail("Corrupt varint in compressed history");
+}
+
+bool CompressedHistoryReader::fail(const std::string& message) {
+    m_error = message;
+    return false;
+}
+
+}  // namespace history
+}  // namespace elrs
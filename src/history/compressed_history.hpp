@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "expresslrs_sender/types.hpp"
+#include "mapped_file.hpp"
+
+namespace elrs {
+namespace history {
+
+// Compressed history file (.elrsz)
+//
+// Layout (little endian):
+//   header  "ELRZ", u16 version, u16 channel count, u32 frame count,
+//           u32 frames per block, u32 block count
+//   index   per block: u32 first frame, u32 first timestamp,
+//           u32 data offset, u32 data size
+//   data    blocks, each decodable on its own
+//
+// A block starts with an absolute frame (varint timestamp, zigzag varint
+// per channel). Each following record starts with a varint tag:
+//   tag & 1 == 1  run of (tag >> 1) frames with unchanged channels, then
+//                 zigzag varint timestamp delta shared by the whole run
+//   tag & 1 == 0  changed-channel mask (tag >> 1), zigzag varint timestamp
+//                 delta, then a zigzag varint delta per changed channel
+constexpr uint32_t COMPRESSED_HISTORY_VERSION = 1;
+constexpr uint32_t COMPRESSED_HISTORY_BLOCK_FRAMES = 4096;
+
+// Encode frames into the .elrsz byte layout
+std::vector<uint8_t> encodeCompressedHistory(
+    const std::vector<HistoryFrame>& frames,
+    uint32_t block_frames = COMPRESSED_HISTORY_BLOCK_FRAMES);
+
+// Encode and write a .elrsz file
+Result<void> saveCompressedHistory(
+    const std::string& filepath,
+    const std::vector<HistoryFrame>& frames,
+    uint32_t block_frames = COMPRESSED_HISTORY_BLOCK_FRAMES);
+
+// True if the buffer starts with the .elrsz magic
+bool isCompressedHistory(const uint8_t* data, size_t size);
+
+// Streaming decoder. Frames are decoded one at a time from the mapped file;
+// the block index allows seeking without decoding from the start.
+class CompressedHistoryReader {
+public:
+    CompressedHistoryReader();
+
+    // Map and validate a .elrsz file
+    Result<void> open(const std::string& filepath);
+
+    // Decode from a caller-owned buffer (must outlive the reader)
+    Result<void> openBuffer(const uint8_t* data, size_t size);
+
+    size_t frameCount() const { return m_frame_count; }
+    size_t blockCount() const { return m_index.size(); }
+
+    // Position so that next() returns the frame at or before timestamp_ms
+    // (the first frame if timestamp_ms precedes it)
+    void seek(uint32_t timestamp_ms);
+
+    // Position at the first frame of a block
+    void seekBlock(size_t block);
+
+    // Decode the next frame. Returns false at the end or on corrupt data
+    // (error() is then non-empty).
+    bool next(HistoryFrame& frame);
+
+    const std::string& error() const { return m_error; }
+
+private:
+    struct BlockIndex {
+        uint32_t first_frame;
+        uint32_t first_timestamp;
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    // Decoder position; small enough to copy for look-ahead
+    struct Cursor {
+        size_t block = 0;
+        size_t pos = 0;              // byte offset in the block
+        size_t frames_left = 0;      // frames remaining in the block
+        uint32_t run_left = 0;       // frames remaining in the current run
+        int64_t run_delta = 0;
+        bool started = false;        // absolute frame consumed
+        uint32_t timestamp = 0;
+        ChannelData channels{};
+    };
+
+    bool readVarint(uint64_t& value);
+    bool fail(const std::string& message);
+
+    MappedFile m_file;
+    const uint8_t* m_data;
+    size_t m_size;
+    const uint8_t* m_blocks;
+    size_t m_frame_count;
+    uint32_t m_block_frames;
+    std::vector<BlockIndex> m_index;
+    Cursor m_cursor;
+    std::string m_error;
+};
+
+}  // namespace history
+}  // namespace elrs
@@ -0,0 +1,209 @@
+#include "history_cache.hpp"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "mapped_file.hpp"
+
+namespace elrs {
+namespace history {
+
+namespace {
+
+constexpr char MAGIC[4] = {'E', 'L', 'R', 'C'};
+constexpr uint32_t VERSION = 1;
+
+// Entry header; frames follow at frames_offset (after path and name)
+struct EntryHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t frame_size;        // sizeof(HistoryFrame) of the writer
+    uint32_t path_length;
+    uint32_t name_length;
+    char format[8];
+    uint32_t reserved;
+    uint64_t source_size;
+    int64_t source_mtime_ns;
+    uint64_t content_hash;
+    uint64_t frame_count;
+    uint64_t frames_offset;
+};
+
+struct SourceInfo {
+    uint64_t size = 0;
+    int64_t mtime_ns = 0;
+};
+
+bool statSource(const std::string& path, SourceInfo& info) {
+    struct stat st{};
+    if (stat(path.c_str(), &st) != 0) {
+        return false;
+    }
+    info.size = static_cast<uint64_t>(st.st_size);
+#ifdef __APPLE__
+    info.mtime_ns = static_cast<int64_t>(st.st_mtimespec.tv_sec) * 1000000000 + st.st_mtimespec.tv_nsec;
+#else
+    info.mtime_ns = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#endif
+    return true;
+}
+
+bool hashFile(const std::string& path, uint64_t& hash) {
+    MappedFile file;
+    if (!file.open(path).ok()) {
+        return false;
+    }
+    hash = hashBytes(file.data(), file.size());
+    return true;
+}
+
+std::string canonicalPath(const std::string& path) {
+    std::error_code ec;
+    auto canonical = std::filesystem::weakly_canonical(path, ec);
+    return ec ? path : canonical.string();
+}
+
+Result<CachedHistory> miss(const std::string& why) {
+    return Result<CachedHistory>::failure(ErrorCode::HistoryError, why);
+}
+
+}  // namespace
+
+uint64_t hashBytes(const void* data, size_t size, uint64_t seed) {
+    const auto* p = static_cast<const uint8_t*>(data);
+    uint64_t hash = seed;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= p[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+HistoryCache::HistoryCache(std::string dir) : m_dir(std::move(dir)) {}
+
+std::string HistoryCache::entryPath(const std::string& source_path) const {
+    std::string key = canonicalPath(source_path);
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.elrsc",
+                  static_cast<unsigned long long>(hashBytes(key.data(), key.size())));
+    return m_dir + "/" + name;
+}
+
+Result<CachedHistory> HistoryCache::lookup(const std::string& source_path) const {
+    SourceInfo source;
+    if (!statSource(source_path, source)) {
+        return miss("Cannot stat " + source_path);
+    }
+
+    MappedFile entry;
+    if (!entry.open(entryPath(source_path)).ok()) {
+        return miss("No cache entry");
+    }
+
+    EntryHeader header{};
+    if (entry.size() < sizeof(header)) {
+        return miss("Truncated cache entry");
+    }
+    std::memcpy(&header, entry.data(), sizeof(header));
+
+    std::string key = canonicalPath(source_path);
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+        header.frame_size != sizeof(HistoryFrame) || header.path_length != key.size() ||
+        sizeof(header) + header.path_length + header.name_length > entry.size() ||
+        header.frames_offset + header.frame_count * sizeof(HistoryFrame) != entry.size() ||
+        std::memcmp(entry.data() + sizeof(header), key.data(), key.size()) != 0) {
+        return miss("Incompatible cache entry");
+    }
+
+    if (header.source_size != source.size) {
+        return miss("Source size changed");
+    }
+    if (header.source_mtime_ns != source.mtime_ns) {
+        // Touched but maybe unchanged: compare content
+        uint64_t hash = 0;
+        if (!hashFile(source_path, hash) || hash != header.content_hash) {
+            return miss("Source content changed");
+        }
+    }
+
+    CachedHistory cached;
+    cached.format.assign(header.format, strnlen(header.format, sizeof(header.format)));
+    cached.name.assign(entry.data() + sizeof(header) + header.path_length, header.name_length);
+    cached.frames.resize(header.frame_count);
+    std::memcpy(cached.frames.data(), entry.data() + header.frames_offset,
+                header.frame_count * sizeof(HistoryFrame));
+
+    return Result<CachedHistory>::success(std::move(cached));
+}
+
+Result<void> HistoryCache::store(const std::string& source_path,
+                                 const std::vector<HistoryFrame>& frames,
+                                 const std::string& format,
+                                 const std::string& name) const {
+    SourceInfo source;
+    uint64_t hash = 0;
+    if (!statSource(source_path, source) || !hashFile(source_path, hash)) {
+        return Result<void>::failure(ErrorCode::HistoryError, "Cannot read " + source_path);
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(m_dir, ec);
+    if (ec) {
+        return Result<void>::failure(
+            ErrorCode::HistoryError,
+            "Cannot create cache directory " + m_dir + ": " + ec.message()
+        );
+    }
+
+    std::string key = canonicalPath(source_path);
+    EntryHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.frame_size = sizeof(HistoryFrame);
+    header.path_length = static_cast<uint32_t>(key.size());
+    header.name_length = static_cast<uint32_t>(name.size());
+    std::memcpy(header.format, format.data(), std::min(format.size(), sizeof(header.format) - 1));
+    header.source_size = source.size;
+    header.source_mtime_ns = source.mtime_ns;
+    header.content_hash = hash;
+    header.frame_count = frames.size();
+    // Keep the frame array 8-byte aligned for direct mapping
+    header.frames_offset = (sizeof(header) + key.size() + name.size() + 7) & ~uint64_t{7};
+
+    // Write to a temporary file and rename, so readers never see a partial entry
+    std::string path = entryPath(source_path);
+    std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            return Result<void>::failure(ErrorCode::HistoryError, "Cannot create " + tmp_path);
+        }
+        static const char padding[8] = {};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(key.data(), static_cast<std::streamsize>(key.size()));
+        out.write(name.data(), static_cast<std::streamsize>(name.size()));
+        out.write(padding, static_cast<std::streamsize>(
+            header.frames_offset - sizeof(header) - key.size() - name.size()));
+        out.write(reinterpret_cast<const char*>(frames.data()),
+                  static_cast<std::streamsize>(frames.size() * sizeof(HistoryFrame)));
+        if (!out) {
+            std::remove(tmp_path.c_str());
+            return Result<void>::failure(ErrorCode::HistoryError, "Write failed: " + tmp_path);
+        }
+    }
+
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        std::remove(tmp_path.c_str());
+        return Result<void>::failure(ErrorCode::HistoryError, "Cannot replace " + path);
+    }
+
+    return Result<void>::success();
+}
+
+}  // namespace history
+}  // namespace elrs
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "expresslrs_sender/types.hpp"
+
+namespace elrs {
+namespace history {
+
+// Parsed history returned from the cache
+struct CachedHistory {
+    std::vector<HistoryFrame> frames;
+    std::string format;     // format of the source file ("csv", "json")
+    std::string name;       // metadata name of the source file
+};
+
+// On-disk cache of parsed histories.
+//
+// One entry per source path (<dir>/<hash of path>.elrsc) holding the source
+// size, mtime and content hash followed by the raw HistoryFrame array, so a
+// warm load is a single mapped copy. An entry is used when size and mtime
+// match, or when only the mtime changed but the content hash still matches.
+class HistoryCache {
+public:
+    explicit HistoryCache(std::string dir);
+
+    const std::string& dir() const { return m_dir; }
+
+    // Cached frames for source_path; failure = miss (missing or stale entry)
+    Result<CachedHistory> lookup(const std::string& source_path) const;
+
+    // Write (replace) the entry for source_path
+    Result<void> store(const std::string& source_path,
+                       const std::vector<HistoryFrame>& frames,
+                       const std::string& format,
+                       const std::string& name) const;
+
+    // Entry file used for source_path
+    std::string entryPath(const std::string& source_path) const;
+
+private:
+    std::string m_dir;
+};
+
+// FNV-1a 64-bit hash
+uint64_t hashBytes(const void* data, size_t size, uint64_t seed = 0xcbf29ce484222325ULL);
+
+}  // namespace history
+}  // namespace elrs
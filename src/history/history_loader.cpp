@@ -1,16 +1,445 @@
 #include "history_loader.hpp"
 
 #include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
 #include <fstream>
 #include <sstream>
+#include <sys/stat.h>
+#include <thread>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 #include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include "compressed_history.hpp"
+#include "history_cache.hpp"
+#include "mapped_file.hpp"
 
 namespace elrs {
 namespace history {
 
 using json = nlohmann::json;
 
+namespace {
+
+// CSV files at least this large are parsed with loadCsvParallel() by load()
+constexpr size_t PARALLEL_CSV_MIN_BYTES = 8 * 1024 * 1024;
+
+// Chunks smaller than this are not worth a thread
+constexpr size_t PARALLEL_CSV_MIN_CHUNK = 1024 * 1024;
+
+bool isBlank(const char* begin, const char* end) {
+    for (const char* p = begin; p < end; p++) {
+        if (*p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Header line = first field contains anything other than digits, '-' or blanks
+bool isHeader(const char* begin, const char* end) {
+    for (const char* p = begin; p < end && *p != ','; p++) {
+        char c = *p;
+        if (!std::isdigit(static_cast<unsigned char>(c)) && c != '-' && c != ' ' && c != '\t') {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Parse a leading integer of [p, end) the way std::stol does: leading
+// whitespace, optional sign, at least one digit, trailing garbage ignored.
+bool parseInteger(const char* p, const char* end, long long& out) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n' ||
+                       *p == '\v' || *p == '\f')) {
+        p++;
+    }
+    bool negative = false;
+    if (p < end && (*p == '+' || *p == '-')) {
+        negative = (*p == '-');
+        p++;
+    }
+    if (p >= end || !std::isdigit(static_cast<unsigned char>(*p))) {
+        return false;
+    }
+    long long value = 0;
+    while (p < end && std::isdigit(static_cast<unsigned char>(*p))) {
+        value = value * 10 + (*p - '0');
+        if (value > static_cast<long long>(UINT_MAX)) {
+            return false;
+        }
+        p++;
+    }
+    out = negative ? -value : value;
+    return true;
+}
+
+// Parse one CSV record [begin, end) (without the newline) into frame.
+// Returns nullptr on success, otherwise the error description.
+const char* parseCsvRecord(const char* begin, const char* end, HistoryFrame& frame) {
+    const char* field_end = static_cast<const char*>(std::memchr(begin, ',', end - begin));
+    if (!field_end) {
+        field_end = end;
+    }
+
+    long long value = 0;
+    if (!parseInteger(begin, field_end, value)) {
+        return "Invalid timestamp";
+    }
+    frame.timestamp_ms = static_cast<uint32_t>(value);
+
+    size_t ch = 0;
+    const char* p = field_end;
+    while (p < end && ch < CRSF_MAX_CHANNELS) {
+        p++;  // skip ','
+        if (p >= end) {
+            break;  // trailing comma
+        }
+        field_end = static_cast<const char*>(std::memchr(p, ',', end - p));
+        if (!field_end) {
+            field_end = end;
+        }
+        if (!parseInteger(p, field_end, value) || value < INT_MIN || value > INT_MAX) {
+            return "Invalid channel value";
+        }
+        frame.channels[ch++] = static_cast<int16_t>(value);
+        p = field_end;
+    }
+
+    // Fill remaining channels with center value
+    while (ch < CRSF_MAX_CHANNELS) {
+        frame.channels[ch++] = CRSF_CHANNEL_MID;
+    }
+
+    return nullptr;
+}
+
+static_assert(CRSF_MAX_CHANNELS == 16, "range check assumes two 8-lane vectors");
+
+// Channel range check over all 16 channels at once; also accumulates the
+// per-channel min/max of everything checked
+class ChannelRangeCheck {
+public:
+    ChannelRangeCheck() {
+#if defined(__SSE2__)
+        m_limit_min = _mm_set1_epi16(CRSF_CHANNEL_MIN);
+        m_limit_max = _mm_set1_epi16(CRSF_CHANNEL_MAX);
+        m_min[0] = m_min[1] = _mm_set1_epi16(INT16_MAX);
+        m_max[0] = m_max[1] = _mm_set1_epi16(INT16_MIN);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        m_limit_min = vdupq_n_s16(CRSF_CHANNEL_MIN);
+        m_limit_max = vdupq_n_s16(CRSF_CHANNEL_MAX);
+        m_min[0] = m_min[1] = vdupq_n_s16(INT16_MAX);
+        m_max[0] = m_max[1] = vdupq_n_s16(INT16_MIN);
+#else
+        m_min.fill(INT16_MAX);
+        m_max.fill(INT16_MIN);
+#endif
+    }
+
+    // Returns a bitmask of out-of-range channels (bit n = channel n+1)
+    uint32_t check(const ChannelData& channels) {
+#if defined(__SSE2__)
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(channels.data()));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(channels.data() + 8));
+        m_min[0] = _mm_min_epi16(m_min[0], lo);
+        m_min[1] = _mm_min_epi16(m_min[1], hi);
+        m_max[0] = _mm_max_epi16(m_max[0], lo);
+        m_max[1] = _mm_max_epi16(m_max[1], hi);
+        __m128i bad_lo = _mm_or_si128(_mm_cmplt_epi16(lo, m_limit_min), _mm_cmpgt_epi16(lo, m_limit_max));
+        __m128i bad_hi = _mm_or_si128(_mm_cmplt_epi16(hi, m_limit_min), _mm_cmpgt_epi16(hi, m_limit_max));
+        // 0/-1 lanes pack to 0/-1 bytes in channel order
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(bad_lo, bad_hi)));
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        static const uint16_t weights[8] = {1, 2, 4, 8, 16, 32, 64, 128};
+        int16x8_t lo = vld1q_s16(channels.data());
+        int16x8_t hi = vld1q_s16(channels.data() + 8);
+        m_min[0] = vminq_s16(m_min[0], lo);
+        m_min[1] = vminq_s16(m_min[1], hi);
+        m_max[0] = vmaxq_s16(m_max[0], lo);
+        m_max[1] = vmaxq_s16(m_max[1], hi);
+        uint16x8_t bad_lo = vorrq_u16(vcltq_s16(lo, m_limit_min), vcgtq_s16(lo, m_limit_max));
+        uint16x8_t bad_hi = vorrq_u16(vcltq_s16(hi, m_limit_min), vcgtq_s16(hi, m_limit_max));
+        uint16x8_t w = vld1q_u16(weights);
+        return static_cast<uint32_t>(vaddvq_u16(vandq_u16(bad_lo, w))) |
+            (static_cast<uint32_t>(vaddvq_u16(vandq_u16(bad_hi, w))) << 8);
+#else
+        uint32_t bad = 0;
+        for (size_t ch = 0; ch < CRSF_MAX_CHANNELS; ch++) {
+            int16_t v = channels[ch];
+            m_min[ch] = std::min(m_min[ch], v);
+            m_max[ch] = std::max(m_max[ch], v);
+            bad |= static_cast<uint32_t>(v < CRSF_CHANNEL_MIN || v > CRSF_CHANNEL_MAX) << ch;
+        }
+        return bad;
+#endif
+    }
+
+    void minMax(std::array<int16_t, CRSF_MAX_CHANNELS>& min,
+                std::array<int16_t, CRSF_MAX_CHANNELS>& max) const {
+#if defined(__SSE2__)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(min.data()), m_min[0]);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(min.data() + 8), m_min[1]);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(max.data()), m_max[0]);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(max.data() + 8), m_max[1]);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        vst1q_s16(min.data(), m_min[0]);
+        vst1q_s16(min.data() + 8, m_min[1]);
+        vst1q_s16(max.data(), m_max[0]);
+        vst1q_s16(max.data() + 8, m_max[1]);
+#else
+        min = m_min;
+        max = m_max;
+#endif
+    }
+
+private:
+#if defined(__SSE2__)
+    __m128i m_limit_min, m_limit_max;
+    __m128i m_min[2], m_max[2];
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    int16x8_t m_limit_min, m_limit_max;
+    int16x8_t m_min[2], m_max[2];
+#else
+    std::array<int16_t, CRSF_MAX_CHANNELS> m_min, m_max;
+#endif
+};
+
+size_t gapBucket(uint32_t gap) {
+    if (gap == 0) {
+        return 0;
+    }
+    size_t bucket = 32 - static_cast<size_t>(__builtin_clz(gap));  // 1 + floor(log2(gap))
+    return std::min(bucket, VALIDATION_GAP_BUCKETS - 1);
+}
+
+std::string summarize(const char* what, const ValidationFinding& finding) {
+    return std::string(what) + " in " + std::to_string(finding.count) + " frames (first " +
+        std::to_string(finding.first_index) + ", last " + std::to_string(finding.last_index) + ")";
+}
+
+std::string lineError(size_t line_num, const char* what) {
+    return "Line " + std::to_string(line_num) + ": " + what;
+}
+
+// Running metadata over frames that are not kept
+struct MetadataScan {
+    size_t count = 0;
+    uint32_t first_timestamp = 0;
+    uint32_t last_timestamp = 0;
+    uint32_t active_channels = 0;   // bit n = channel n+1 not at center somewhere
+
+    void add(const HistoryFrame& frame) {
+        if (count == 0) {
+            first_timestamp = frame.timestamp_ms;
+        }
+        last_timestamp = frame.timestamp_ms;
+        count++;
+        for (size_t ch = 0; ch < CRSF_MAX_CHANNELS; ch++) {
+            active_channels |= static_cast<uint32_t>(frame.channels[ch] != CRSF_CHANNEL_MID) << ch;
+        }
+    }
+
+    // Same rules as HistoryLoader::calculateMetadata
+    void finish(HistoryMetadata& metadata, size_t frame_count) const {
+        metadata.frame_count = frame_count;
+        metadata.keyframe_count = frame_count;
+        metadata.duration_ms = last_timestamp - first_timestamp;
+        if (frame_count > 1 && metadata.duration_ms > 0) {
+            metadata.packet_rate_hz = static_cast<double>(frame_count - 1) * 1000.0 /
+                static_cast<double>(metadata.duration_ms);
+        } else {
+            metadata.packet_rate_hz = 0;
+        }
+        metadata.channel_count = active_channels
+            ? 32 - static_cast<size_t>(__builtin_clz(active_channels))
+            : 8;
+    }
+};
+
+// Records sampled from each end of a CSV file by a quick probe
+constexpr size_t PROBE_SAMPLE_RECORDS = 64;
+
+// Streaming JSON history reader: frames are written straight into the
+// output vector as values arrive, no DOM is built.
+class HistorySaxHandler : public json::json_sax_t {
+public:
+    explicit HistorySaxHandler(std::vector<HistoryFrame>* frames, MetadataScan* scan = nullptr)
+        : m_frames(frames), m_scan(scan) {}
+
+    bool framesSeen() const { return m_frames_seen; }
+    const std::string& name() const { return m_name; }
+    const std::string& error() const { return m_error; }
+
+    bool null() override { return scalar(nullptr, "null"); }
+    bool boolean(bool) override { return scalar(nullptr, "boolean"); }
+    bool number_integer(number_integer_t v) override { return number(static_cast<long long>(v)); }
+    bool number_unsigned(number_unsigned_t v) override { return number(static_cast<long long>(v)); }
+    bool number_float(number_float_t v, const string_t&) override {
+        return number(static_cast<long long>(v));
+    }
+    bool string(string_t& v) override { return scalar(&v, "string"); }
+    bool binary(binary_t&) override { return scalar(nullptr, "binary"); }
+
+    bool start_object(std::size_t) override {
+        Context ctx = Context::Other;
+        if (m_stack.empty()) {
+            ctx = Context::Root;
+        } else if (m_stack.back() == Context::Root && m_key == "metadata") {
+            ctx = Context::Metadata;
+        } else if (m_stack.back() == Context::Frames) {
+            ctx = Context::Frame;
+            m_frame = HistoryFrame{};
+            m_has_t = false;
+            m_has_timestamp = false;
+            m_has_channels = false;
+        } else if (m_stack.back() == Context::Channels) {
+            return fail("JSON error: channel value must be a number");
+        }
+        m_stack.push_back(ctx);
+        return true;
+    }
+
+    bool end_object() override {
+        if (m_stack.back() == Context::Frame) {
+            if (!m_has_t && !m_has_timestamp) {
+                return fail("Missing timestamp in frame");
+            }
+            if (!m_has_channels) {
+                return fail("Missing channels in frame");
+            }
+            if (m_frames) {
+                m_frames->push_back(m_frame);
+            }
+            if (m_scan) {
+                m_scan->add(m_frame);
+            }
+        }
+        m_stack.pop_back();
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        Context ctx = Context::Other;
+        if (!m_stack.empty()) {
+            Context top = m_stack.back();
+            if (top == Context::Root && m_key == "frames") {
+                ctx = Context::Frames;
+                m_frames_seen = true;
+            } else if (top == Context::Frame && (m_key == "ch" || m_key == "channels")) {
+                ctx = Context::Channels;
+                m_has_channels = true;
+                m_channel = 0;
+                // Fill remaining with center
+                m_frame.channels.fill(CRSF_CHANNEL_MID);
+            } else if (top == Context::Frames) {
+                return fail("Missing timestamp in frame");
+            } else if (top == Context::Channels) {
+                return fail("JSON error: channel value must be a number");
+            }
+        }
+        m_stack.push_back(ctx);
+        return true;
+    }
+
+    bool end_array() override {
+        m_stack.pop_back();
+        return true;
+    }
+
+    bool key(string_t& k) override {
+        m_key = k;
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& e) override {
+        return fail("JSON parse error: " + std::string(e.what()));
+    }
+
+private:
+    enum class Context { Root, Metadata, Frames, Frame, Channels, Other };
+
+    bool number(long long v) {
+        if (m_stack.empty()) {
+            return true;
+        }
+        switch (m_stack.back()) {
+            case Context::Frame:
+                // "t" takes precedence over "timestamp_ms"
+                if (m_key == "t") {
+                    m_frame.timestamp_ms = static_cast<uint32_t>(v);
+                    m_has_t = true;
+                } else if (m_key == "timestamp_ms" && !m_has_t) {
+                    m_frame.timestamp_ms = static_cast<uint32_t>(v);
+                    m_has_timestamp = true;
+                }
+                return true;
+            case Context::Channels:
+                if (m_channel < CRSF_MAX_CHANNELS) {
+                    m_frame.channels[m_channel] = static_cast<int16_t>(v);
+                }
+                m_channel++;
+                return true;
+            case Context::Frames:
+                return fail("Missing timestamp in frame");
+            default:
+                return true;
+        }
+    }
+
+    bool scalar(const std::string* str, const char* type) {
+        if (m_stack.empty()) {
+            return true;
+        }
+        switch (m_stack.back()) {
+            case Context::Metadata:
+                if (m_key == "name" && str) {
+                    m_name = *str;
+                }
+                return true;
+            case Context::Frame:
+                if (m_key == "t" || m_key == "timestamp_ms") {
+                    return fail(std::string("JSON error: timestamp must be a number, got ") + type);
+                }
+                return true;
+            case Context::Channels:
+                return fail(std::string("JSON error: channel value must be a number, got ") + type);
+            case Context::Frames:
+                return fail("Missing timestamp in frame");
+            default:
+                return true;
+        }
+    }
+
+    bool fail(std::string message) {
+        m_error = std::move(message);
+        return false;
+    }
+
+    std::vector<HistoryFrame>* m_frames;
+    MetadataScan* m_scan;
+    std::vector<Context> m_stack;
+    std::string m_key;
+    std::string m_name;
+    std::string m_error;
+    HistoryFrame m_frame{};
+    size_t m_channel = 0;
+    bool m_has_t = false;
+    bool m_has_timestamp = false;
+    bool m_has_channels = false;
+    bool m_frames_seen = false;
+};
+
+}  // namespace
+
 std::string HistoryLoader::detectFormat(const std::string& filepath) {
     // Check extension
     size_t dot_pos = filepath.rfind('.');
@@ -19,14 +448,24 @@ std::string HistoryLoader::detectFormat(const std::string& filepath) {
         std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
         if (ext == "json") return "json";
         if (ext == "csv") return "csv";
+        if (ext == "elrsz") return "elrsz";
     }
 
     // Try to detect from content
-    std::ifstream file(filepath);
+    std::ifstream file(filepath, std::ios::binary);
     if (!file.is_open()) {
         return "";
     }
 
+    char magic[4] = {};
+    file.read(magic, sizeof(magic));
+    if (isCompressedHistory(reinterpret_cast<const uint8_t*>(magic),
+                            static_cast<size_t>(file.gcount()))) {
+        return "elrsz";
+    }
+    file.clear();
+    file.seekg(0);
+
     std::string first_line;
     std::getline(file, first_line);
 
@@ -41,10 +480,49 @@ std::string HistoryLoader::detectFormat(const std::string& filepath) {
 
 Result<std::vector<HistoryFrame>> HistoryLoader::load(const std::string& filepath) {
     std::string format = detectFormat(filepath);
+    m_metadata.from_cache = false;
+
+    // .elrsz is already a cheap binary format
+    bool use_cache = !m_cache_dir.empty() && (format == "csv" || format == "json");
+    if (!use_cache) {
+        return loadFormat(filepath, format);
+    }
 
+    HistoryCache cache(m_cache_dir);
+    auto cached = cache.lookup(filepath);
+    if (cached.ok() && !cached.value.frames.empty()) {
+        spdlog::debug("History cache hit for {}", filepath);
+        m_metadata.name = cached.value.name;
+        calculateMetadata(cached.value.frames, cached.value.format);
+        m_metadata.from_cache = true;
+        return Result<std::vector<HistoryFrame>>::success(std::move(cached.value.frames));
+    }
+    spdlog::debug("History cache miss for {}: {}", filepath, cached.message);
+
+    m_metadata.name.clear();
+    auto result = loadFormat(filepath, format);
+    if (result.ok()) {
+        auto stored = cache.store(filepath, result.value, m_metadata.format, m_metadata.name);
+        if (!stored.ok()) {
+            spdlog::warn("History cache not updated: {}", stored.message);
+        }
+    }
+    return result;
+}
+
+Result<std::vector<HistoryFrame>> HistoryLoader::loadFormat(const std::string& filepath,
+                                                            const std::string& format) {
     if (format == "json") {
         return loadJson(filepath);
+    } else if (format == "elrsz") {
+        return loadCompressed(filepath);
     } else if (format == "csv") {
+        struct stat st{};
+        if (stat(filepath.c_str(), &st) == 0 &&
+            static_cast<size_t>(st.st_size) >= PARALLEL_CSV_MIN_BYTES &&
+            std::thread::hardware_concurrency() > 1) {
+            return loadCsvParallel(filepath);
+        }
         return loadCsv(filepath);
     }
 
@@ -56,45 +534,10 @@ Result<std::vector<HistoryFrame>> HistoryLoader::load(const std::string& filepat
 
 Result<HistoryFrame> HistoryLoader::parseCsvLine(const std::string& line, size_t line_num) {
     HistoryFrame frame{};
-    std::istringstream ss(line);
-    std::string token;
-
-    // Parse timestamp
-    if (!std::getline(ss, token, ',')) {
-        return Result<HistoryFrame>::failure(
-            ErrorCode::HistoryError,
-            "Line " + std::to_string(line_num) + ": Missing timestamp"
-        );
-    }
-
-    try {
-        frame.timestamp_ms = static_cast<uint32_t>(std::stoul(token));
-    } catch (...) {
-        return Result<HistoryFrame>::failure(
-            ErrorCode::HistoryError,
-            "Line " + std::to_string(line_num) + ": Invalid timestamp"
-        );
+    const char* error = parseCsvRecord(line.data(), line.data() + line.size(), frame);
+    if (error) {
+        return Result<HistoryFrame>::failure(ErrorCode::HistoryError, lineError(line_num, error));
     }
-
-    // Parse channels
-    size_t ch = 0;
-    while (std::getline(ss, token, ',') && ch < CRSF_MAX_CHANNELS) {
-        try {
-            frame.channels[ch] = static_cast<int16_t>(std::stoi(token));
-        } catch (...) {
-            return Result<HistoryFrame>::failure(
-                ErrorCode::HistoryError,
-                "Line " + std::to_string(line_num) + ": Invalid channel value"
-            );
-        }
-        ch++;
-    }
-
-    // Fill remaining channels with center value
-    while (ch < CRSF_MAX_CHANNELS) {
-        frame.channels[ch++] = CRSF_CHANNEL_MID;
-    }
-
     return Result<HistoryFrame>::success(frame);
 }
 
@@ -116,30 +559,16 @@ Result<std::vector<HistoryFrame>> HistoryLoader::loadCsv(const std::string& file
         line_num++;
 
         // Skip empty lines
-        if (line.empty() || line.find_first_not_of(" \t\n\r") == std::string::npos) {
+        if (isBlank(line.data(), line.data() + line.size())) {
             continue;
         }
 
         // Skip header line (if it contains non-numeric first field)
         if (!header_skipped) {
-            size_t first_comma = line.find(',');
-            std::string first_field = (first_comma != std::string::npos)
-                ? line.substr(0, first_comma)
-                : line;
-
-            bool is_header = false;
-            for (char c : first_field) {
-                if (!std::isdigit(c) && c != '-' && c != ' ' && c != '\t') {
-                    is_header = true;
-                    break;
-                }
-            }
-
-            if (is_header) {
-                header_skipped = true;
+            header_skipped = true;
+            if (isHeader(line.data(), line.data() + line.size())) {
                 continue;
             }
-            header_skipped = true;
         }
 
         auto result = parseCsvLine(line, line_num);
@@ -162,83 +591,211 @@ Result<std::vector<HistoryFrame>> HistoryLoader::loadCsv(const std::string& file
     return Result<std::vector<HistoryFrame>>::success(std::move(frames));
 }
 
-Result<std::vector<HistoryFrame>> HistoryLoader::loadJson(const std::string& filepath) {
-    std::ifstream file(filepath);
-    if (!file.is_open()) {
+Result<std::vector<HistoryFrame>> HistoryLoader::loadCsvParallel(const std::string& filepath,
+                                                                  size_t threads) {
+    MappedFile file;
+    auto open_result = file.open(filepath);
+    if (!open_result.ok()) {
+        return Result<std::vector<HistoryFrame>>::failure(open_result.error, open_result.message);
+    }
+
+    const char* data = file.data();
+    const char* data_end = data + file.size();
+
+    // Locate the first record (header rule as in loadCsv) and its line number
+    const char* body = data;
+    size_t first_line = 1;
+    while (body < data_end) {
+        const char* nl = static_cast<const char*>(std::memchr(body, '\n', data_end - body));
+        const char* line_end = nl ? nl : data_end;
+        if (!isBlank(body, line_end)) {
+            if (isHeader(body, line_end)) {
+                body = nl ? nl + 1 : data_end;
+                first_line++;
+            }
+            break;
+        }
+        body = nl ? nl + 1 : data_end;
+        first_line++;
+    }
+
+    // Split the body into chunks that start at line boundaries
+    size_t body_size = static_cast<size_t>(data_end - body);
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+        threads = std::min(threads, body_size / PARALLEL_CSV_MIN_CHUNK + 1);
+    }
+
+    std::vector<const char*> bounds{body};
+    for (size_t i = 1; i < threads; i++) {
+        const char* p = std::max(bounds.back(), body + body_size * i / threads);
+        if (p > body && p < data_end && p[-1] != '\n') {
+            const char* nl = static_cast<const char*>(std::memchr(p, '\n', data_end - p));
+            p = nl ? nl + 1 : data_end;
+        }
+        bounds.push_back(p);
+    }
+    bounds.push_back(data_end);
+    size_t chunk_count = bounds.size() - 1;
+
+    struct Chunk {
+        size_t records = 0;      // non-blank lines
+        size_t newlines = 0;
+        size_t frame_offset = 0;
+        size_t line_offset = 0;  // line number of the chunk's first line
+        size_t error_line = 0;   // 0 = no error
+        const char* error = nullptr;
+    };
+    std::vector<Chunk> chunks(chunk_count);
+
+    auto forEachLine = [&](size_t c, auto&& fn) {
+        const char* p = bounds[c];
+        const char* end = bounds[c + 1];
+        size_t line = 0;
+        while (p < end) {
+            const char* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            const char* line_end = nl ? nl : end;
+            if (!isBlank(p, line_end) && !fn(p, line_end, line)) {
+                return;
+            }
+            line++;
+            p = nl ? nl + 1 : end;
+        }
+    };
+
+    auto runChunks = [&](auto&& work) {
+        std::vector<std::thread> workers;
+        for (size_t c = 1; c < chunk_count; c++) {
+            workers.emplace_back(work, c);
+        }
+        work(0);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    };
+
+    // Pass 1: count records and newlines per chunk
+    runChunks([&](size_t c) {
+        Chunk& chunk = chunks[c];
+        forEachLine(c, [&](const char*, const char*, size_t) {
+            chunk.records++;
+            return true;
+        });
+        const char* p = bounds[c];
+        const char* end = bounds[c + 1];
+        while ((p = static_cast<const char*>(std::memchr(p, '\n', end - p))) != nullptr) {
+            chunk.newlines++;
+            p++;
+        }
+    });
+
+    size_t total = 0;
+    size_t line = first_line;
+    for (auto& chunk : chunks) {
+        chunk.frame_offset = total;
+        chunk.line_offset = line;
+        total += chunk.records;
+        line += chunk.newlines;
+    }
+
+    if (total == 0) {
         return Result<std::vector<HistoryFrame>>::failure(
             ErrorCode::HistoryError,
-            "Cannot open file: " + filepath
+            "No frames found in file"
         );
     }
 
-    json j;
-    try {
-        file >> j;
-    } catch (const json::parse_error& e) {
+    // Pass 2: parse every chunk straight into its slice of the output
+    std::vector<HistoryFrame> frames(total);
+    runChunks([&](size_t c) {
+        Chunk& chunk = chunks[c];
+        HistoryFrame* out = frames.data() + chunk.frame_offset;
+        forEachLine(c, [&](const char* begin, const char* end, size_t line_in_chunk) {
+            const char* error = parseCsvRecord(begin, end, *out++);
+            if (error) {
+                chunk.error = error;
+                chunk.error_line = chunk.line_offset + line_in_chunk;
+                return false;
+            }
+            return true;
+        });
+    });
+
+    // Report the first error in file order
+    for (const auto& chunk : chunks) {
+        if (chunk.error) {
+            return Result<std::vector<HistoryFrame>>::failure(
+                ErrorCode::HistoryError,
+                lineError(chunk.error_line, chunk.error)
+            );
+        }
+    }
+
+    spdlog::debug("Parsed {} CSV records with {} threads", total, chunk_count);
+
+    calculateMetadata(frames, "csv");
+
+    return Result<std::vector<HistoryFrame>>::success(std::move(frames));
+}
+
+Result<std::vector<HistoryFrame>> HistoryLoader::loadJson(const std::string& filepath) {
+    MappedFile file;
+    auto open_result = file.open(filepath);
+    if (!open_result.ok()) {
+        return Result<std::vector<HistoryFrame>>::failure(open_result.error, open_result.message);
+    }
+
+    std::vector<HistoryFrame> frames;
+    HistorySaxHandler handler(&frames);
+
+    bool parsed = json::sax_parse(file.data(), file.data() + file.size(), &handler);
+    if (!parsed) {
         return Result<std::vector<HistoryFrame>>::failure(
             ErrorCode::HistoryError,
-            "JSON parse error: " + std::string(e.what())
+            handler.error()
         );
     }
 
     // Check for required fields
-    if (!j.contains("frames") || !j["frames"].is_array()) {
+    if (!handler.framesSeen()) {
         return Result<std::vector<HistoryFrame>>::failure(
             ErrorCode::HistoryError,
             "Missing 'frames' array in JSON"
         );
     }
 
-    std::vector<HistoryFrame> frames;
+    if (frames.empty()) {
+        return Result<std::vector<HistoryFrame>>::failure(
+            ErrorCode::HistoryError,
+            "No frames found in file"
+        );
+    }
 
-    try {
-        for (const auto& frame_json : j["frames"]) {
-            HistoryFrame frame{};
+    // Extract metadata from JSON if present
+    if (!handler.name().empty()) {
+        m_metadata.name = handler.name();
+    }
 
-            // Get timestamp
-            if (frame_json.contains("t")) {
-                frame.timestamp_ms = frame_json["t"].get<uint32_t>();
-            } else if (frame_json.contains("timestamp_ms")) {
-                frame.timestamp_ms = frame_json["timestamp_ms"].get<uint32_t>();
-            } else {
-                return Result<std::vector<HistoryFrame>>::failure(
-                    ErrorCode::HistoryError,
-                    "Missing timestamp in frame"
-                );
-            }
+    calculateMetadata(frames, "json");
 
-            // Get channels
-            if (frame_json.contains("ch")) {
-                const auto& ch_array = frame_json["ch"];
-                for (size_t i = 0; i < ch_array.size() && i < CRSF_MAX_CHANNELS; i++) {
-                    frame.channels[i] = ch_array[i].get<int16_t>();
-                }
-                // Fill remaining with center
-                for (size_t i = ch_array.size(); i < CRSF_MAX_CHANNELS; i++) {
-                    frame.channels[i] = CRSF_CHANNEL_MID;
-                }
-            } else if (frame_json.contains("channels")) {
-                const auto& ch_array = frame_json["channels"];
-                for (size_t i = 0; i < ch_array.size() && i < CRSF_MAX_CHANNELS; i++) {
-                    frame.channels[i] = ch_array[i].get<int16_t>();
-                }
-                for (size_t i = ch_array.size(); i < CRSF_MAX_CHANNELS; i++) {
-                    frame.channels[i] = CRSF_CHANNEL_MID;
-                }
-            } else {
-                return Result<std::vector<HistoryFrame>>::failure(
-                    ErrorCode::HistoryError,
-                    "Missing channels in frame"
-                );
-            }
+    return Result<std::vector<HistoryFrame>>::success(std::move(frames));
+}
+
+Result<std::vector<HistoryFrame>> HistoryLoader::loadCompressed(const std::string& filepath) {
+    CompressedHistoryReader reader;
+    auto open_result = reader.open(filepath);
+    if (!open_result.ok()) {
+        return Result<std::vector<HistoryFrame>>::failure(open_result.error, open_result.message);
+    }
 
-            frames.push_back(frame);
+    std::vector<HistoryFrame> frames(reader.frameCount());
+    for (auto& frame : frames) {
+        if (!reader.next(frame)) {
+            return Result<std::vector<HistoryFrame>>::failure(
+                ErrorCode::HistoryError,
+                reader.error().empty() ? "Compressed history ended early" : reader.error()
+            );
         }
-    } catch (const json::exception& e) {
-        return Result<std::vector<HistoryFrame>>::failure(
-            ErrorCode::HistoryError,
-            "JSON error: " + std::string(e.what())
-        );
     }
 
     if (frames.empty()) {
@@ -248,21 +805,213 @@ Result<std::vector<HistoryFrame>> HistoryLoader::loadJson(const std::string& fil
         );
     }
 
-    // Extract metadata from JSON if present
-    if (j.contains("metadata")) {
-        const auto& meta = j["metadata"];
-        if (meta.contains("name")) {
-            m_metadata.name = meta["name"].get<std::string>();
+    calculateMetadata(frames, "elrsz");
+
+    return Result<std::vector<HistoryFrame>>::success(std::move(frames));
+}
+
+Result<HistoryMetadata> HistoryLoader::probe(const std::string& filepath, bool full_scan) {
+    std::string format = detectFormat(filepath);
+    HistoryMetadata metadata{};
+    metadata.format = format;
+    MetadataScan scan;
+
+    auto failure = [](ErrorCode code, const std::string& message) {
+        return Result<HistoryMetadata>::failure(code, message);
+    };
+
+    if (format == "elrsz") {
+        CompressedHistoryReader reader;
+        auto open_result = reader.open(filepath);
+        if (!open_result.ok()) {
+            return failure(open_result.error, open_result.message);
+        }
+
+        HistoryFrame frame{};
+        if (full_scan) {
+            while (reader.next(frame)) {
+                scan.add(frame);
+            }
+        } else {
+            // Header has the count; decode only the first and last frame
+            if (reader.next(frame)) {
+                scan.add(frame);
+            }
+            reader.seek(UINT32_MAX);
+            if (reader.frameCount() > 1 && reader.next(frame)) {
+                scan.add(frame);
+            }
+            metadata.estimated = true;  // channel count from two samples
+        }
+        if (!reader.error().empty()) {
+            return failure(ErrorCode::HistoryError, reader.error());
+        }
+        if (reader.frameCount() == 0 || (full_scan && scan.count != reader.frameCount())) {
+            return failure(ErrorCode::HistoryError, "No frames found in file");
         }
+        scan.finish(metadata, reader.frameCount());
+        return Result<HistoryMetadata>::success(metadata);
     }
 
-    calculateMetadata(frames, "json");
+    MappedFile file;
+    auto open_result = file.open(filepath);
+    if (!open_result.ok()) {
+        return failure(open_result.error, open_result.message);
+    }
 
-    return Result<std::vector<HistoryFrame>>::success(std::move(frames));
+    if (format == "json") {
+        // No cheap random access into JSON: stream it without keeping frames
+        HistorySaxHandler handler(nullptr, &scan);
+        if (!json::sax_parse(file.data(), file.data() + file.size(), &handler)) {
+            return failure(ErrorCode::HistoryError, handler.error());
+        }
+        if (!handler.framesSeen() || scan.count == 0) {
+            return failure(ErrorCode::HistoryError, "No frames found in file");
+        }
+        metadata.name = handler.name();
+        scan.finish(metadata, scan.count);
+        return Result<HistoryMetadata>::success(metadata);
+    }
+
+    if (format != "csv") {
+        return failure(ErrorCode::HistoryError, "Unknown file format: " + filepath);
+    }
+
+    const char* data = file.data();
+    const char* data_end = data + file.size();
+
+    // Body starts after leading blank lines and an optional header
+    const char* body = data;
+    size_t line_num = 1;
+    while (body < data_end) {
+        const char* nl = static_cast<const char*>(std::memchr(body, '\n', data_end - body));
+        const char* line_end = nl ? nl : data_end;
+        if (!isBlank(body, line_end)) {
+            if (isHeader(body, line_end)) {
+                body = nl ? nl + 1 : data_end;
+                line_num++;
+            }
+            break;
+        }
+        body = nl ? nl + 1 : data_end;
+        line_num++;
+    }
+
+    // Parse records forward from `p`, at most `limit` of them
+    HistoryFrame frame{};
+    const char* error = nullptr;
+    size_t error_line = 0;
+    const char* head_end = body;
+    uint32_t sample_first = 0;
+    auto scanForward = [&](const char* p, size_t limit, size_t first_line) {
+        size_t line = first_line;
+        size_t records = 0;
+        while (p < data_end && records < limit) {
+            const char* nl = static_cast<const char*>(std::memchr(p, '\n', data_end - p));
+            const char* line_end = nl ? nl : data_end;
+            if (!isBlank(p, line_end)) {
+                error = parseCsvRecord(p, line_end, frame);
+                if (error) {
+                    error_line = line;
+                    return;
+                }
+                if (records == 0) {
+                    sample_first = frame.timestamp_ms;
+                }
+                scan.add(frame);
+                records++;
+            }
+            line++;
+            p = nl ? nl + 1 : data_end;
+        }
+        head_end = p;
+    };
+
+    if (full_scan) {
+        scanForward(body, SIZE_MAX, line_num);
+        if (error) {
+            return failure(ErrorCode::HistoryError, lineError(error_line, error));
+        }
+        if (scan.count == 0) {
+            return failure(ErrorCode::HistoryError, "No frames found in file");
+        }
+        scan.finish(metadata, scan.count);
+        return Result<HistoryMetadata>::success(metadata);
+    }
+
+    // Head sample
+    scanForward(body, PROBE_SAMPLE_RECORDS, line_num);
+    if (error) {
+        return failure(ErrorCode::HistoryError, lineError(error_line, error));
+    }
+    if (scan.count == 0) {
+        return failure(ErrorCode::HistoryError, "No frames found in file");
+    }
+    size_t head_records = scan.count;
+    size_t head_bytes = static_cast<size_t>(head_end - body);
+    uint32_t head_span = scan.last_timestamp - scan.first_timestamp;
+
+    if (head_end >= data_end) {
+        // Whole file fit in the head sample: exact
+        scan.finish(metadata, scan.count);
+        return Result<HistoryMetadata>::success(metadata);
+    }
+
+    // Tail sample: step back over the last PROBE_SAMPLE_RECORDS lines
+    const char* tail = data_end;
+    size_t newlines = 0;
+    while (tail > head_end) {
+        if (tail[-1] == '\n' && tail != data_end && ++newlines > PROBE_SAMPLE_RECORDS) {
+            break;
+        }
+        tail--;
+    }
+    size_t middle_bytes = static_cast<size_t>(tail - head_end);
+    size_t tail_before = scan.count;
+    scanForward(tail, SIZE_MAX, 0);
+    if (error) {
+        // Line numbers are unknown without a full scan
+        return failure(ErrorCode::HistoryError, std::string("Near end of file: ") + error);
+    }
+    size_t tail_records = scan.count - tail_before;
+    size_t tail_bytes = static_cast<size_t>(data_end - tail);
+
+    uint32_t tail_span = scan.last_timestamp - sample_first;
+
+    // Regular sampling (head and tail step agree within 10%): count from the
+    // duration. Otherwise fall back to the average record size.
+    size_t estimate = 0;
+    size_t sampled_records = head_records + tail_records;
+    if (head_records > 1 && tail_records > 1 && head_span > 0 && tail_span > 0) {
+        double head_step = static_cast<double>(head_span) / static_cast<double>(head_records - 1);
+        double tail_step = static_cast<double>(tail_span) / static_cast<double>(tail_records - 1);
+        if (std::abs(head_step - tail_step) <= 0.1 * std::max(head_step, tail_step)) {
+            double step = (head_step + tail_step) / 2.0;
+            double span = static_cast<double>(scan.last_timestamp - scan.first_timestamp);
+            estimate = static_cast<size_t>(span / step + 1.5);
+        }
+    }
+    if (estimate < sampled_records) {
+        double bytes_per_record = static_cast<double>(head_bytes + tail_bytes) /
+            static_cast<double>(sampled_records);
+        estimate = sampled_records +
+            static_cast<size_t>(static_cast<double>(middle_bytes) / bytes_per_record + 0.5);
+    }
+
+    scan.finish(metadata, estimate);
+    metadata.estimated = middle_bytes > 0;
+    return Result<HistoryMetadata>::success(metadata);
+}
+
+ColumnarHistory HistoryLoader::toColumnar(const std::vector<HistoryFrame>& frames,
+                                          bool collapse_duplicates) {
+    auto history = ColumnarHistory::fromFrames(frames, collapse_duplicates);
+    m_metadata.keyframe_count = history.size();
+    return history;
 }
 
 ValidationResult HistoryLoader::validate(const std::vector<HistoryFrame>& frames, bool strict) {
-    ValidationResult result{true, {}, {}};
+    ValidationResult result;
 
     if (frames.empty()) {
         result.valid = false;
@@ -270,47 +1019,100 @@ ValidationResult HistoryLoader::validate(const std::vector<HistoryFrame>& frames
         return result;
     }
 
-    uint32_t prev_timestamp = 0;
-    bool first_frame = true;
+    auto record = [](ValidationFinding& finding, size_t index) {
+        if (finding.count == 0) {
+            finding.first_index = index;
+        }
+        finding.last_index = index;
+        finding.count++;
+    };
+
+    std::vector<std::string> range_messages;
+    ChannelRangeCheck range;
 
     for (size_t i = 0; i < frames.size(); i++) {
         const auto& frame = frames[i];
 
         // Check timestamp ordering
-        if (!first_frame) {
+        if (i > 0) {
+            uint32_t prev_timestamp = frames[i - 1].timestamp_ms;
             if (frame.timestamp_ms < prev_timestamp) {
-                result.valid = false;
-                result.errors.push_back(
-                    "Frame " + std::to_string(i) + ": Timestamp not monotonic (" +
-                    std::to_string(frame.timestamp_ms) + " < " + std::to_string(prev_timestamp) + ")"
-                );
-            } else if (frame.timestamp_ms == prev_timestamp) {
-                result.warnings.push_back(
-                    "Frame " + std::to_string(i) + ": Duplicate timestamp " +
-                    std::to_string(frame.timestamp_ms)
-                );
+                record(result.non_monotonic, i);
+                if (result.non_monotonic.count <= VALIDATION_MAX_MESSAGES) {
+                    result.errors.push_back(
+                        "Frame " + std::to_string(i) + ": Timestamp not monotonic (" +
+                        std::to_string(frame.timestamp_ms) + " < " + std::to_string(prev_timestamp) + ")"
+                    );
+                }
+            } else {
+                uint32_t gap = frame.timestamp_ms - prev_timestamp;
+                result.gap_histogram[gapBucket(gap)]++;
+                if (gap == 0) {
+                    record(result.duplicate_timestamps, i);
+                    if (result.duplicate_timestamps.count <= VALIDATION_MAX_MESSAGES) {
+                        result.warnings.push_back(
+                            "Frame " + std::to_string(i) + ": Duplicate timestamp " +
+                            std::to_string(frame.timestamp_ms)
+                        );
+                    }
+                }
             }
         }
-        prev_timestamp = frame.timestamp_ms;
-        first_frame = false;
 
         // Check channel values
-        for (size_t ch = 0; ch < CRSF_MAX_CHANNELS; ch++) {
-            int16_t val = frame.channels[ch];
-            if (val < CRSF_CHANNEL_MIN || val > CRSF_CHANNEL_MAX) {
-                std::string msg = "Frame " + std::to_string(i) + ", CH" + std::to_string(ch + 1) +
-                    ": Value out of range (" + std::to_string(val) + ")";
-
-                if (strict) {
-                    result.valid = false;
-                    result.errors.push_back(msg);
-                } else {
-                    result.warnings.push_back(msg);
+        uint32_t bad = range.check(frame.channels);
+        if (bad) {
+            record(result.out_of_range, i);
+            for (size_t ch = 0; ch < CRSF_MAX_CHANNELS; ch++) {
+                if (!(bad & (1u << ch))) {
+                    continue;
+                }
+                result.channel_out_of_range[ch]++;
+                if (range_messages.size() < VALIDATION_MAX_MESSAGES) {
+                    range_messages.push_back(
+                        "Frame " + std::to_string(i) + ", CH" + std::to_string(ch + 1) +
+                        ": Value out of range (" + std::to_string(frame.channels[ch]) + ")"
+                    );
                 }
             }
         }
     }
 
+    range.minMax(result.channel_min, result.channel_max);
+
+    if (result.non_monotonic.count > 0) {
+        result.valid = false;
+        if (result.non_monotonic.count > VALIDATION_MAX_MESSAGES) {
+            result.errors.push_back(summarize("Timestamp not monotonic", result.non_monotonic));
+        }
+    }
+    if (result.duplicate_timestamps.count > VALIDATION_MAX_MESSAGES) {
+        result.warnings.push_back(summarize("Duplicate timestamp", result.duplicate_timestamps));
+    }
+
+    size_t range_total = 0;
+    for (size_t count : result.channel_out_of_range) {
+        range_total += count;
+    }
+    if (range_total > range_messages.size()) {
+        std::string msg = summarize("Value out of range", result.out_of_range) + ";";
+        for (size_t ch = 0; ch < CRSF_MAX_CHANNELS; ch++) {
+            if (result.channel_out_of_range[ch] > 0) {
+                msg += " CH" + std::to_string(ch + 1) + " x" +
+                    std::to_string(result.channel_out_of_range[ch]) + " (" +
+                    std::to_string(result.channel_min[ch]) + ".." +
+                    std::to_string(result.channel_max[ch]) + ")";
+            }
+        }
+        range_messages.push_back(msg);
+    }
+
+    auto& range_target = strict ? result.errors : result.warnings;
+    range_target.insert(range_target.end(), range_messages.begin(), range_messages.end());
+    if (strict && !range_messages.empty()) {
+        result.valid = false;
+    }
+
     // In strict mode, warnings become errors
     if (strict && !result.warnings.empty()) {
         result.valid = false;
@@ -326,6 +1128,7 @@ ValidationResult HistoryLoader::validate(const std::vector<HistoryFrame>& frames
 void HistoryLoader::calculateMetadata(const std::vector<HistoryFrame>& frames, const std::string& format) {
     m_metadata.format = format;
     m_metadata.frame_count = frames.size();
+    m_metadata.keyframe_count = frames.size();
 
     if (frames.empty()) {
         m_metadata.duration_ms = 0;
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <array>
 #include <string>
 #include <vector>
 
 #include "expresslrs_sender/types.hpp"
+#include "columnar_history.hpp"
 
 namespace elrs {
 namespace history {
@@ -11,32 +13,82 @@ namespace history {
 // Metadata for loaded history
 struct HistoryMetadata {
     std::string name;
-    std::string format;        // "csv" or "json"
+    std::string format;        // "csv", "json" or "elrsz"
     uint32_t duration_ms;
     size_t frame_count;
+    size_t keyframe_count;     // frames after collapsing duplicates (toColumnar)
     size_t channel_count;
     double packet_rate_hz;
+    bool estimated = false;    // probe(): count/rate/channels from samples
+    bool from_cache = false;   // load(): frames came from the history cache
 };
 
+// Aggregated occurrences of one kind of validation finding
+struct ValidationFinding {
+    size_t count = 0;          // offending frames
+    size_t first_index = 0;
+    size_t last_index = 0;
+};
+
+// Timestamp gap histogram buckets: [0] = 0ms, [k] = 2^(k-1) .. 2^k-1 ms,
+// last bucket = everything above
+constexpr size_t VALIDATION_GAP_BUCKETS = 12;
+
+// Detailed messages kept per finding kind; the rest is summarized
+constexpr size_t VALIDATION_MAX_MESSAGES = 10;
+
 // Validation result
 struct ValidationResult {
-    bool valid;
+    bool valid = true;
     std::vector<std::string> errors;
     std::vector<std::string> warnings;
+
+    // Aggregates over all frames
+    ValidationFinding non_monotonic;
+    ValidationFinding duplicate_timestamps;
+    ValidationFinding out_of_range;                        // frames with any channel out of range
+    std::array<size_t, CRSF_MAX_CHANNELS> channel_out_of_range{};
+    std::array<int16_t, CRSF_MAX_CHANNELS> channel_min{};
+    std::array<int16_t, CRSF_MAX_CHANNELS> channel_max{};
+    std::array<size_t, VALIDATION_GAP_BUCKETS> gap_histogram{};
 };
 
 class HistoryLoader {
 public:
     HistoryLoader() = default;
 
-    // Load history from file (auto-detect format)
+    // Load history from file (auto-detect format). With a cache directory
+    // set, CSV/JSON results are stored there and reused while the source is
+    // unchanged.
     Result<std::vector<HistoryFrame>> load(const std::string& filepath);
 
+    // Parsed-history cache directory (empty = disabled)
+    void setCacheDir(const std::string& dir) { m_cache_dir = dir; }
+
     // Load specific format
     Result<std::vector<HistoryFrame>> loadCsv(const std::string& filepath);
     Result<std::vector<HistoryFrame>> loadJson(const std::string& filepath);
+    Result<std::vector<HistoryFrame>> loadCompressed(const std::string& filepath);
+
+    // Load CSV by mapping the file and parsing newline-aligned chunks on
+    // `threads` threads (0 = hardware concurrency). Same result and error
+    // messages (global line numbers) as loadCsv. load() uses it for large files.
+    Result<std::vector<HistoryFrame>> loadCsvParallel(const std::string& filepath,
+                                                      size_t threads = 0);
+
+    // Metadata without building frames. Quick mode reads the .elrsz header
+    // or, for CSV, parses a sample at the head and tail and estimates the
+    // frame count from the file size (metadata.estimated = true). JSON and
+    // full_scan stream the whole file but keep no frames.
+    Result<HistoryMetadata> probe(const std::string& filepath, bool full_scan = false);
 
-    // Validate loaded frames
+    // Convert loaded frames to columnar storage, optionally collapsing runs
+    // of identical frames into keyframes (updates keyframe_count)
+    ColumnarHistory toColumnar(const std::vector<HistoryFrame>& frames, bool collapse_duplicates);
+
+    // Validate loaded frames in a single pass (vectorized channel range
+    // checks). Findings are aggregated; at most VALIDATION_MAX_MESSAGES
+    // detailed messages are kept per kind, followed by a summary line.
     ValidationResult validate(const std::vector<HistoryFrame>& frames, bool strict = false);
 
     // Get metadata after loading
@@ -44,6 +96,11 @@ public:
 
 private:
     HistoryMetadata m_metadata;
+    std::string m_cache_dir;
+
+    // Parse by format, bypassing the cache
+    Result<std::vector<HistoryFrame>> loadFormat(const std::string& filepath,
+                                                 const std::string& format);
 
     // Parse CSV line
     Result<HistoryFrame> parseCsvLine(const std::string& line, size_t line_num);
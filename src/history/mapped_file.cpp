@@ -0,0 +1,69 @@
+#include "mapped_file.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace elrs {
+namespace history {
+
+MappedFile::MappedFile() : m_data(nullptr), m_size(0) {}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+Result<void> MappedFile::open(const std::string& filepath) {
+    close();
+
+    int fd = ::open(filepath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return Result<void>::failure(
+            ErrorCode::HistoryError,
+            "Cannot open file: " + filepath
+        );
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return Result<void>::failure(
+            ErrorCode::HistoryError,
+            "Cannot stat file: " + filepath + ": " + std::strerror(errno)
+        );
+    }
+
+    m_size = static_cast<size_t>(st.st_size);
+    if (m_size > 0) {
+        void* addr = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            ::close(fd);
+            m_size = 0;
+            return Result<void>::failure(
+                ErrorCode::HistoryError,
+                "Cannot map file: " + filepath + ": " + std::strerror(errno)
+            );
+        }
+        // Parsed front to back
+        madvise(addr, m_size, MADV_SEQUENTIAL);
+        m_data = static_cast<const char*>(addr);
+    }
+
+    ::close(fd);
+    return Result<void>::success();
+}
+
+void MappedFile::close() {
+    if (m_data) {
+        munmap(const_cast<char*>(m_data), m_size);
+        m_data = nullptr;
+    }
+    m_size = 0;
+}
+
+}  // namespace history
+}  // namespace elrs
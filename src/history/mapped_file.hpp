@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "expresslrs_sender/types.hpp"
+
+namespace elrs {
+namespace history {
+
+// Read-only memory mapping of a whole file
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    // Disable copy
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Map file (an empty file maps successfully with size 0)
+    Result<void> open(const std::string& filepath);
+
+    // Unmap
+    void close();
+
+    const char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    const char* m_data;
+    size_t m_size;
+};
+
+}  // namespace history
+}  // namespace elrs
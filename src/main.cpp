@@ -1,20 +1,37 @@
+#include <atomic>
 #include <chrono>
+#include <cstdlib>
 #include <cstring>
+#include <filesystem>
+#include <iomanip>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <thread>
 
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/basic_file_sink.h>
 
 #include "config/config.hpp"
+#include "config/config_watcher.hpp"
+#include "control/control_server.hpp"
 #include "crsf/crsf.hpp"
 #include "gpio/gpio_uart_map.hpp"
+#include "history/compressed_history.hpp"
 #include "history/history_loader.hpp"
+#include "playback/frame_pipeline.hpp"
 #include "playback/playback_controller.hpp"
+#include "playback/raw_stream.hpp"
+#include "recorder/flight_recorder.hpp"
+#include "safety/failsafe_watchdog.hpp"
 #include "safety/safety_monitor.hpp"
 #include "scheduling/realtime.hpp"
+#include "scheduling/start_barrier.hpp"
 #include "uart/uart.hpp"
 
 using namespace elrs;
@@ -32,6 +49,7 @@ void printHelp(const char* program) {
         << "  -g, --gpio <pin>       GPIO TX pin number (auto-resolves UART device)\n"
         << "  -b, --baudrate <bps>   Baudrate (default: 921600)\n"
         << "  --no-realtime          Disable RT scheduling (SCHED_FIFO)\n"
+        << "  --no-cache             Do not use the parsed-history cache\n"
         << "  -v, --verbose          Verbose output\n"
         << "  -q, --quiet            Quiet mode (errors only)\n"
         << "  -h, --help             Show this help\n"
@@ -42,22 +60,39 @@ void printHelp(const char* program) {
         << "  ping       Ping TX module\n"
         << "  info       Show device info\n"
         << "  send       Send single command\n"
-        << "  gpio       Show GPIO-UART mapping table\n\n"
+        << "  gpio       Show GPIO-UART mapping table\n"
+        << "  latency-test  Measure RT loop wakeup latency (deployment check)\n"
+        << "  compress   Convert history to compressed .elrsz format\n"
+        << "  probe      Show history metadata without loading frames\n"
+        << "  export-crsf  Pre-render history into a raw CRSF wire stream\n"
+        << "  play-raw   Send a pre-rendered raw CRSF stream\n"
+        << "  record-export  Convert a flight recording to history CSV\n"
+        << "  bench-pipeline  Time the generic and specialized frame pipelines\n\n"
         << "Run '" << program << " <command> --help' for command-specific options.\n";
 }
 
 void printPlayHelp(const char* program) {
     std::cout << "Usage: " << program << " play [options] -H <file>\n\n"
         << "Options:\n"
-        << "  -H, --history <file>   History file to play (required)\n"
+        << "  -H, --history <file>   History file to play on the global device\n"
+        << "  -P, --port <dev>=<file>  Play <file> on an additional device or GPIO\n"
+        << "                         pin (repeatable, one sender thread per port)\n"
         << "  -r, --rate <hz>        Packet rate (default: 500)\n"
         << "  -l, --loop             Loop playback\n"
         << "  --loop-count <n>       Number of loops (0=infinite)\n"
+        << "  --reverse              Play from the end back to the start\n"
+        << "  --ping-pong            Loop back and forth (implies --loop; each\n"
+        << "                         direction counts as one loop)\n"
+        << "  --crossfade <ms>       Blend the last <ms> of a loop into the first\n"
         << "  --start-time <ms>      Start position\n"
         << "  --end-time <ms>        End position\n"
         << "  -s, --speed <factor>   Speed multiplier (default: 1.0)\n"
         << "  -n, --dry-run          Don't actually send\n"
-        << "  --arm-delay <ms>       Arm delay (default: 3000)\n";
+        << "  --arm-delay <ms>       Arm delay (default: 3000)\n"
+        << "  --start-at <epoch>     Start at CLOCK_REALTIME time (seconds, e.g. 1760000000.5)\n"
+        << "  --record <file>        Record sent frames to a flight recorder file\n"
+        << "  --watch-config         Apply config file changes while playing\n"
+        << "  --control <path>       Unix socket for pause/resume/seek/speed/loop/stats\n";
 }
 
 void printValidateHelp(const char* program) {
@@ -67,15 +102,80 @@ void printValidateHelp(const char* program) {
         << "  --strict               Treat warnings as errors\n";
 }
 
+void printCompressHelp(const char* program) {
+    std::cout << "Usage: " << program << " compress [options] -H <file> -o <file>\n\n"
+        << "Options:\n"
+        << "  -H, --history <file>   History file to convert (required)\n"
+        << "  -o, --output <file>    Output .elrsz file (required)\n"
+        << "  --block-frames <n>     Frames per seekable block (default: 4096)\n";
+}
+
+void printProbeHelp(const char* program) {
+    std::cout << "Usage: " << program << " probe [options] <file>...\n\n"
+        << "Options:\n"
+        << "  -H, --history <file>   History file (repeatable, or give files as arguments)\n"
+        << "  --full                 Scan the whole file for exact counts (no frames kept)\n";
+}
+
+void printExportCrsfHelp(const char* program) {
+    std::cout << "Usage: " << program << " export-crsf [options] -H <file> -o <file>\n\n"
+        << "Options:\n"
+        << "  -H, --history <file>   History file to render (required)\n"
+        << "  -o, --output <file>    Output .crsfraw file (required)\n"
+        << "  -r, --rate <hz>        Packet rate (default: 500)\n"
+        << "  -l, --loop             Loop playback (needs --loop-count or --duration)\n"
+        << "  --loop-count <n>       Number of loops\n"
+        << "  --reverse              Play from the end back to the start\n"
+        << "  --ping-pong            Loop back and forth (implies --loop)\n"
+        << "  --crossfade <ms>       Blend the last <ms> of a loop into the first\n"
+        << "  --start-time <ms>      Start position\n"
+        << "  --end-time <ms>        End position\n"
+        << "  -s, --speed <factor>   Speed multiplier (default: 1.0)\n"
+        << "  --arm-delay <ms>       Arm delay (default: 3000)\n"
+        << "  --duration <s>         Stop rendering after this many seconds\n";
+}
+
+void printPlayRawHelp(const char* program) {
+    std::cout << "Usage: " << program << " play-raw [options] -i <file>\n\n"
+        << "Options:\n"
+        << "  -i, --input <file>     Raw stream from export-crsf (required)\n"
+        << "  -n, --dry-run          Don't actually send\n";
+}
+
+void printRecordExportHelp(const char* program) {
+    std::cout << "Usage: " << program << " record-export [options] -i <file> -o <file>\n\n"
+        << "Options:\n"
+        << "  -i, --input <file>     Flight recorder file (required)\n"
+        << "  -o, --output <file>    Output history CSV (required)\n"
+        << "  --details              Append slot, safety state and telemetry columns\n";
+}
+
+void printBenchPipelineHelp(const char* program) {
+    std::cout << "Usage: " << program << " bench-pipeline [options]\n\n"
+        << "Options:\n"
+        << "  --frames <n>           Frames per run (default: 1000000)\n";
+}
+
+void printLatencyTestHelp(const char* program) {
+    std::cout << "Usage: " << program << " latency-test [options]\n\n"
+        << "Options:\n"
+        << "  --duration <s>         Test length in seconds (default: config, 10)\n"
+        << "  -r, --rate <hz>        Packet rate (default: 500)\n"
+        << "  --pty                  Write frames to a dummy pty instead of no device\n";
+}
+
+// Config "logging.level" value (unknown = info)
+spdlog::level::level_enum parseLogLevel(const std::string& level) {
+    if (level == "trace") return spdlog::level::trace;
+    if (level == "debug") return spdlog::level::debug;
+    if (level == "warn") return spdlog::level::warn;
+    if (level == "error") return spdlog::level::err;
+    return spdlog::level::info;
+}
+
 // Setup logging
 void setupLogging(const std::string& level, const std::string& log_file) {
-    spdlog::level::level_enum log_level = spdlog::level::info;
-
-    if (level == "trace") log_level = spdlog::level::trace;
-    else if (level == "debug") log_level = spdlog::level::debug;
-    else if (level == "info") log_level = spdlog::level::info;
-    else if (level == "warn") log_level = spdlog::level::warn;
-    else if (level == "error") log_level = spdlog::level::err;
+    spdlog::level::level_enum log_level = parseLogLevel(level);
 
     auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
     console_sink->set_level(log_level);
@@ -93,21 +193,388 @@ void setupLogging(const std::string& level, const std::string& log_file) {
     spdlog::set_default_logger(logger);
 }
 
+// Optional per-port hooks of the send callback
+struct SendHooks {
+    recorder::FlightRecorder* recorder = nullptr;            // Log every frame
+    const playback::PlaybackController* playback = nullptr;  // Slot index for the recorder
+    safety::FailsafeWatchdog* watchdog = nullptr;            // Heartbeat and port ownership
+    const playback::ChannelTransform* transform = nullptr;   // Applied before safety
+    const config::ConfigWatcher* reload = nullptr;           // Live config, adopted per slot
+    control::ControlChannel* control = nullptr;              // Telemetry for the control socket
+};
+
+// Build the per-slot send callback: channel transforms, safety shaping,
+// CRSF encoding and UART write. Shared by play and latency-test so both
+// exercise the same path.
+playback::FrameSendCallback makeSendCallback(safety::SafetyMonitor& safety_monitor,
+                                             uart::UartDriver& uart, bool send,
+                                             const SendHooks& hooks = {}) {
+    // Transforms, safety, packing and CRC; specialized for the common
+    // layout when the configuration allows. The pipeline reuses the last
+    // encoded frame while the (safety-processed) channels do not change.
+    std::shared_ptr<playback::FramePipeline> pipeline = playback::makeFramePipeline(
+        safety_monitor, hooks.transform, true, hooks.reload != nullptr);
+    spdlog::debug("Frame pipeline: {}", pipeline->name());
+
+    recorder::FlightRecorder* recorder = hooks.recorder;
+    const playback::PlaybackController* playback = hooks.playback;
+    safety::FailsafeWatchdog* watchdog = hooks.watchdog;
+    const config::ConfigWatcher* reload = hooks.reload;
+    control::ControlChannel* control = hooks.control;
+
+    // Live config snapshot in use by this port (kept alive while in use)
+    struct LiveState {
+        std::shared_ptr<const config::LiveConfig> snapshot;
+        uint64_t generation = 0;
+    };
+    auto live = std::make_shared<LiveState>();
+
+    return [&safety_monitor, &uart, send, pipeline, recorder, playback, watchdog, reload, live,
+            control](
+               const ChannelData& channels) -> bool {
+        // Check for shutdown
+        if (safety::SafetyMonitor::isShutdownRequested()) {
+            return false;
+        }
+        if (watchdog) {
+            watchdog->heartbeat();
+        }
+
+        // Adopt a reloaded config at the slot boundary. One atomic load per
+        // slot; the snapshot was parsed and compiled on the watch thread,
+        // and the old one is freed there.
+        if (reload && reload->generation() != live->generation) {
+            live->snapshot = reload->current();
+            live->generation = live->snapshot->generation;
+            safety_monitor.setConfig(live->snapshot->safety);
+            pipeline->setTransform(live->snapshot->transform);
+            if (watchdog) {
+                watchdog->setTimeout(live->snapshot->safety.failsafe_timeout_ms);
+            }
+        }
+
+        // Transform, then process through safety (safety settings refer to
+        // the transformed layout), and encode
+        ChannelData safe_channels;
+        const auto& frame = pipeline->process(channels, std::chrono::steady_clock::now(),
+                                              safe_channels);
+
+        recorder::FlightRecord record{};
+        if (recorder) {
+            record.send_time_ns = static_cast<uint64_t>(
+                std::chrono::steady_clock::now().time_since_epoch().count());
+            record.slot = playback ? playback->getSlotIndex() : 0;
+            record.playback_time_ms = playback ? playback->getPlaybackTimeMs() : 0;
+            record.safety_state = static_cast<uint8_t>(safety_monitor.getState());
+            record.telemetry_size = 0;
+            record.flags = send ? 0 : recorder::FLIGHT_RECORD_NOT_SENT;
+            record.channels = safe_channels;
+        }
+
+        // While the watchdog owns the port it sends the failsafe frames
+        bool owns_port = !watchdog || watchdog->senderOwnsPort();
+        bool write = send && owns_port;
+        if (recorder && !write) {
+            record.flags |= recorder::FLIGHT_RECORD_NOT_SENT;
+        }
+
+        if (write) {
+            auto write_result = uart.write(frame);
+            if (!write_result.ok()) {
+                spdlog::error("UART write failed: {}", write_result.message);
+                if (recorder) {
+                    record.flags |= recorder::FLIGHT_RECORD_NOT_SENT;
+                    recorder->record(record);
+                }
+                return false;
+            }
+            if (recorder || control) {
+                size_t drained = uart.drainTelemetry(1, record.telemetry, sizeof(record.telemetry));
+                record.telemetry_size = static_cast<uint8_t>(
+                    std::min(drained, sizeof(record.telemetry)));
+                if (drained > sizeof(record.telemetry)) {
+                    record.flags |= recorder::FLIGHT_RECORD_TELEMETRY_TRUNCATED;
+                }
+                if (control && drained > 0) {
+                    auto& status = control->status();
+                    status.telemetry_bytes += drained;
+                    status.telemetry_size = static_cast<uint8_t>(
+                        std::min<size_t>(record.telemetry_size, sizeof(status.telemetry)));
+                    std::memcpy(status.telemetry, record.telemetry, status.telemetry_size);
+                }
+            } else {
+                uart.drainTelemetry();
+            }
+        }
+
+        if (recorder) {
+            recorder->record(record);
+        }
+        if (owns_port) {
+            safety_monitor.notifyFrameSent();
+        }
+        return true;
+    };
+}
+
+// Emergency disarm fast path for one port. The frame is encoded before
+// playback starts; on a shutdown signal the sender is woken and writes it
+// from the next slot on at the packet rate, still under RT priority.
+struct EmergencyDisarm {
+    uart::UartDriver* uart = nullptr;            // nullptr = dry-run (not written)
+    safety::FailsafeWatchdog* watchdog = nullptr;
+    recorder::FlightRecorder* recorder = nullptr;      // Log each disarm frame
+    const safety::SafetyMonitor* safety_monitor = nullptr;  // State for the recorder
+    ChannelData channels{};                      // Channels encoded in `frame`
+    std::array<uint8_t, CRSF_RC_FRAME_SIZE> frame{};
+    int frames = 10;
+    std::chrono::nanoseconds interval{20000000};  // Packet rate
+
+    // Results
+    int frames_sent = 0;
+    double latency_us = -1;                      // Signal to first disarm frame
+};
+
+// Sleep until close to `deadline`, then spin (not interruptible)
+void waitUntil(std::chrono::steady_clock::time_point deadline) {
+    auto remaining = deadline - std::chrono::steady_clock::now();
+    if (remaining > std::chrono::microseconds(200)) {
+        std::this_thread::sleep_for(remaining - std::chrono::microseconds(200));
+    }
+    while (std::chrono::steady_clock::now() < deadline) {
+    }
+}
+
+// Write the disarm frames: the first immediately (the woken sender's next
+// slot), the rest one interval apart
+void runEmergencyDisarm(EmergencyDisarm& disarm) {
+    auto next = std::chrono::steady_clock::now();
+    for (int i = 0; i < disarm.frames; i++, next += disarm.interval) {
+        waitUntil(next);
+
+        recorder::FlightRecord record{};
+        if (disarm.recorder) {
+            // No slot: sent after playback has stopped
+            record.send_time_ns = static_cast<uint64_t>(
+                std::chrono::steady_clock::now().time_since_epoch().count());
+            record.safety_state = disarm.safety_monitor
+                ? static_cast<uint8_t>(disarm.safety_monitor->getState()) : 0;
+            record.flags = recorder::FLIGHT_RECORD_DISARM;
+            if (!disarm.uart) {
+                record.flags |= recorder::FLIGHT_RECORD_NOT_SENT;
+            }
+            record.channels = disarm.channels;
+        }
+
+        if (disarm.uart) {
+            auto write_result = disarm.uart->write(disarm.frame);
+            if (!write_result.ok()) {
+                spdlog::error("Disarm frame write failed: {}", write_result.message);
+                if (disarm.recorder) {
+                    record.flags |= recorder::FLIGHT_RECORD_NOT_SENT;
+                    disarm.recorder->record(record);
+                }
+                break;
+            }
+        }
+        if (disarm.recorder) {
+            disarm.recorder->record(record);
+        }
+        if (i == 0) {
+            int64_t signal_ns = safety::SafetyMonitor::getShutdownSignalTimeNs();
+            int64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+            if (signal_ns > 0) {
+                disarm.latency_us = (now_ns - signal_ns) / 1000.0;
+            }
+        }
+        disarm.frames_sent++;
+        // Keeps the watchdog from taking the port over mid-sequence
+        if (disarm.watchdog) {
+            disarm.watchdog->heartbeat();
+        }
+        if (disarm.uart) {
+            disarm.uart->drainTelemetry();
+        }
+    }
+}
+
+// Main send loop: tick playback at slot deadlines, sleeping until close to
+// the next slot and spin-waiting the rest. A shutdown signal ends the sleep
+// early; with `disarm` the disarm frames are then sent before returning.
+// With `control`, queued commands are applied between slots and the status
+// is published after each frame.
+void runSendLoop(playback::PlaybackController& playback,
+                 safety::SafetyMonitor& safety_monitor,
+                 EmergencyDisarm* disarm = nullptr,
+                 control::ControlChannel* control = nullptr) {
+    bool sent_any = false;
+
+    // Stopped covers both completion and a failed send callback
+    while (playback.getState() != PlaybackState::Stopped &&
+           !safety::SafetyMonitor::isShutdownRequested()) {
+        if (control) {
+            control::applyCommands(*control, playback);
+        }
+        if (playback.tick()) {
+            sent_any = true;
+            if (control) {
+                control::publishStatus(*control, playback, safety_monitor);
+            }
+        }
+        // No failsafe before the first slot (e.g. waiting for --start-at)
+        if (sent_any) {
+            safety_monitor.checkFailsafe();
+        }
+
+        // Sleep until close to next send time, then spin-wait. A shutdown
+        // signal wakes the sleep immediately.
+        auto now = std::chrono::steady_clock::now();
+        auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(
+            playback.getNextSendTime() - now);
+        if (remaining.count() > 200) {
+            safety::SafetyMonitor::waitForShutdown(std::min<std::chrono::microseconds>(
+                remaining - std::chrono::microseconds(200), std::chrono::milliseconds(100)));
+        }
+    }
+
+    if (safety::SafetyMonitor::isShutdownRequested()) {
+        // The signal handler only reaches the monitor it was installed
+        // with; every port's sender moves its own monitor here
+        safety_monitor.emergencyStop();
+        if (disarm) {
+            runEmergencyDisarm(*disarm);
+        }
+        // Logged here, not in the signal handler; after the disarm frames
+        // so console output cannot delay them
+        spdlog::critical("EMERGENCY STOP");
+    }
+}
+
+// Report channels on which the safety limiter changed values
+void logLimiterStats(const std::string& prefix, const safety::LimiterStats& stats) {
+    for (size_t ch = 0; ch < CRSF_MAX_CHANNELS; ch++) {
+        if (stats.range[ch] + stats.slew[ch] + stats.deadband[ch] > 0) {
+            spdlog::info("{}Limiter ch{}: range={} slew={} deadband={} frames", prefix, ch + 1,
+                stats.range[ch], stats.slew[ch], stats.deadband[ch]);
+        }
+    }
+}
+
+// One TX module driven by play: its own UART, safety monitor and history
+struct PortSession {
+    std::string device;
+    std::string history_file;
+    uart::UartDriver uart;
+    safety::SafetyMonitor safety_monitor;
+    playback::PlaybackController playback;
+    recorder::FlightRecorder recorder;
+    safety::FailsafeWatchdog watchdog;
+    EmergencyDisarm disarm;
+    std::unique_ptr<control::ControlChannel> control;   // nullptr = no control socket
+    scheduling::PageFaultCounts faults_before;
+};
+
+// Load and validate a history file; returns 0 or an exit code
+int loadHistory(const std::string& history_file, const config::AppConfig& config,
+                history::ColumnarHistory& history_out) {
+    history::HistoryLoader loader;
+    loader.setCacheDir(config::resolveHistoryCacheDir(config.history_cache));
+    auto load_result = loader.load(history_file);
+    if (!load_result.ok()) {
+        spdlog::error("Failed to load history: {}", load_result.message);
+        return static_cast<int>(load_result.error);
+    }
+
+    const auto& metadata = loader.getMetadata();
+    spdlog::info("Loaded {} frames from {} ({:.1f}s, {:.1f}Hz){}",
+        metadata.frame_count, history_file,
+        metadata.duration_ms / 1000.0, metadata.packet_rate_hz,
+        metadata.from_cache ? " [cached]" : "");
+
+    auto validation = loader.validate(load_result.value, false);
+    for (const auto& warn : validation.warnings) {
+        spdlog::warn("{}", warn);
+    }
+    if (!validation.valid) {
+        for (const auto& err : validation.errors) {
+            spdlog::error("{}", err);
+        }
+        return static_cast<int>(ErrorCode::HistoryError);
+    }
+
+    size_t row_bytes = load_result.value.size() * sizeof(HistoryFrame);
+    history_out = loader.toColumnar(load_result.value, config.playback.collapse_duplicates);
+    spdlog::debug("History storage: {} keyframes, {} bytes columnar ({} bytes as rows), "
+        "constant channels mask 0x{:04x}",
+        history_out.size(), history_out.memoryBytes(), row_bytes, history_out.constantMask());
+    return 0;
+}
+
+// Sender thread body for one port: RT placement, shared start, send loop.
+// With several ports, port `index` is pinned to `cpu` (chosen by cmdPlay,
+// -1 = default placement) and its slots are staggered by
+// interval * index / count.
+void runPortSession(PortSession& session, const config::AppConfig& config, bool dry_run,
+                    scheduling::StartBarrier& barrier, size_t index, size_t count, int cpu) {
+    if (!config.no_realtime) {
+        scheduling::RealtimeOptions rt_options = config.realtime;
+        if (cpu >= 0) {
+            rt_options.cpu_affinity = {cpu};
+        }
+        scheduling::enableRealtimeScheduling(rt_options, dry_run ? "" : session.device);
+    }
+
+    auto start_time = barrier.arriveAndWait();
+    session.faults_before = scheduling::getPageFaultCounts();
+
+    auto interval = std::chrono::microseconds(
+        static_cast<int64_t>(1000000.0 / config.playback.rate_hz));
+    session.playback.start(start_time + interval * static_cast<int64_t>(index) /
+        static_cast<int64_t>(count));
+
+    runSendLoop(session.playback, session.safety_monitor, &session.disarm,
+                session.control.get());
+    // Other ports may still be playing; the watchdog is stopped after
+    // all of them, so tell it this sender's silence is not a stall
+    session.watchdog.senderDone();
+}
+
 // Command: play
 int cmdPlay(config::AppConfig& config, int argc, char* argv[]) {
     std::string history_file;
+    std::vector<std::pair<std::string, std::string>> extra_ports;  // device, history
     bool dry_run = false;
+    double start_at = 0;  // CLOCK_REALTIME seconds (0 = start immediately)
 
     // Parse play-specific arguments
     for (int i = 0; i < argc; i++) {
         if (strcmp(argv[i], "-H") == 0 || strcmp(argv[i], "--history") == 0) {
             if (i + 1 < argc) history_file = argv[++i];
+        } else if (strcmp(argv[i], "-P") == 0 || strcmp(argv[i], "--port") == 0) {
+            if (i + 1 < argc) {
+                std::string spec = argv[++i];
+                size_t eq = spec.find('=');
+                if (eq == std::string::npos || eq == 0 || eq + 1 == spec.size()) {
+                    spdlog::error("Invalid --port '{}' (expected <device|gpio>=<history>)", spec);
+                    return static_cast<int>(ErrorCode::ArgumentError);
+                }
+                extra_ports.emplace_back(gpio::resolveDevicePath(spec.substr(0, eq)),
+                                         spec.substr(eq + 1));
+            }
         } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--rate") == 0) {
             if (i + 1 < argc) config.playback.rate_hz = std::stod(argv[++i]);
         } else if (strcmp(argv[i], "-l") == 0 || strcmp(argv[i], "--loop") == 0) {
             config.playback.loop = true;
         } else if (strcmp(argv[i], "--loop-count") == 0) {
             if (i + 1 < argc) config.playback.loop_count = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--reverse") == 0) {
+            config.playback.reverse = true;
+        } else if (strcmp(argv[i], "--ping-pong") == 0) {
+            config.playback.loop = true;
+            config.playback.loop_mode = playback::LoopMode::PingPong;
+        } else if (strcmp(argv[i], "--crossfade") == 0) {
+            if (i + 1 < argc) config.playback.crossfade_ms = std::stoul(argv[++i]);
         } else if (strcmp(argv[i], "--start-time") == 0) {
             if (i + 1 < argc) config.playback.start_time_ms = std::stoul(argv[++i]);
         } else if (strcmp(argv[i], "--end-time") == 0) {
@@ -118,162 +585,435 @@ int cmdPlay(config::AppConfig& config, int argc, char* argv[]) {
             dry_run = true;
         } else if (strcmp(argv[i], "--arm-delay") == 0) {
             if (i + 1 < argc) config.playback.arm_delay_ms = std::stoul(argv[++i]);
+        } else if (strcmp(argv[i], "--start-at") == 0) {
+            if (i + 1 < argc) start_at = std::stod(argv[++i]);
+        } else if (strcmp(argv[i], "--record") == 0) {
+            if (i + 1 < argc) config.record_path = argv[++i];
+        } else if (strcmp(argv[i], "--watch-config") == 0) {
+            config.reload.enabled = true;
+        } else if (strcmp(argv[i], "--control") == 0) {
+            if (i + 1 < argc) config.control_socket = argv[++i];
         } else if (strcmp(argv[i], "--help") == 0) {
             printPlayHelp("expresslrs_sender");
             return 0;
         }
     }
 
-    if (history_file.empty()) {
+    if (history_file.empty() && extra_ports.empty()) {
         spdlog::error("History file is required (-H)");
         return static_cast<int>(ErrorCode::ArgumentError);
     }
 
-    // Load history
-    history::HistoryLoader loader;
-    auto load_result = loader.load(history_file);
-    if (!load_result.ok()) {
-        spdlog::error("Failed to load history: {}", load_result.message);
-        return static_cast<int>(load_result.error);
+    // Port list: -H plays on the global device, each --port adds one more
+    std::vector<std::pair<std::string, std::string>> port_specs;
+    if (!history_file.empty()) {
+        port_specs.emplace_back(config.device_port, history_file);
     }
+    port_specs.insert(port_specs.end(), extra_ports.begin(), extra_ports.end());
 
-    auto& frames = load_result.value;
-    const auto& metadata = loader.getMetadata();
+    for (size_t i = 0; i < port_specs.size(); i++) {
+        for (size_t j = i + 1; j < port_specs.size(); j++) {
+            if (port_specs[i].first == port_specs[j].first) {
+                spdlog::error("Device {} is used by more than one port", port_specs[i].first);
+                return static_cast<int>(ErrorCode::ArgumentError);
+            }
+        }
+    }
 
-    spdlog::info("Loaded {} frames from {} ({:.1f}s, {:.1f}Hz)",
-        metadata.frame_count, history_file,
-        metadata.duration_ms / 1000.0, metadata.packet_rate_hz);
+    // Compiled once, shared read-only by all sender threads
+    playback::ChannelTransform transform;
+    transform.compile(config.transforms);
+    if (!transform.isIdentity()) {
+        spdlog::info("Channel transforms: {} steps", config.transforms.size());
+    }
 
-    // Validate
-    auto validation = loader.validate(frames, false);
-    for (const auto& warn : validation.warnings) {
-        spdlog::warn("{}", warn);
+    // Config hot reload: the watch thread is created here, before any RT
+    // placement, so it runs at normal priority
+    config::ConfigWatcher watcher;
+    if (config.reload.enabled) {
+        auto watch_result = watcher.start(config, [](const config::LiveConfig& live) {
+            spdlog::default_logger()->sinks().front()->set_level(parseLogLevel(live.log_level));
+        });
+        if (!watch_result.ok()) {
+            spdlog::error("Failed to watch config: {}", watch_result.message);
+            return static_cast<int>(watch_result.error);
+        }
     }
-    if (!validation.valid) {
-        for (const auto& err : validation.errors) {
-            spdlog::error("{}", err);
+
+    std::vector<std::unique_ptr<PortSession>> sessions;
+    for (const auto& spec : port_specs) {
+        auto session = std::make_unique<PortSession>();
+        session->device = spec.first;
+        session->history_file = spec.second;
+
+        // Load history
+        history::ColumnarHistory history;
+        int rc = loadHistory(session->history_file, config, history);
+        if (rc != 0) {
+            return rc;
+        }
+
+        // Setup safety monitor
+        session->safety_monitor.setConfig(config.safety);
+
+        // Setup UART (unless dry-run)
+        if (!dry_run) {
+            uart::UartOptions uart_opts;
+            uart_opts.baudrate = config.baudrate;
+            uart_opts.half_duplex = config.half_duplex;
+
+            auto uart_result = session->uart.open(session->device, uart_opts);
+            if (!uart_result.ok()) {
+                spdlog::error("Failed to open UART: {}", uart_result.message);
+                return static_cast<int>(uart_result.error);
+            }
+            spdlog::info("Opened {} at {} baud{}", session->device, config.baudrate,
+                config.half_duplex ? " (half-duplex)" : "");
+        }
+
+        // Flight recorder: one file per port (<path>, <path>.1, ...). Opened
+        // here so its flush thread is created before any RT placement.
+        if (!config.record_path.empty()) {
+            std::string record_path = config.record_path;
+            if (!sessions.empty()) {
+                record_path += "." + std::to_string(sessions.size());
+            }
+            auto record_result = session->recorder.open(record_path, config.recorder);
+            if (!record_result.ok()) {
+                spdlog::error("Failed to start flight recorder: {}", record_result.message);
+                return static_cast<int>(record_result.error);
+            }
+        }
+
+        // Setup playback controller
+        session->playback.setHistory(std::move(history));
+        session->playback.setOptions(config.playback);
+        // Failsafe watchdog: own thread and descriptor, started before RT
+        // placement so it keeps its own priority
+        if (config.watchdog.enabled) {
+            auto watchdog_result = session->watchdog.start(
+                session->safety_monitor, dry_run ? "" : session->device, config.watchdog,
+                session->recorder.isOpen() ? &session->recorder : nullptr);
+            if (!watchdog_result.ok()) {
+                spdlog::error("Failed to start watchdog: {}", watchdog_result.message);
+                return static_cast<int>(watchdog_result.error);
+            }
+        }
+
+        SendHooks hooks;
+        hooks.recorder = session->recorder.isOpen() ? &session->recorder : nullptr;
+        hooks.playback = &session->playback;
+        hooks.watchdog = session->watchdog.isRunning() ? &session->watchdog : nullptr;
+        hooks.transform = &transform;
+        hooks.reload = watcher.isRunning() ? &watcher : nullptr;
+        if (!config.control_socket.empty()) {
+            session->control = std::make_unique<control::ControlChannel>(session->device);
+            hooks.control = session->control.get();
+        }
+        session->playback.setFrameCallback(
+            makeSendCallback(session->safety_monitor, session->uart, !dry_run, hooks));
+
+        session->disarm.uart = dry_run ? nullptr : &session->uart;
+        session->disarm.watchdog = hooks.watchdog;
+        session->disarm.recorder = hooks.recorder;
+        session->disarm.safety_monitor = &session->safety_monitor;
+        session->disarm.channels = session->safety_monitor.getFailsafeChannels();
+        session->disarm.frame = crsf::buildRcChannelsFrame(session->disarm.channels);
+        session->disarm.frames = config.safety.disarm_frames;
+        session->disarm.interval = std::chrono::nanoseconds(
+            static_cast<int64_t>(1e9 / config.playback.rate_hz));
+
+        sessions.push_back(std::move(session));
+    }
+
+    if (dry_run) {
+        spdlog::info("Dry-run mode - not sending to device");
+    }
+
+    // Control socket: its thread is created before RT placement, and only
+    // talks to the senders through their lock-free channels
+    control::ControlServer control_server;
+    if (!config.control_socket.empty()) {
+        std::vector<control::ControlChannel*> channels;
+        for (auto& session : sessions) {
+            channels.push_back(session->control.get());
+        }
+        auto control_result = control_server.start(config.control_socket, channels);
+        if (!control_result.ok()) {
+            spdlog::error("Failed to start control socket: {}", control_result.message);
+            return static_cast<int>(control_result.error);
         }
-        return static_cast<int>(ErrorCode::HistoryError);
+    }
+    // The handler stops port 0's monitor directly; every sender (including
+    // port 0's) also stops its own monitor as soon as it wakes
+    safety::SafetyMonitor::installSignalHandlers(&sessions.front()->safety_monitor);
+
+    // Start playback
+    spdlog::info("Starting playback at {:.1f}Hz (speed {:.1f}x){}{}{}",
+        config.playback.rate_hz, config.playback.speed,
+        config.playback.reverse ? " [REVERSE]" : "",
+        !config.playback.loop ? "" :
+            config.playback.loop_mode == playback::LoopMode::PingPong ? " [PING-PONG]" : " [LOOP]",
+        sessions.size() > 1 ? " on " + std::to_string(sessions.size()) + " ports" : "");
+
+    // Real-time scheduling is applied per sender thread before the shared
+    // start, so placement and prefaulting do not delay the first slots
+    scheduling::StartBarrier barrier(sessions.size());
+
+    // Scheduled start: the first slot lands on the CLOCK_REALTIME deadline
+    if (start_at > 0) {
+        auto target = std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                std::chrono::duration<double>(start_at)));
+        auto deadline = scheduling::mapRealtimeToSteady(target);
+        auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (wait.count() < 0) {
+            spdlog::warn("--start-at is {}ms in the past, starting immediately", -wait.count());
+        } else {
+            spdlog::info("Scheduled start at {:.3f} (in {:.3f}s)", start_at, wait.count() / 1000.0);
+        }
+
+        auto interval = std::chrono::microseconds(
+            static_cast<int64_t>(1000000.0 / config.playback.rate_hz));
+        barrier.setStartTime(deadline - interval);
+    }
+    if (sessions.size() == 1) {
+        runPortSession(*sessions.front(), config, dry_run, barrier, 0, 1, -1);
+    } else {
+        // One CPU per port: the senders spin before each slot, and isolated
+        // CPUs are not load-balanced, so ports sharing a core delay each other
+        std::vector<int> port_cpus;
+        if (!config.no_realtime) {
+            port_cpus = scheduling::selectRealtimeCpus(config.realtime,
+                scheduling::getIsolatedCpus(), scheduling::getNohzFullCpus());
+            if (!port_cpus.empty() && port_cpus.size() < sessions.size()) {
+                spdlog::warn("{} ports but only {} RT CPU(s) [{}]: ports sharing a CPU are "
+                    "staggered on it and may delay each other's slots",
+                    sessions.size(), port_cpus.size(), scheduling::formatCpuList(port_cpus));
+            }
+        }
+
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < sessions.size(); i++) {
+            int cpu = port_cpus.empty() ? -1 : port_cpus[i % port_cpus.size()];
+            threads.emplace_back(runPortSession, std::ref(*sessions[i]), std::cref(config),
+                                 dry_run, std::ref(barrier), i, sessions.size(), cpu);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    auto faults_after = scheduling::getPageFaultCounts();
+
+    if (!config.no_realtime) {
+        scheduling::disableRealtimeScheduling();
+    }
+
+    control_server.stop();
+    watcher.stop();
+    if (watcher.reloads() + watcher.rejected() > 0) {
+        spdlog::info("Config reloads: {} applied, {} rejected", watcher.reloads(), watcher.rejected());
+    }
+
+    for (auto& session : sessions) {
+        session->watchdog.stop();
+        if (session->recorder.isOpen()) {
+            session->recorder.close();
+            spdlog::info("Flight recorder: {} frames recorded, {} dropped",
+                session->recorder.flushed(), session->recorder.dropped());
+        }
+    }
+
+    // Print stats
+    bool port_failed = false;
+    for (const auto& session : sessions) {
+        auto stats = session->playback.getStats();
+        std::string prefix = sessions.size() > 1 ? "[" + session->device + "] " : "";
+        spdlog::info("{}Playback complete: {} frames, {} loops, {:.1f}s, {:.1f}Hz actual, "
+            "avg_jitter={:.1f}us max_jitter={:.1f}us missed_slots={} start_error={:.0f}us",
+            prefix, stats.frames_sent, stats.loops_completed,
+            stats.elapsed_ms / 1000.0, stats.actual_rate_hz,
+            stats.timing_jitter_us, stats.max_jitter_us, stats.missed_slots,
+            stats.start_error_us);
+        logLimiterStats(prefix, session->safety_monitor.getLimiterStats());
+        if (session->disarm.frames_sent > 0) {
+            spdlog::info("{}Emergency disarm: {} frames{}, first {:.0f}us after signal",
+                prefix, session->disarm.frames_sent, dry_run ? " (dry-run)" : "",
+                session->disarm.latency_us);
+        }
+        if (session->watchdog.getStats().takeovers > 0) {
+            auto watchdog_stats = session->watchdog.getStats();
+            spdlog::warn("{}Watchdog: {} takeovers, {} failsafe frames, max stall {}ms",
+                prefix, watchdog_stats.takeovers, watchdog_stats.failsafe_frames,
+                watchdog_stats.max_stall_ms);
+        }
+
+        if (!session->playback.isComplete() && !safety::SafetyMonitor::isShutdownRequested()) {
+            spdlog::error("{}Playback stopped early", prefix);
+            port_failed = true;
+        }
+    }
+
+    auto faults_before = sessions.front()->faults_before;
+    spdlog::info("Page faults: before minor={} major={}, after minor={} major={} "
+        "(+{} minor, +{} major during playback)",
+        faults_before.minor, faults_before.major,
+        faults_after.minor, faults_after.major,
+        faults_after.minor - faults_before.minor,
+        faults_after.major - faults_before.major);
+
+    if (safety::SafetyMonitor::isShutdownRequested()) {
+        return 130;
+    }
+    return port_failed ? static_cast<int>(ErrorCode::DeviceError) : 0;
+}
+
+// Command: latency-test
+// Runs the play loop (same callback, scheduler settings and sleep strategy)
+// on a synthetic disarmed history and reports wakeup latency.
+int cmdLatencyTest(config::AppConfig& config, int argc, char* argv[]) {
+    uint32_t duration_s = config.latency_test.duration_s;
+    bool use_pty = false;
+
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "--duration") == 0) {
+            if (i + 1 < argc) duration_s = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--rate") == 0) {
+            if (i + 1 < argc) config.playback.rate_hz = std::stod(argv[++i]);
+        } else if (strcmp(argv[i], "--pty") == 0) {
+            use_pty = true;
+        } else if (strcmp(argv[i], "--help") == 0) {
+            printLatencyTestHelp("expresslrs_sender");
+            return 0;
+        }
+    }
+
+    if (duration_s == 0 || config.playback.rate_hz <= 0) {
+        spdlog::error("Duration and rate must be positive");
+        return static_cast<int>(ErrorCode::ArgumentError);
     }
 
-    // Setup safety monitor
     safety::SafetyMonitor safety_monitor;
     safety_monitor.setConfig(config.safety);
     safety::SafetyMonitor::installSignalHandlers(&safety_monitor);
 
-    // Setup UART (unless dry-run)
+    // Synthetic history: disarmed channels for the whole test
+    ChannelData idle = safety_monitor.getFailsafeChannels();
+    std::vector<HistoryFrame> frames{
+        {0, idle},
+        {duration_s * 1000, idle},
+    };
+
+    // Optional dummy UART: pty slave opened through UartDriver, master drained
+    // by a normal-priority thread so writes never block
     uart::UartDriver uart;
-    if (!dry_run) {
+    int pty_master = -1;
+    std::atomic<bool> pty_running{false};
+    std::thread pty_reader;
+    if (use_pty) {
+        pty_master = posix_openpt(O_RDWR | O_NOCTTY);
+        if (pty_master < 0 || grantpt(pty_master) != 0 || unlockpt(pty_master) != 0) {
+            spdlog::error("Failed to create pty: {}", strerror(errno));
+            if (pty_master >= 0) close(pty_master);
+            return static_cast<int>(ErrorCode::DeviceError);
+        }
+        std::string slave = ptsname(pty_master);
+
         uart::UartOptions uart_opts;
         uart_opts.baudrate = config.baudrate;
         uart_opts.half_duplex = config.half_duplex;
-
-        auto uart_result = uart.open(config.device_port, uart_opts);
+        auto uart_result = uart.open(slave, uart_opts);
         if (!uart_result.ok()) {
-            spdlog::error("Failed to open UART: {}", uart_result.message);
+            spdlog::error("Failed to open pty: {}", uart_result.message);
+            close(pty_master);
             return static_cast<int>(uart_result.error);
         }
-        spdlog::info("Opened {} at {} baud{}", config.device_port, config.baudrate,
-            config.half_duplex ? " (half-duplex)" : "");
-    } else {
-        spdlog::info("Dry-run mode - not sending to device");
+
+        pty_running = true;
+        pty_reader = std::thread([&]() {
+            uint8_t buf[1024];
+            while (pty_running) {
+                struct pollfd pfd{};
+                pfd.fd = pty_master;
+                pfd.events = POLLIN;
+                if (poll(&pfd, 1, 10) > 0) {
+                    (void)::read(pty_master, buf, sizeof(buf));
+                }
+            }
+        });
+        spdlog::info("Writing frames to dummy pty {}", slave);
     }
 
-    // Setup playback controller
+    playback::PlaybackOptions options;
+    options.rate_hz = config.playback.rate_hz;
+
     playback::PlaybackController playback;
     playback.setFrames(std::move(frames));
-    playback.setOptions(config.playback);
+    playback.setOptions(options);
+    playback.setFrameCallback(makeSendCallback(safety_monitor, uart, use_pty));
 
-    // Frame send callback
-    playback.setFrameCallback([&](const ChannelData& channels) -> bool {
-        // Check for shutdown
-        if (safety::SafetyMonitor::isShutdownRequested()) {
-            return false;
-        }
-
-        // Process through safety
-        ChannelData safe_channels = channels;
-        safety_monitor.processChannels(safe_channels);
+    scheduling::LatencyHistogram histogram;
+    playback.setLatencyHistogram(&histogram);
 
-        // Build and send frame
-        auto frame = crsf::buildRcChannelsFrame(safe_channels);
+    std::cout << "Running latency test for " << duration_s << "s at "
+              << options.rate_hz << "Hz" << (use_pty ? " (pty)" : "") << "...\n";
 
-        if (!dry_run) {
-            auto write_result = uart.write(frame);
-            if (!write_result.ok()) {
-                spdlog::error("UART write failed: {}", write_result.message);
-                return false;
-            }
-            uart.drainTelemetry();
-        }
-
-        safety_monitor.notifyFrameSent();
-        return true;
-    });
-
-    // Start playback
-    spdlog::info("Starting playback at {:.1f}Hz (speed {:.1f}x){}",
-        config.playback.rate_hz, config.playback.speed,
-        config.playback.loop ? " [LOOP]" : "");
-
-    playback.start();
-
-    // Enable real-time scheduling for precise timing
     if (!config.no_realtime) {
-        scheduling::enableRealtimeScheduling();
+        scheduling::enableRealtimeScheduling(config.realtime, "");
     }
+    auto faults_before = scheduling::getPageFaultCounts();
 
-    // Main loop with improved sleep strategy
-    auto next_send = std::chrono::steady_clock::now();
-    auto send_interval = std::chrono::microseconds(
-        static_cast<int64_t>(1000000.0 / config.playback.rate_hz));
+    playback.start();
 
-    while (!playback.isComplete() && !safety::SafetyMonitor::isShutdownRequested()) {
-        if (playback.tick()) {
-            next_send += send_interval;
-        }
-        safety_monitor.checkFailsafe();
+    runSendLoop(playback, safety_monitor);
 
-        // Sleep until close to next send time, then spin-wait
-        auto now = std::chrono::steady_clock::now();
-        auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(
-            next_send - now);
-        if (remaining.count() > 200) {
-            std::this_thread::sleep_for(remaining - std::chrono::microseconds(200));
-        }
-    }
+    auto faults_after = scheduling::getPageFaultCounts();
 
     if (!config.no_realtime) {
         scheduling::disableRealtimeScheduling();
     }
 
-    // Emergency stop handling - send disarm frames
-    if (safety::SafetyMonitor::isShutdownRequested() && !dry_run) {
-        spdlog::info("Sending {} disarm frames...", config.safety.disarm_frames);
-        auto disarm_channels = safety_monitor.getFailsafeChannels();
-        auto disarm_frame = crsf::buildRcChannelsFrame(disarm_channels);
-
-        for (int i = 0; i < config.safety.disarm_frames; i++) {
-            uart.write(disarm_frame);
-            uart.drainTelemetry();
-            std::this_thread::sleep_for(std::chrono::milliseconds(20));
-        }
+    if (use_pty) {
+        pty_running = false;
+        pty_reader.join();
+        uart.close();
+        close(pty_master);
     }
 
-    // Print stats
     auto stats = playback.getStats();
-    spdlog::info("Playback complete: {} frames, {} loops, {:.1f}s, {:.1f}Hz actual, "
-        "avg_jitter={:.1f}us max_jitter={:.1f}us",
-        stats.frames_sent, stats.loops_completed,
-        stats.elapsed_ms / 1000.0, stats.actual_rate_hz,
-        stats.timing_jitter_us, stats.max_jitter_us);
-
-    return safety::SafetyMonitor::isShutdownRequested() ? 130 : 0;
+    const auto& limits = config.latency_test;
+    int64_t p99 = histogram.percentile(99.0);
+
+    bool pass = p99 <= limits.max_p99_us &&
+                histogram.max() <= limits.max_latency_us &&
+                stats.missed_slots <= limits.max_missed_slots &&
+                !safety::SafetyMonitor::isShutdownRequested();
+
+    std::cout << "Latency test results:\n"
+        << "  Slots: " << histogram.count() << " (" << stats.actual_rate_hz << "Hz actual)\n"
+        << "  Wakeup latency: avg=" << histogram.mean() << "us"
+        << " p50=" << histogram.percentile(50.0) << "us"
+        << " p90=" << histogram.percentile(90.0) << "us"
+        << " p99=" << p99 << "us"
+        << " p99.9=" << histogram.percentile(99.9) << "us\n"
+        << "  Max overrun: " << histogram.max() << "us (limit " << limits.max_latency_us << "us)\n"
+        << "  p99 limit: " << limits.max_p99_us << "us\n"
+        << "  Missed slots: " << stats.missed_slots
+        << " (limit " << limits.max_missed_slots << ")\n"
+        << "  Page faults: +" << (faults_after.minor - faults_before.minor) << " minor, +"
+        << (faults_after.major - faults_before.major) << " major\n"
+        << "Result: " << (pass ? "PASS" : "FAIL") << "\n";
+
+    if (safety::SafetyMonitor::isShutdownRequested()) {
+        return 130;
+    }
+    return pass ? 0 : static_cast<int>(ErrorCode::GeneralError);
 }
 
 // Command: validate
 int cmdValidate(config::AppConfig& config, int argc, char* argv[]) {
-    (void)config;
     std::string history_file;
     bool strict = false;
 
@@ -294,6 +1034,7 @@ int cmdValidate(config::AppConfig& config, int argc, char* argv[]) {
     }
 
     history::HistoryLoader loader;
+    loader.setCacheDir(config::resolveHistoryCacheDir(config.history_cache));
     auto load_result = loader.load(history_file);
     if (!load_result.ok()) {
         std::cout << "Validating: " << history_file << "\n";
@@ -311,6 +1052,29 @@ int cmdValidate(config::AppConfig& config, int argc, char* argv[]) {
         << "  Channels: " << metadata.channel_count << "\n"
         << "  Rate: " << metadata.packet_rate_hz << "Hz\n";
 
+    std::cout << "  Channel range:";
+    for (size_t ch = 0; ch < metadata.channel_count && ch < CRSF_MAX_CHANNELS; ch++) {
+        std::cout << " CH" << (ch + 1) << "=" << validation.channel_min[ch]
+            << ".." << validation.channel_max[ch];
+    }
+    std::cout << "\n  Timestamp gaps:";
+    for (size_t b = 0; b < validation.gap_histogram.size(); b++) {
+        if (validation.gap_histogram[b] == 0) {
+            continue;
+        }
+        if (b == 0) {
+            std::cout << " 0ms";
+        } else if (b + 1 == validation.gap_histogram.size()) {
+            std::cout << " >=" << (1u << (b - 1)) << "ms";
+        } else if (b == 1) {
+            std::cout << " 1ms";
+        } else {
+            std::cout << " " << (1u << (b - 1)) << "-" << ((1u << b) - 1) << "ms";
+        }
+        std::cout << ":" << validation.gap_histogram[b];
+    }
+    std::cout << "\n";
+
     if (!validation.warnings.empty()) {
         std::cout << "  Warnings:\n";
         for (const auto& warn : validation.warnings) {
@@ -330,6 +1094,514 @@ int cmdValidate(config::AppConfig& config, int argc, char* argv[]) {
     return validation.valid ? 0 : static_cast<int>(ErrorCode::HistoryError);
 }
 
+int cmdCompress(config::AppConfig& config, int argc, char* argv[]) {
+    std::string history_file;
+    std::string output_file;
+    uint32_t block_frames = history::COMPRESSED_HISTORY_BLOCK_FRAMES;
+
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "-H") == 0 || strcmp(argv[i], "--history") == 0) {
+            if (i + 1 < argc) history_file = argv[++i];
+        } else if (strcmp(argv[i], "-o") == 0 || strcmp(argv[i], "--output") == 0) {
+            if (i + 1 < argc) output_file = argv[++i];
+        } else if (strcmp(argv[i], "--block-frames") == 0) {
+            if (i + 1 < argc) block_frames = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (strcmp(argv[i], "--help") == 0) {
+            printCompressHelp("expresslrs_sender");
+            return 0;
+        }
+    }
+
+    if (history_file.empty() || output_file.empty()) {
+        spdlog::error("History file (-H) and output file (-o) are required");
+        return static_cast<int>(ErrorCode::ArgumentError);
+    }
+
+    history::HistoryLoader loader;
+    loader.setCacheDir(config::resolveHistoryCacheDir(config.history_cache));
+    auto load_result = loader.load(history_file);
+    if (!load_result.ok()) {
+        spdlog::error("Failed to load history: {}", load_result.message);
+        return static_cast<int>(load_result.error);
+    }
+
+    auto save_result = history::saveCompressedHistory(output_file, load_result.value, block_frames);
+    if (!save_result.ok()) {
+        spdlog::error("Failed to write {}: {}", output_file, save_result.message);
+        return static_cast<int>(save_result.error);
+    }
+
+    std::error_code ec;
+    auto in_size = std::filesystem::file_size(history_file, ec);
+    auto out_size = std::filesystem::file_size(output_file, ec);
+    std::cout << "Compressed " << load_result.value.size() << " frames: "
+        << in_size << " -> " << out_size << " bytes";
+    if (out_size > 0) {
+        std::cout << " (" << std::fixed << std::setprecision(1)
+            << static_cast<double>(in_size) / static_cast<double>(out_size) << "x)";
+    }
+    std::cout << "\n";
+
+    return 0;
+}
+
+int cmdProbe(int argc, char* argv[]) {
+    std::vector<std::string> files;
+    bool full_scan = false;
+
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "-H") == 0 || strcmp(argv[i], "--history") == 0) {
+            if (i + 1 < argc) files.push_back(argv[++i]);
+        } else if (strcmp(argv[i], "--full") == 0) {
+            full_scan = true;
+        } else if (strcmp(argv[i], "--help") == 0) {
+            printProbeHelp("expresslrs_sender");
+            return 0;
+        } else if (argv[i][0] != '-') {
+            files.push_back(argv[i]);
+        }
+    }
+
+    if (files.empty()) {
+        spdlog::error("At least one history file is required");
+        return static_cast<int>(ErrorCode::ArgumentError);
+    }
+
+    int rc = 0;
+    history::HistoryLoader loader;
+    for (const auto& file : files) {
+        auto result = loader.probe(file, full_scan);
+        if (!result.ok()) {
+            std::cout << file << ": ERROR " << result.message << "\n";
+            rc = static_cast<int>(result.error);
+            continue;
+        }
+
+        // "~" marks values estimated from head/tail samples
+        const auto& m = result.value;
+        const char* approx = m.estimated ? "~" : "";
+        std::cout << file << ": " << m.format
+            << " frames=" << approx << m.frame_count
+            << " duration=" << std::fixed << std::setprecision(1) << (m.duration_ms / 1000.0) << "s"
+            << " rate=" << approx << m.packet_rate_hz << "Hz"
+            << " channels=" << approx << m.channel_count;
+        if (!m.name.empty()) {
+            std::cout << " name=\"" << m.name << "\"";
+        }
+        std::cout << "\n";
+    }
+
+    return rc;
+}
+
+// Command: export-crsf
+int cmdExportCrsf(config::AppConfig& config, int argc, char* argv[]) {
+    std::string history_file;
+    std::string output_file;
+    double duration_s = 0;
+
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "-H") == 0 || strcmp(argv[i], "--history") == 0) {
+            if (i + 1 < argc) history_file = argv[++i];
+        } else if (strcmp(argv[i], "-o") == 0 || strcmp(argv[i], "--output") == 0) {
+            if (i + 1 < argc) output_file = argv[++i];
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--rate") == 0) {
+            if (i + 1 < argc) config.playback.rate_hz = std::stod(argv[++i]);
+        } else if (strcmp(argv[i], "-l") == 0 || strcmp(argv[i], "--loop") == 0) {
+            config.playback.loop = true;
+        } else if (strcmp(argv[i], "--loop-count") == 0) {
+            if (i + 1 < argc) config.playback.loop_count = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--reverse") == 0) {
+            config.playback.reverse = true;
+        } else if (strcmp(argv[i], "--ping-pong") == 0) {
+            config.playback.loop = true;
+            config.playback.loop_mode = playback::LoopMode::PingPong;
+        } else if (strcmp(argv[i], "--crossfade") == 0) {
+            if (i + 1 < argc) config.playback.crossfade_ms = std::stoul(argv[++i]);
+        } else if (strcmp(argv[i], "--start-time") == 0) {
+            if (i + 1 < argc) config.playback.start_time_ms = std::stoul(argv[++i]);
+        } else if (strcmp(argv[i], "--end-time") == 0) {
+            if (i + 1 < argc) config.playback.end_time_ms = std::stoul(argv[++i]);
+        } else if (strcmp(argv[i], "-s") == 0 || strcmp(argv[i], "--speed") == 0) {
+            if (i + 1 < argc) config.playback.speed = std::stod(argv[++i]);
+        } else if (strcmp(argv[i], "--arm-delay") == 0) {
+            if (i + 1 < argc) config.playback.arm_delay_ms = std::stoul(argv[++i]);
+        } else if (strcmp(argv[i], "--duration") == 0) {
+            if (i + 1 < argc) duration_s = std::stod(argv[++i]);
+        } else if (strcmp(argv[i], "--help") == 0) {
+            printExportCrsfHelp("expresslrs_sender");
+            return 0;
+        }
+    }
+
+    if (history_file.empty() || output_file.empty()) {
+        spdlog::error("History file (-H) and output file (-o) are required");
+        return static_cast<int>(ErrorCode::ArgumentError);
+    }
+    if (config.playback.rate_hz <= 0) {
+        spdlog::error("Rate must be positive");
+        return static_cast<int>(ErrorCode::ArgumentError);
+    }
+    if (config.playback.loop && config.playback.loop_count == 0 && duration_s <= 0) {
+        spdlog::error("Infinite loop cannot be exported; use --loop-count or --duration");
+        return static_cast<int>(ErrorCode::ArgumentError);
+    }
+
+    history::ColumnarHistory history;
+    int rc = loadHistory(history_file, config, history);
+    if (rc != 0) {
+        return rc;
+    }
+
+    uint64_t max_slots = duration_s > 0
+        ? static_cast<uint64_t>(duration_s * config.playback.rate_hz) : 0;
+    playback::ChannelTransform transform;
+    transform.compile(config.transforms);
+    auto stream = playback::renderRawStream(std::move(history), config.playback,
+                                            config.safety, max_slots,
+                                            transform.isIdentity() ? nullptr : &transform);
+    if (stream.slots.empty()) {
+        spdlog::error("Nothing to export (empty playback range)");
+        return static_cast<int>(ErrorCode::HistoryError);
+    }
+
+    auto save_result = playback::saveRawStream(output_file, stream);
+    if (!save_result.ok()) {
+        spdlog::error("Failed to write {}: {}", output_file, save_result.message);
+        return static_cast<int>(save_result.error);
+    }
+
+    std::error_code ec;
+    auto out_size = std::filesystem::file_size(output_file, ec);
+    std::cout << "Exported " << stream.slots.size() << " slots ("
+        << std::fixed << std::setprecision(1)
+        << stream.slots.size() / config.playback.rate_hz << "s at "
+        << config.playback.rate_hz << "Hz, " << stream.data.size() / CRSF_RC_FRAME_SIZE
+        << " stored frames): " << out_size << " bytes\n";
+
+    return 0;
+}
+
+// Command: play-raw
+// Minimal replay path: the stream is mapped and each slot's bytes are
+// written at its deadline. No history decoding, safety shaping or encoding
+// happens in the loop; those were applied by export-crsf.
+int cmdPlayRaw(config::AppConfig& config, int argc, char* argv[]) {
+    std::string input_file;
+    bool dry_run = false;
+
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "-i") == 0 || strcmp(argv[i], "--input") == 0) {
+            if (i + 1 < argc) input_file = argv[++i];
+        } else if (strcmp(argv[i], "-n") == 0 || strcmp(argv[i], "--dry-run") == 0) {
+            dry_run = true;
+        } else if (strcmp(argv[i], "--help") == 0) {
+            printPlayRawHelp("expresslrs_sender");
+            return 0;
+        }
+    }
+
+    if (input_file.empty()) {
+        spdlog::error("Raw stream file is required (-i)");
+        return static_cast<int>(ErrorCode::ArgumentError);
+    }
+
+    playback::RawStreamReader reader;
+    auto open_result = reader.open(input_file);
+    if (!open_result.ok()) {
+        spdlog::error("Failed to open {}: {}", input_file, open_result.message);
+        return static_cast<int>(open_result.error);
+    }
+    if (reader.slotCount() == 0 || reader.intervalNs() == 0) {
+        spdlog::error("Raw stream {} is empty", input_file);
+        return static_cast<int>(ErrorCode::HistoryError);
+    }
+    spdlog::info("Loaded {} slots from {} ({:.1f}s, {:.1f}Hz)", reader.slotCount(), input_file,
+        reader.slotCount() / reader.rateHz(), reader.rateHz());
+
+    uart::UartDriver uart;
+    if (!dry_run) {
+        uart::UartOptions uart_opts;
+        uart_opts.baudrate = config.baudrate;
+        uart_opts.half_duplex = config.half_duplex;
+
+        auto uart_result = uart.open(config.device_port, uart_opts);
+        if (!uart_result.ok()) {
+            spdlog::error("Failed to open UART: {}", uart_result.message);
+            return static_cast<int>(uart_result.error);
+        }
+        spdlog::info("Opened {} at {} baud{}", config.device_port, config.baudrate,
+            config.half_duplex ? " (half-duplex)" : "");
+    } else {
+        spdlog::info("Dry-run mode - not sending to device");
+    }
+
+    safety::SafetyMonitor safety_monitor;
+    safety_monitor.setConfig(config.safety);
+    safety::SafetyMonitor::installSignalHandlers(&safety_monitor);
+
+    if (!config.no_realtime) {
+        scheduling::enableRealtimeScheduling(config.realtime, dry_run ? "" : config.device_port);
+    }
+    auto faults_before = scheduling::getPageFaultCounts();
+
+    scheduling::LatencyHistogram histogram;
+    auto interval = std::chrono::nanoseconds(reader.intervalNs());
+
+    EmergencyDisarm disarm;
+    disarm.uart = dry_run ? nullptr : &uart;
+    disarm.frame = crsf::buildRcChannelsFrame(safety_monitor.getFailsafeChannels());
+    disarm.frames = config.safety.disarm_frames;
+    disarm.interval = interval;
+    uint64_t missed_slots = 0;
+    size_t slots_sent = 0;
+    bool write_failed = false;
+
+    auto start_time = std::chrono::steady_clock::now();
+    size_t i = 0;
+    while (i < reader.slotCount() && !safety::SafetyMonitor::isShutdownRequested()) {
+        auto slot = reader.slot(i);
+        auto deadline = start_time + std::chrono::nanoseconds(slot.deadline_ns);
+
+        // Sleep until close to the deadline, then spin (same strategy as
+        // runSendLoop)
+        auto now = std::chrono::steady_clock::now();
+        auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(deadline - now);
+        if (remaining.count() > 200) {
+            safety::SafetyMonitor::waitForShutdown(std::min<std::chrono::microseconds>(
+                remaining - std::chrono::microseconds(200), std::chrono::milliseconds(100)));
+            continue;
+        }
+        while (now < deadline) {
+            now = std::chrono::steady_clock::now();
+        }
+
+        histogram.record(std::chrono::duration_cast<std::chrono::microseconds>(
+            now - deadline).count());
+
+        if (!dry_run) {
+            auto write_result = uart.write(reader.slotData(slot), slot.size);
+            if (!write_result.ok()) {
+                spdlog::error("UART write failed: {}", write_result.message);
+                write_failed = true;
+                break;
+            }
+            uart.drainTelemetry();
+        }
+        slots_sent++;
+        i++;
+
+        // More than 3 slots behind: skip to the current slot instead of
+        // bursting (as PlaybackController does)
+        if (now - deadline > interval * 3) {
+            auto behind = static_cast<uint64_t>((now - deadline) / interval);
+            auto skip = std::min<uint64_t>(behind, reader.slotCount() - i);
+            missed_slots += skip;
+            i += static_cast<size_t>(skip);
+        }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start_time;
+
+    if (safety::SafetyMonitor::isShutdownRequested()) {
+        runEmergencyDisarm(disarm);
+        spdlog::critical("EMERGENCY STOP");
+    }
+
+    auto faults_after = scheduling::getPageFaultCounts();
+    if (!config.no_realtime) {
+        scheduling::disableRealtimeScheduling();
+    }
+
+    double elapsed_s = std::chrono::duration<double>(elapsed).count();
+    spdlog::info("Raw playback complete: {} slots, {:.1f}s, {:.1f}Hz actual, "
+        "avg_latency={:.1f}us p99={}us max={}us missed_slots={}",
+        slots_sent, elapsed_s, elapsed_s > 0 ? slots_sent / elapsed_s : 0.0,
+        histogram.mean(), histogram.percentile(99.0), histogram.max(), missed_slots);
+    if (disarm.frames_sent > 0) {
+        spdlog::info("Emergency disarm: {} frames{}, first {:.0f}us after signal",
+            disarm.frames_sent, dry_run ? " (dry-run)" : "", disarm.latency_us);
+    }
+    spdlog::info("Page faults: +{} minor, +{} major during playback",
+        faults_after.minor - faults_before.minor, faults_after.major - faults_before.major);
+
+    if (safety::SafetyMonitor::isShutdownRequested()) {
+        return 130;
+    }
+    return write_failed ? static_cast<int>(ErrorCode::DeviceError) : 0;
+}
+
+// Command: bench-pipeline
+// Times the generic and specialized frame pipelines (config transforms,
+// safety, packing, CRC) on a synthetic stick sweep that changes every
+// channel each frame, so every frame is re-encoded.
+int cmdBenchPipeline(config::AppConfig& config, int argc, char* argv[]) {
+    size_t frames = 1000000;
+
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "--frames") == 0) {
+            if (i + 1 < argc) frames = std::stoul(argv[++i]);
+        } else if (strcmp(argv[i], "--help") == 0) {
+            printBenchPipelineHelp("expresslrs_sender");
+            return 0;
+        }
+    }
+    if (frames == 0) {
+        spdlog::error("--frames must be positive");
+        return static_cast<int>(ErrorCode::ArgumentError);
+    }
+
+    playback::ChannelTransform transform;
+    transform.compile(config.transforms);
+
+    // Armed from the first frame so throttle passes through safety
+    safety::SafetyConfig safety_config = config.safety;
+    safety_config.arm_delay_ms = 0;
+    std::vector<ChannelData> inputs(1024);
+    for (size_t i = 0; i < inputs.size(); i++) {
+        for (size_t ch = 0; ch < CRSF_MAX_CHANNELS; ch++) {
+            inputs[i][ch] = static_cast<int16_t>(CRSF_CHANNEL_MIN +
+                (i * 7 + ch * 97) % (CRSF_CHANNEL_MAX - CRSF_CHANNEL_MIN + 1));
+        }
+        if (safety_config.arm_channel >= 0 &&
+            safety_config.arm_channel < static_cast<int>(CRSF_MAX_CHANNELS)) {
+            inputs[i][static_cast<size_t>(safety_config.arm_channel)] = CRSF_CHANNEL_MAX;
+        }
+    }
+
+    struct Run {
+        std::string name;
+        double ns_per_frame = 0;
+        uint64_t checksum = 0;
+    };
+    auto run = [&](bool allow_specialized) {
+        auto level = spdlog::get_level();
+        spdlog::set_level(spdlog::level::err);  // Arming messages
+        safety::SafetyMonitor monitor;
+        monitor.setConfig(safety_config);
+        auto pipeline = playback::makeFramePipeline(monitor, &transform, allow_specialized);
+
+        Run result;
+        result.name = pipeline->name();
+        ChannelData safe_channels;
+        auto now = std::chrono::steady_clock::time_point{};  // Virtual 500Hz clock
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < frames; i++) {
+            const auto& frame = pipeline->process(inputs[i % inputs.size()], now, safe_channels);
+            result.checksum += frame[CRSF_RC_FRAME_SIZE - 1];
+            now += std::chrono::microseconds(2000);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        result.ns_per_frame = std::chrono::duration<double, std::nano>(elapsed).count() / frames;
+        spdlog::set_level(level);
+        return result;
+    };
+
+    // Best of three alternating runs
+    Run generic = run(false);
+    Run specialized = run(true);
+    for (int repeat = 1; repeat < 3; repeat++) {
+        Run g = run(false);
+        Run s = run(true);
+        generic.ns_per_frame = std::min(generic.ns_per_frame, g.ns_per_frame);
+        specialized.ns_per_frame = std::min(specialized.ns_per_frame, s.ns_per_frame);
+    }
+
+    std::cout << "Frame pipeline benchmark (" << frames << " frames, "
+              << config.transforms.size() << " transform steps, arm CH"
+              << (safety_config.arm_channel + 1) << ")\n";
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  generic:      " << generic.ns_per_frame << " ns/frame\n";
+    if (specialized.name == generic.name) {
+        std::cout << "  specialized:  not available for this configuration\n";
+        return 0;
+    }
+    std::cout << "  specialized:  " << specialized.ns_per_frame << " ns/frame ("
+              << std::setprecision(2) << generic.ns_per_frame / specialized.ns_per_frame
+              << "x)\n";
+
+    if (generic.checksum != specialized.checksum) {
+        spdlog::error("Pipelines produced different frames");
+        return static_cast<int>(ErrorCode::GeneralError);
+    }
+    return 0;
+}
+
+// Command: record-export
+int cmdRecordExport(int argc, char* argv[]) {
+    std::string input_file;
+    std::string output_file;
+    bool details = false;
+
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "-i") == 0 || strcmp(argv[i], "--input") == 0) {
+            if (i + 1 < argc) input_file = argv[++i];
+        } else if (strcmp(argv[i], "-o") == 0 || strcmp(argv[i], "--output") == 0) {
+            if (i + 1 < argc) output_file = argv[++i];
+        } else if (strcmp(argv[i], "--details") == 0) {
+            details = true;
+        } else if (strcmp(argv[i], "--help") == 0) {
+            printRecordExportHelp("expresslrs_sender");
+            return 0;
+        }
+    }
+
+    if (input_file.empty() || output_file.empty()) {
+        spdlog::error("Recording (-i) and output file (-o) are required");
+        return static_cast<int>(ErrorCode::ArgumentError);
+    }
+
+    recorder::FlightRecordReader reader;
+    auto open_result = reader.open(input_file);
+    if (!open_result.ok()) {
+        spdlog::error("Failed to open {}: {}", input_file, open_result.message);
+        return static_cast<int>(open_result.error);
+    }
+
+    // Summary: slot gaps are missed slots, states are counted per frame
+    recorder::FlightRecord record{};
+    uint64_t slot_gaps = 0;
+    uint64_t not_sent = 0;
+    uint64_t telemetry_frames = 0;
+    uint64_t watchdog_frames = 0;
+    uint64_t disarm_frames = 0;
+    uint64_t prev_slot = 0;
+    bool have_slot = false;
+    for (size_t i = 0; i < reader.size(); i++) {
+        reader.read(i, record);
+        if (record.flags & recorder::FLIGHT_RECORD_NOT_SENT) not_sent++;
+        // Watchdog and disarm frames are outside the slot clock
+        if (record.flags & recorder::FLIGHT_RECORD_WATCHDOG) {
+            watchdog_frames++;
+            continue;
+        }
+        if (record.flags & recorder::FLIGHT_RECORD_DISARM) {
+            disarm_frames++;
+            continue;
+        }
+        if (have_slot && record.slot > prev_slot + 1) {
+            slot_gaps += record.slot - prev_slot - 1;
+        }
+        prev_slot = record.slot;
+        have_slot = true;
+        if (record.telemetry_size > 0) telemetry_frames++;
+    }
+
+    auto convert_result = recorder::convertRecordingToCsv(input_file, output_file, details);
+    if (!convert_result.ok()) {
+        spdlog::error("Failed to write {}: {}", output_file, convert_result.message);
+        return static_cast<int>(convert_result.error);
+    }
+
+    std::cout << "Exported " << convert_result.value << " frames to " << output_file << "\n"
+        << "  Missed slots: " << slot_gaps << "\n"
+        << "  Not sent: " << not_sent << "\n"
+        << "  Watchdog failsafe frames: " << watchdog_frames << "\n"
+        << "  Emergency disarm frames: " << disarm_frames << "\n"
+        << "  Frames with telemetry: " << telemetry_frames << "\n"
+        << "  Dropped by recorder: " << reader.dropped() << "\n";
+    return 0;
+}
+
 // Read a complete CRSF frame from UART with timeout
 bool readCrsfFrame(uart::UartDriver& uart, std::vector<uint8_t>& frame_out, int timeout_ms) {
     std::vector<uint8_t> buffer;
@@ -568,7 +1840,7 @@ int cmdSend(config::AppConfig& config, int argc, char* argv[]) {
 
     // Enable real-time scheduling
     if (!config.no_realtime) {
-        scheduling::enableRealtimeScheduling();
+        scheduling::enableRealtimeScheduling(config.realtime, config.device_port);
     }
 
     auto start = std::chrono::steady_clock::now();
@@ -622,6 +1894,9 @@ int cmdSend(config::AppConfig& config, int argc, char* argv[]) {
         std::this_thread::sleep_for(std::chrono::milliseconds(2));
     }
 
+    if (safety::SafetyMonitor::isShutdownRequested()) {
+        spdlog::critical("EMERGENCY STOP");
+    }
     spdlog::info("Done");
     return 0;
 }
@@ -658,7 +1933,7 @@ int main(int argc, char* argv[]) {
     // Default configuration
     config::AppConfig config = config::getDefaultConfig();
     std::string config_file;
-    std::string log_level = "info";
+    std::string log_level;  // -v/-q; empty = config logging.level
     std::string command;
     int cmd_argc = 0;
     char** cmd_argv = nullptr;
@@ -667,6 +1942,7 @@ int main(int argc, char* argv[]) {
     std::string cli_device;
     int cli_gpio_tx = -1;
     int cli_baudrate = -1;
+    bool cli_no_cache = false;
 
     // Parse global arguments
     int i = 1;
@@ -681,6 +1957,8 @@ int main(int argc, char* argv[]) {
             if (i + 1 < argc) cli_baudrate = std::stoi(argv[++i]);
         } else if (strcmp(argv[i], "--no-realtime") == 0) {
             config.no_realtime = true;
+        } else if (strcmp(argv[i], "--no-cache") == 0) {
+            cli_no_cache = true;
         } else if (strcmp(argv[i], "-v") == 0 || strcmp(argv[i], "--verbose") == 0) {
             log_level = "debug";
         } else if (strcmp(argv[i], "-q") == 0 || strcmp(argv[i], "--quiet") == 0) {
@@ -722,12 +2000,18 @@ int main(int argc, char* argv[]) {
         config.gpio_tx = cli_gpio_tx;
         config.device_port = gpio::resolveDevicePath(std::to_string(cli_gpio_tx));
     }
+    if (cli_no_cache) {
+        config.history_cache.enabled = false;
+    }
     if (cli_baudrate >= 0) {
         config.baudrate = cli_baudrate;
     }
 
     // Setup logging
-    setupLogging(log_level, config.log_file);
+    if (!log_level.empty()) {
+        config.log_level = log_level;
+    }
+    setupLogging(config.log_level, config.log_file);
 
     // No command specified
     if (command.empty()) {
@@ -748,6 +2032,20 @@ int main(int argc, char* argv[]) {
         return cmdSend(config, cmd_argc, cmd_argv);
     } else if (command == "gpio") {
         return cmdGpio();
+    } else if (command == "latency-test") {
+        return cmdLatencyTest(config, cmd_argc, cmd_argv);
+    } else if (command == "compress") {
+        return cmdCompress(config, cmd_argc, cmd_argv);
+    } else if (command == "probe") {
+        return cmdProbe(cmd_argc, cmd_argv);
+    } else if (command == "export-crsf") {
+        return cmdExportCrsf(config, cmd_argc, cmd_argv);
+    } else if (command == "play-raw") {
+        return cmdPlayRaw(config, cmd_argc, cmd_argv);
+    } else if (command == "record-export") {
+        return cmdRecordExport(cmd_argc, cmd_argv);
+    } else if (command == "bench-pipeline") {
+        return cmdBenchPipeline(config, cmd_argc, cmd_argv);
     } else {
         std::cerr << "Unknown command: " << command << "\n";
         printHelp(argv[0]);
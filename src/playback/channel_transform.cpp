@@ -0,0 +1,142 @@
+#include "channel_transform.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace elrs {
+namespace playback {
+
+namespace {
+
+// Compile-time view of one output channel
+struct ChannelState {
+    int source;
+    bool constant = false;
+    int16_t value = 0;
+    std::vector<int16_t> lut;       // Empty = identity
+};
+
+int16_t clampOutput(double v) {
+    double rounded = std::lround(v);
+    return static_cast<int16_t>(std::min<double>(
+        std::max<double>(rounded, CRSF_CHANNEL_MIN), CRSF_CHANNEL_MAX));
+}
+
+// Value function of a Reverse/Scale/Expo step
+int16_t evaluate(const TransformStep& step, int16_t v) {
+    switch (step.op) {
+        case TransformStep::Op::Reverse:
+            return clampOutput(CRSF_CHANNEL_MIN + CRSF_CHANNEL_MAX - v);
+        case TransformStep::Op::Scale:
+            return clampOutput(step.center + (v - step.center) * step.scale + step.offset);
+        case TransformStep::Op::Expo: {
+            // MID is not exactly centered; each side keeps its end point
+            const double half_range = v < CRSF_CHANNEL_MID
+                ? CRSF_CHANNEL_MID - CRSF_CHANNEL_MIN : CRSF_CHANNEL_MAX - CRSF_CHANNEL_MID;
+            double x = std::min(std::max((v - CRSF_CHANNEL_MID) / half_range, -1.0), 1.0);
+            double y = (1.0 - step.expo) * x + step.expo * x * x * x;
+            return clampOutput(CRSF_CHANNEL_MID + y * half_range);
+        }
+        default:
+            return v;
+    }
+}
+
+}  // namespace
+
+ChannelTransform::ChannelTransform()
+    : m_identity(true) {
+    for (size_t ch = 0; ch < CRSF_MAX_CHANNELS; ch++) {
+        m_program[ch] = {Kind::Copy, static_cast<uint8_t>(ch), 0, 0};
+    }
+}
+
+void ChannelTransform::compile(const TransformConfig& steps) {
+    std::array<ChannelState, CRSF_MAX_CHANNELS> state;
+    for (size_t ch = 0; ch < CRSF_MAX_CHANNELS; ch++) {
+        state[ch].source = static_cast<int>(ch);
+    }
+
+    for (const auto& step : steps) {
+        if (step.op == TransformStep::Op::Remap) {
+            auto previous = state;
+            for (size_t ch = 0; ch < CRSF_MAX_CHANNELS; ch++) {
+                state[ch] = previous[static_cast<size_t>(step.map[ch])];
+            }
+            continue;
+        }
+
+        for (int channel : step.channels) {
+            auto& target = state[static_cast<size_t>(channel)];
+            if (step.op == TransformStep::Op::Override) {
+                target.constant = true;
+                target.value = step.value;
+                target.lut.clear();
+            } else if (target.constant) {
+                target.value = evaluate(step, target.value);
+            } else {
+                if (target.lut.empty()) {
+                    target.lut.resize(LUT_SIZE);
+                    for (size_t v = 0; v < LUT_SIZE; v++) {
+                        target.lut[v] = static_cast<int16_t>(v);
+                    }
+                }
+                for (auto& entry : target.lut) {
+                    entry = evaluate(step, entry);
+                }
+            }
+        }
+    }
+
+    m_luts.clear();
+    m_identity = true;
+    for (size_t ch = 0; ch < CRSF_MAX_CHANNELS; ch++) {
+        const auto& s = state[ch];
+        Instruction& ins = m_program[ch];
+        ins.source = static_cast<uint8_t>(s.source);
+        ins.value = s.value;
+        ins.lut_offset = 0;
+        if (s.constant) {
+            ins.kind = Kind::Constant;
+        } else if (!s.lut.empty()) {
+            ins.kind = Kind::Lookup;
+            ins.lut_offset = static_cast<uint32_t>(m_luts.size());
+            m_luts.insert(m_luts.end(), s.lut.begin(), s.lut.end());
+        } else {
+            ins.kind = Kind::Copy;
+        }
+        m_identity = m_identity && ins.kind == Kind::Copy && ins.source == ch;
+    }
+}
+
+void ChannelTransform::apply(ChannelData& channels) const {
+    if (m_identity) {
+        return;
+    }
+
+    const ChannelData in = channels;
+    const int16_t* luts = m_luts.data();
+    for (size_t ch = 0; ch < CRSF_MAX_CHANNELS; ch++) {
+        const Instruction& ins = m_program[ch];
+        int16_t v = in[ins.source];
+        switch (ins.kind) {
+            case Kind::Copy:
+                channels[ch] = v;
+                break;
+            case Kind::Lookup: {
+                // Histories are validated to the CRSF range; clamp anyway so
+                // a bad value cannot index outside the table
+                size_t index = static_cast<size_t>(
+                    std::min<int>(std::max<int>(v, 0), static_cast<int>(LUT_SIZE) - 1));
+                channels[ch] = luts[ins.lut_offset + index];
+                break;
+            }
+            case Kind::Constant:
+                channels[ch] = ins.value;
+                break;
+        }
+    }
+}
+
+}  // namespace playback
+}  // namespace elrs
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "expresslrs_sender/types.hpp"
+
+namespace elrs {
+namespace playback {
+
+// One step of the channel transform pipeline (config "transforms" entry).
+// Channels are 0-indexed here; the config uses CH1..CH16.
+struct TransformStep {
+    enum class Op {
+        Remap,      // Output channel n takes input channel map[n]
+        Reverse,    // v -> CRSF_CHANNEL_MIN + CRSF_CHANNEL_MAX - v
+        Scale,      // v -> center + (v - center) * scale + offset
+        Expo,       // Expo curve around CRSF_CHANNEL_MID
+        Override    // Constant value
+    };
+
+    Op op = Op::Remap;
+    std::vector<int> channels;                         // Reverse/Scale/Expo/Override
+    std::array<int, CRSF_MAX_CHANNELS> map{};          // Remap
+    double scale = 1.0;
+    double offset = 0.0;
+    double center = CRSF_CHANNEL_MID;
+    double expo = 0.0;                                 // 0 = linear, 1 = cubic
+    int16_t value = CRSF_CHANNEL_MID;                  // Override
+};
+
+using TransformConfig = std::vector<TransformStep>;
+
+// Channel transform pipeline between playback and encoding. compile()
+// folds the steps into one instruction per output channel: a source
+// channel plus a lookup table over the 11-bit range (all value steps of
+// that channel composed), or a constant. apply() runs that flat program:
+// one copy, table lookup or constant per channel, no allocation.
+//
+// Transformed values are clamped to CRSF_CHANNEL_MIN..CRSF_CHANNEL_MAX;
+// channels no step touches pass through unchanged.
+class ChannelTransform {
+public:
+    ChannelTransform();
+
+    // Steps must be valid (checked by config::loadConfig())
+    void compile(const TransformConfig& steps);
+
+    // True when the program is the identity (apply() is a no-op)
+    bool isIdentity() const { return m_identity; }
+
+    void apply(ChannelData& channels) const;
+
+private:
+    static constexpr size_t LUT_SIZE = size_t{1} << CRSF_CHANNEL_BITS;
+
+    enum class Kind : uint8_t {
+        Copy,       // out = in[source]
+        Lookup,     // out = lut[in[source]]
+        Constant    // out = value
+    };
+
+    struct Instruction {
+        Kind kind;
+        uint8_t source;
+        int16_t value;
+        uint32_t lut_offset;        // Into m_luts (offsets keep copies valid)
+    };
+
+    std::array<Instruction, CRSF_MAX_CHANNELS> m_program;
+    std::vector<int16_t> m_luts;    // LUT_SIZE entries per Lookup instruction
+    bool m_identity;
+};
+
+}  // namespace playback
+}  // namespace elrs
@@ -0,0 +1,58 @@
+#include "frame_pipeline.hpp"
+
+namespace elrs {
+namespace playback {
+
+const RcFrame& GenericFramePipeline::process(const ChannelData& channels,
+                                             std::chrono::steady_clock::time_point now,
+                                             ChannelData& safe_channels) {
+    safe_channels = channels;
+    if (m_transform) {
+        m_transform->apply(safe_channels);
+    }
+    m_monitor.processChannels(safe_channels, now);
+
+    if (!m_valid || m_encoded != safe_channels) {
+        m_frame = crsf::buildRcChannelsFrame(safe_channels);
+        m_encoded = safe_channels;
+        m_valid = true;
+    }
+    return m_frame;
+}
+
+namespace {
+
+template <int ArmChannel, int ThrottleChannel>
+std::unique_ptr<FramePipeline> makeSpecialized(safety::SafetyMonitor& monitor,
+                                               const ChannelTransform* transform) {
+    using WithTransform = SpecializedFramePipeline<ArmChannel, ThrottleChannel, true>;
+    using WithoutTransform = SpecializedFramePipeline<ArmChannel, ThrottleChannel, false>;
+    if (transform) {
+        return std::make_unique<WithTransform>(monitor, transform);
+    }
+    return std::make_unique<WithoutTransform>(monitor, nullptr);
+}
+
+}  // namespace
+
+std::unique_ptr<FramePipeline> makeFramePipeline(safety::SafetyMonitor& monitor,
+                                                 const ChannelTransform* transform,
+                                                 bool allow_specialized,
+                                                 bool reloadable) {
+    if (transform && transform->isIdentity() && !reloadable) {
+        transform = nullptr;
+    }
+
+    if (allow_specialized) {
+        switch (monitor.getConfig().arm_channel) {
+            case 4:  // CH5, throttle CH3
+                return makeSpecialized<4, safety::THROTTLE_CHANNEL>(monitor, transform);
+            default:
+                break;
+        }
+    }
+    return std::make_unique<GenericFramePipeline>(monitor, transform);
+}
+
+}  // namespace playback
+}  // namespace elrs
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+#include "crsf/crsf.hpp"
+#include "expresslrs_sender/types.hpp"
+#include "playback/channel_transform.hpp"
+#include "safety/safety_monitor.hpp"
+
+namespace elrs {
+namespace playback {
+
+using RcFrame = std::array<uint8_t, CRSF_RC_FRAME_SIZE>;
+
+// Fixed-layout RC channels frame encoder: the same bytes as
+// crsf::buildRcChannelsFrame(), with the 16 x 11-bit packing written out
+// per byte and the CRC over a constant length, all inlined.
+inline void encodeRcFrame16(const ChannelData& channels, RcFrame& frame) {
+    static_assert(CRSF_MAX_CHANNELS == 16 && CRSF_CHANNEL_BITS == 11,
+                  "fixed packing assumes 16 x 11-bit channels");
+
+    uint16_t v[CRSF_MAX_CHANNELS];
+    for (size_t ch = 0; ch < CRSF_MAX_CHANNELS; ch++) {
+        int16_t value = channels[ch] < CRSF_CHANNEL_MIN ? CRSF_CHANNEL_MIN : channels[ch];
+        v[ch] = static_cast<uint16_t>(value > CRSF_CHANNEL_MAX ? CRSF_CHANNEL_MAX : value);
+    }
+
+    frame[0] = CRSF_SYNC_BYTE;
+    frame[1] = 24;
+    frame[2] = CRSF_FRAME_TYPE_RC_CHANNELS;
+
+    // 8 channels = 88 bits = 11 bytes per group
+    for (size_t group = 0; group < 2; group++) {
+        const uint16_t* c = v + group * 8;
+        uint8_t* out = &frame[3 + group * 11];
+        out[0] = static_cast<uint8_t>(c[0]);
+        out[1] = static_cast<uint8_t>((c[0] >> 8) | (c[1] << 3));
+        out[2] = static_cast<uint8_t>((c[1] >> 5) | (c[2] << 6));
+        out[3] = static_cast<uint8_t>(c[2] >> 2);
+        out[4] = static_cast<uint8_t>((c[2] >> 10) | (c[3] << 1));
+        out[5] = static_cast<uint8_t>((c[3] >> 7) | (c[4] << 4));
+        out[6] = static_cast<uint8_t>((c[4] >> 4) | (c[5] << 7));
+        out[7] = static_cast<uint8_t>(c[5] >> 1);
+        out[8] = static_cast<uint8_t>((c[5] >> 9) | (c[6] << 2));
+        out[9] = static_cast<uint8_t>((c[6] >> 6) | (c[7] << 5));
+        out[10] = static_cast<uint8_t>(c[7] >> 3);
+    }
+
+    uint8_t crc = 0;
+    for (size_t i = 2; i < CRSF_RC_FRAME_SIZE - 1; i++) {
+        crc = crsf::crc8_dvb_s2_table[crc ^ frame[i]];
+    }
+    frame[CRSF_RC_FRAME_SIZE - 1] = crc;
+}
+
+// Per-frame send path after playback: channel transforms, safety shaping,
+// packing and CRC. The frame is re-encoded only when the safe channels
+// change (held keyframes, disarmed padding).
+class FramePipeline {
+public:
+    virtual ~FramePipeline() = default;
+
+    // Run one frame. `safe_channels` receives the channels as sent.
+    virtual const RcFrame& process(const ChannelData& channels,
+                                   std::chrono::steady_clock::time_point now,
+                                   ChannelData& safe_channels) = 0;
+
+    virtual const char* name() const = 0;
+
+    // Replace the transform between frames (config reload). Returns false
+    // if this instantiation has no transform stage and `transform` is not
+    // the identity. The transform must outlive its use.
+    virtual bool setTransform(const ChannelTransform& transform) = 0;
+
+protected:
+    RcFrame m_frame{};
+    ChannelData m_encoded{};
+    bool m_valid = false;
+};
+
+// Runtime-configured path: any arm channel, optional transform,
+// crsf::buildRcChannelsFrame()
+class GenericFramePipeline final : public FramePipeline {
+public:
+    GenericFramePipeline(safety::SafetyMonitor& monitor, const ChannelTransform* transform)
+        : m_monitor(monitor), m_transform(transform) {}
+
+    const RcFrame& process(const ChannelData& channels,
+                           std::chrono::steady_clock::time_point now,
+                           ChannelData& safe_channels) override;
+
+    const char* name() const override { return "generic"; }
+
+    bool setTransform(const ChannelTransform& transform) override {
+        m_transform = transform.isIdentity() ? nullptr : &transform;
+        return true;
+    }
+
+private:
+    safety::SafetyMonitor& m_monitor;
+    const ChannelTransform* m_transform;
+};
+
+// Specialized on the channel layout (0-indexed arm and throttle channels)
+// and on whether a transform runs: the safety step reads the arm switch
+// and overrides the throttle at constant indices
+// (SafetyMonitor::processChannelsFixed), an unused transform is compiled
+// out, and encoding is encodeRcFrame16(). Limits, thresholds and the arm
+// delay stay runtime configuration.
+template <int ArmChannel, int ThrottleChannel, bool HasTransform>
+class SpecializedFramePipeline final : public FramePipeline {
+    static_assert(ArmChannel >= 0 && ArmChannel < static_cast<int>(CRSF_MAX_CHANNELS),
+                  "arm channel out of range");
+    static_assert(ThrottleChannel >= 0 && ThrottleChannel < static_cast<int>(CRSF_MAX_CHANNELS),
+                  "throttle channel out of range");
+
+public:
+    SpecializedFramePipeline(safety::SafetyMonitor& monitor, const ChannelTransform* transform)
+        : m_monitor(monitor)
+        , m_transform(transform) {}
+
+    const RcFrame& process(const ChannelData& channels,
+                           std::chrono::steady_clock::time_point now,
+                           ChannelData& safe_channels) override {
+        safe_channels = channels;
+        if constexpr (HasTransform) {
+            m_transform->apply(safe_channels);
+        }
+        m_monitor.processChannelsFixed<ArmChannel, ThrottleChannel>(safe_channels, now);
+
+        if (!m_valid || m_encoded != safe_channels) {
+            encodeRcFrame16(safe_channels, m_frame);
+            m_encoded = safe_channels;
+            m_valid = true;
+        }
+        return m_frame;
+    }
+
+    const char* name() const override { return "specialized"; }
+
+    bool setTransform(const ChannelTransform& transform) override {
+        if constexpr (HasTransform) {
+            m_transform = &transform;
+            return true;
+        } else {
+            return transform.isIdentity();
+        }
+    }
+
+private:
+    safety::SafetyMonitor& m_monitor;
+    const ChannelTransform* m_transform;
+};
+
+// Pick the specialized instantiation matching the monitor's layout (arm
+// on CH5; throttle is always safety::THROTTLE_CHANNEL) and the transform (nullptr or identity = none), falling
+// back to the generic pipeline. The monitor's arm channel must not change
+// afterwards. With `reloadable` the transform stage is kept even for an
+// identity transform (which must then be non-null) so setTransform() can
+// swap in any transform later.
+std::unique_ptr<FramePipeline> makeFramePipeline(safety::SafetyMonitor& monitor,
+                                                 const ChannelTransform* transform,
+                                                 bool allow_specialized = true,
+                                                 bool reloadable = false);
+
+}  // namespace playback
+}  // namespace elrs
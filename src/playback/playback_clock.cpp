@@ -0,0 +1,110 @@
+#include "playback_clock.hpp"
+
+#include <algorithm>
+
+namespace elrs {
+namespace playback {
+
+PlaybackClock::PlaybackClock()
+    : m_anchor_ms(0)
+    , m_speed(1.0)
+    , m_rate(1.0)
+    , m_paused(false) {
+}
+
+void PlaybackClock::start(time_point now, double position_ms, double speed, bool reverse) {
+    m_anchor_time = now;
+    m_anchor_ms = position_ms;
+    m_speed = speed;
+    m_rate = reverse ? -speed : speed;
+    m_paused = false;
+}
+
+void PlaybackClock::pause(time_point now) {
+    if (m_paused) {
+        return;
+    }
+    m_anchor_ms = position(now);
+    m_anchor_time = now;
+    m_paused = true;
+}
+
+void PlaybackClock::resume(time_point now) {
+    if (!m_paused) {
+        return;
+    }
+    m_anchor_time = now;
+    m_paused = false;
+}
+
+void PlaybackClock::setSpeed(time_point now, double speed) {
+    if (speed <= 0) {
+        return;
+    }
+    m_anchor_ms = position(now);
+    m_anchor_time = now;
+    m_speed = speed;
+    m_rate = isReverse() ? -speed : speed;
+}
+
+void PlaybackClock::seek(time_point now, double position_ms) {
+    m_anchor_ms = position_ms;
+    m_anchor_time = now;
+}
+
+void PlaybackClock::setReverse(time_point now, bool reverse) {
+    if (reverse == isReverse()) {
+        return;
+    }
+    m_anchor_ms = position(now);
+    m_anchor_time = now;
+    m_rate = -m_rate;
+}
+
+double PlaybackClock::position(time_point now) const {
+    if (m_paused) {
+        return m_anchor_ms;
+    }
+    std::chrono::duration<double, std::milli> elapsed = now - m_anchor_time;
+    return m_anchor_ms + elapsed.count() * m_rate;
+}
+
+size_t FrameCursor::seek(const std::vector<uint32_t>& timestamps, uint32_t time_ms) {
+    auto it = std::upper_bound(timestamps.begin(), timestamps.end(), time_ms);
+    m_index = it == timestamps.begin() ? 0
+        : static_cast<size_t>(std::distance(timestamps.begin(), it)) - 1;
+    return m_index;
+}
+
+size_t FrameCursor::advance(const std::vector<uint32_t>& timestamps, uint32_t time_ms) {
+    if (timestamps.empty()) {
+        m_index = 0;
+        return m_index;
+    }
+
+    size_t index = std::min(m_index, timestamps.size() - 1);
+    size_t steps = 0;
+    if (timestamps[index] <= time_ms) {
+        // Forward to the last frame at or before time_ms
+        while (index + 1 < timestamps.size() && timestamps[index + 1] <= time_ms) {
+            if (++steps > MAX_WALK) {
+                return seek(timestamps, time_ms);
+            }
+            index++;
+        }
+    } else {
+        // Backward until the frame is at or before time_ms
+        while (index > 0 && timestamps[index] > time_ms) {
+            if (++steps > MAX_WALK) {
+                return seek(timestamps, time_ms);
+            }
+            index--;
+        }
+    }
+
+    m_index = index;
+    return m_index;
+}
+
+}  // namespace playback
+}  // namespace elrs
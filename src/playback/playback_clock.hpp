@@ -0,0 +1,80 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace elrs {
+namespace playback {
+
+// Maps slot time to history position. The mapping is anchored at the last
+// change (start, pause, resume, speed change, seek):
+//
+//   position(now) = anchor_ms + (now - anchor_time) * speed * direction
+//
+// so every change is O(1) and the position is continuous across it; only
+// seek() moves the position. Reverse playback runs the position backwards.
+// The position is kept in fractional milliseconds so repeated changes do
+// not accumulate rounding.
+class PlaybackClock {
+public:
+    using time_point = std::chrono::steady_clock::time_point;
+
+    PlaybackClock();
+
+    void start(time_point now, double position_ms, double speed, bool reverse = false);
+
+    // Freeze the position at `now` (no-op if already paused)
+    void pause(time_point now);
+    // Continue from the frozen position (no-op if not paused)
+    void resume(time_point now);
+
+    // Change speed (> 0) keeping the current position
+    void setSpeed(time_point now, double speed);
+
+    // Move to `position_ms`; stays paused if paused
+    void seek(time_point now, double position_ms);
+
+    // Change direction keeping the current position
+    void setReverse(time_point now, bool reverse);
+
+    // History position at `now` (the frozen position while paused)
+    double position(time_point now) const;
+
+    bool isPaused() const { return m_paused; }
+    double speed() const { return m_speed; }
+    bool isReverse() const { return m_rate < 0; }
+
+private:
+    time_point m_anchor_time;
+    double m_anchor_ms;
+    double m_speed;
+    double m_rate;      // Signed speed (negative = reverse)
+    bool m_paused;
+};
+
+// Index of the frame at or before a time, for times that move by a few
+// frames per call (normal playback in either direction). advance() walks
+// from the previous index and falls back to a binary search after
+// MAX_WALK frames, so a tick is O(1) amortized and a jump O(log n).
+class FrameCursor {
+public:
+    static constexpr size_t MAX_WALK = 8;
+
+    FrameCursor() : m_index(0) {}
+
+    size_t index() const { return m_index; }
+
+    // Binary search (frame 0 for times before the first frame)
+    size_t seek(const std::vector<uint32_t>& timestamps, uint32_t time_ms);
+
+    // Walk to `time_ms` from the current index
+    size_t advance(const std::vector<uint32_t>& timestamps, uint32_t time_ms);
+
+private:
+    size_t m_index;
+};
+
+}  // namespace playback
+}  // namespace elrs
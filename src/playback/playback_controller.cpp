@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <thread>
 
 namespace elrs {
@@ -10,13 +11,19 @@ namespace playback {
 PlaybackController::PlaybackController()
     : m_state(PlaybackState::Stopped)
     , m_complete(false)
+    , m_first_sent(false)
+    , m_crossfade_ms(0)
     , m_current_index(0)
     , m_playback_time_ms(0)
     , m_loops_done(0)
     , m_frames_sent(0)
     , m_jitter_sum(0)
     , m_jitter_count(0)
-    , m_max_jitter(0) {
+    , m_max_jitter(0)
+    , m_missed_slots(0)
+    , m_latency_histogram(nullptr)
+    , m_decoded_index(SIZE_MAX)
+    , m_channels_changed(false) {
     // Initialize channels to center
     m_current_channels.fill(CRSF_CHANNEL_MID);
 }
@@ -26,7 +33,13 @@ PlaybackController::~PlaybackController() {
 }
 
 void PlaybackController::setFrames(std::vector<HistoryFrame> frames) {
-    m_frames = std::move(frames);
+    m_history = history::ColumnarHistory::fromFrames(frames);
+    m_decoded_index = SIZE_MAX;
+}
+
+void PlaybackController::setHistory(history::ColumnarHistory history) {
+    m_history = std::move(history);
+    m_decoded_index = SIZE_MAX;
 }
 
 void PlaybackController::setOptions(const PlaybackOptions& options) {
@@ -41,32 +54,46 @@ void PlaybackController::setFrameCallback(FrameSendCallback callback) {
     m_callback = std::move(callback);
 }
 
+void PlaybackController::setLatencyHistogram(scheduling::LatencyHistogram* histogram) {
+    m_latency_histogram = histogram;
+}
+
 void PlaybackController::start() {
-    if (m_frames.empty()) {
+    start(std::chrono::steady_clock::now());
+}
+
+void PlaybackController::start(std::chrono::steady_clock::time_point start_time) {
+    if (m_history.empty()) {
         return;
     }
 
     m_state = PlaybackState::Playing;
     m_complete = false;
     m_current_index = 0;
-    m_playback_time_ms = m_options.start_time_ms;
     m_loops_done = 0;
     m_frames_sent = 0;
     m_jitter_sum = 0;
     m_jitter_count = 0;
     m_max_jitter = 0;
+    m_missed_slots = 0;
+    m_first_sent = false;
+    m_crossfade_ms = std::min(m_options.crossfade_ms, getLoopDuration() / 2);
 
-    // Find starting frame
-    m_current_index = findFrameIndex(m_options.start_time_ms);
+    // Find starting frame (reverse playback starts at the end)
+    uint32_t position = m_options.reverse ? getEndTime() : m_options.start_time_ms;
+    m_playback_time_ms = position;
+    m_current_index = m_cursor.seek(m_history.timestamps(), position);
 
-    m_start_time = std::chrono::steady_clock::now();
-    m_last_send_time = m_start_time;
+    m_clock.start(start_time, position, m_options.speed, m_options.reverse);
+    m_session_start = start_time;
+    m_last_send_time = start_time;
 
     updateCurrentChannels();
 }
 
 void PlaybackController::stop() {
     m_state = PlaybackState::Stopped;
+    m_decoded_index = SIZE_MAX;
     m_current_channels.fill(CRSF_CHANNEL_MID);
     // Set throttle to minimum for safety
     m_current_channels[2] = CRSF_CHANNEL_MIN;
@@ -74,17 +101,46 @@ void PlaybackController::stop() {
 
 void PlaybackController::pause() {
     if (m_state == PlaybackState::Playing) {
+        m_clock.pause(std::chrono::steady_clock::now());
         m_state = PlaybackState::Paused;
     }
 }
 
 void PlaybackController::resume() {
     if (m_state == PlaybackState::Paused) {
+        // Slots kept running while paused; the position continues from the pause
+        m_clock.resume(std::chrono::steady_clock::now());
         m_state = PlaybackState::Playing;
-        m_last_send_time = std::chrono::steady_clock::now();
     }
 }
 
+void PlaybackController::seek(uint32_t time_ms) {
+    if (m_history.empty()) {
+        return;
+    }
+    uint32_t end_time = getEndTime();
+    time_ms = std::max(time_ms, m_options.start_time_ms);
+    time_ms = std::min(time_ms, end_time > 0 ? end_time - 1 : 0);
+
+    m_clock.seek(std::chrono::steady_clock::now(), time_ms);
+    m_playback_time_ms = time_ms;
+    m_current_index = m_cursor.seek(m_history.timestamps(), time_ms);
+    updateCurrentChannels();
+}
+
+void PlaybackController::setSpeed(double speed) {
+    if (speed <= 0) {
+        return;
+    }
+    m_clock.setSpeed(std::chrono::steady_clock::now(), speed);
+    m_options.speed = speed;
+}
+
+void PlaybackController::setLoop(bool loop, int loop_count) {
+    m_options.loop = loop;
+    m_options.loop_count = loop_count;
+}
+
 PlaybackState PlaybackController::getState() const {
     return m_state.load();
 }
@@ -95,7 +151,7 @@ PlaybackStats PlaybackController::getStats() const {
     stats.loops_completed = static_cast<uint64_t>(m_loops_done);
 
     auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_start_time);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_session_start);
     stats.elapsed_ms = static_cast<uint32_t>(elapsed.count());
 
     if (stats.elapsed_ms > 0) {
@@ -108,6 +164,14 @@ PlaybackStats PlaybackController::getStats() const {
     }
 
     stats.max_jitter_us = m_max_jitter;
+    stats.missed_slots = m_missed_slots;
+
+    if (m_first_sent) {
+        auto first_slot = m_session_start + m_send_interval;
+        stats.start_error_us = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                m_first_send_time - first_slot).count());
+    }
 
     return stats;
 }
@@ -120,47 +184,39 @@ bool PlaybackController::isComplete() const {
     return m_complete.load();
 }
 
-size_t PlaybackController::findFrameIndex(uint32_t timestamp_ms) const {
-    if (m_frames.empty()) {
-        return 0;
-    }
-
-    // Binary search for the frame at or before timestamp
-    auto it = std::lower_bound(
-        m_frames.begin(), m_frames.end(), timestamp_ms,
-        [](const HistoryFrame& frame, uint32_t ts) {
-            return frame.timestamp_ms < ts;
-        }
-    );
-
-    if (it == m_frames.end()) {
-        return m_frames.size() - 1;
-    }
+std::chrono::steady_clock::time_point PlaybackController::getNextSendTime() const {
+    return m_last_send_time + m_send_interval;
+}
 
-    if (it == m_frames.begin()) {
-        return 0;
+void PlaybackController::updateCurrentChannels() {
+    if (m_current_index >= m_history.size()) {
+        return;
     }
 
-    // Return the frame at or just before the timestamp
-    if (it->timestamp_ms > timestamp_ms) {
-        --it;
+    // Moving forward within a run of identical frames keeps the decoded data
+    if (m_decoded_index < m_history.size() && m_current_index >= m_decoded_index &&
+        m_history.nextChangePoint(m_decoded_index) > m_current_index) {
+        m_decoded_index = m_current_index;
+        m_channels_changed = false;
+        return;
     }
 
-    return static_cast<size_t>(std::distance(m_frames.begin(), it));
+    m_history.readChannels(m_current_index, m_current_channels);
+    m_decoded_index = m_current_index;
+    m_channels_changed = true;
 }
 
-void PlaybackController::updateCurrentChannels() {
-    if (m_current_index < m_frames.size()) {
-        m_current_channels = m_frames[m_current_index].channels;
-    }
+bool PlaybackController::tick() {
+    return tick(std::chrono::steady_clock::now());
 }
 
-bool PlaybackController::tick() {
-    if (m_state != PlaybackState::Playing || m_frames.empty()) {
+bool PlaybackController::tick(std::chrono::steady_clock::time_point now) {
+    PlaybackState state = m_state.load();
+    if ((state != PlaybackState::Playing && state != PlaybackState::Paused) ||
+        m_history.empty()) {
         return false;
     }
 
-    auto now = std::chrono::steady_clock::now();
     auto since_last = std::chrono::duration_cast<std::chrono::microseconds>(now - m_last_send_time);
 
     // Check if it's time to send
@@ -168,6 +224,11 @@ bool PlaybackController::tick() {
         return false;
     }
 
+    if (!m_first_sent) {
+        m_first_send_time = now;
+        m_first_sent = true;
+    }
+
     // Calculate timing jitter
     int64_t jitter = since_last.count() - m_send_interval.count();
     double abs_jitter = std::abs(static_cast<double>(jitter));
@@ -176,33 +237,31 @@ bool PlaybackController::tick() {
     if (abs_jitter > m_max_jitter) {
         m_max_jitter = abs_jitter;
     }
+    if (m_latency_histogram) {
+        m_latency_histogram->record(jitter);
+    }
 
     // Drift correction: advance by exact interval instead of snapping to now
     m_last_send_time += m_send_interval;
     // Snap forward if more than 3 intervals behind (prevent burst sends)
     if (now - m_last_send_time > m_send_interval * 3) {
+        m_missed_slots += static_cast<uint64_t>((now - m_last_send_time) / m_send_interval);
         m_last_send_time = now;
     }
 
-    // Update playback time
-    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_start_time);
-    m_playback_time_ms = m_options.start_time_ms +
-        static_cast<uint32_t>(elapsed.count() * m_options.speed);
-
-    // Account for loops
-    if (m_loops_done > 0) {
-        uint32_t loop_duration = getLoopDuration();
-        m_playback_time_ms = m_options.start_time_ms +
-            ((m_playback_time_ms - m_options.start_time_ms) % loop_duration);
+    // Paused: hold the current frame
+    if (state == PlaybackState::Paused) {
+        m_channels_changed = false;
+        return sendCurrentFrame();
     }
 
-    // Check end condition
-    uint32_t end_time = m_options.end_time_ms;
-    if (end_time == 0 && !m_frames.empty()) {
-        end_time = m_frames.back().timestamp_ms;
-    }
+    // Update playback time
+    double position = m_clock.position(now);
 
-    if (m_playback_time_ms >= end_time) {
+    // Check end condition
+    bool past_end = m_clock.isReverse() ? position <= m_options.start_time_ms
+                                        : position >= getEndTime();
+    if (past_end) {
         // End of playback
         if (m_options.loop) {
             m_loops_done++;
@@ -214,10 +273,7 @@ bool PlaybackController::tick() {
                 return false;
             }
 
-            // Reset for next loop
-            m_playback_time_ms = m_options.start_time_ms;
-            m_current_index = findFrameIndex(m_options.start_time_ms);
-            m_start_time = now;
+            position = wrap(now, position);
         } else {
             m_complete = true;
             m_state = PlaybackState::Stopped;
@@ -226,10 +282,80 @@ bool PlaybackController::tick() {
     }
 
     // Find and update current frame
-    m_current_index = findFrameIndex(m_playback_time_ms);
+    m_playback_time_ms = static_cast<uint32_t>(position);
+    m_current_index = m_cursor.advance(m_history.timestamps(), m_playback_time_ms);
     updateCurrentChannels();
+    if (m_crossfade_ms > 0) {
+        applyCrossfade(position);
+    }
+
+    return sendCurrentFrame();
+}
+
+double PlaybackController::wrap(std::chrono::steady_clock::time_point now, double position) {
+    uint32_t start_time = m_options.start_time_ms;
+    uint32_t end_time = getEndTime();
+    bool reverse = m_clock.isReverse();
+
+    // Carry the overshoot into the next pass so loops do not drift
+    double overshoot = reverse ? start_time - position : position - end_time;
+
+    if (m_options.loop_mode == LoopMode::PingPong) {
+        // Reflect at the end and turn around: no jump, no crossfade needed
+        uint32_t duration = getLoopDuration();
+        overshoot = duration > 0 ? std::fmod(overshoot, duration) : 0.0;
+        position = reverse ? start_time + overshoot : end_time - overshoot;
+        m_clock.seek(now, position);
+        m_clock.setReverse(now, !reverse);
+        return position;
+    }
+
+    // Restart past the part already blended in by the crossfade
+    uint32_t duration = getLoopDuration() - m_crossfade_ms;
+    overshoot = duration > 0 ? std::fmod(overshoot, duration) : 0.0;
+    position = reverse ? end_time - m_crossfade_ms - overshoot
+                       : start_time + m_crossfade_ms + overshoot;
+    m_clock.seek(now, position);
+    return position;
+}
+
+void PlaybackController::applyCrossfade(double position) {
+    if (!m_options.loop || m_options.loop_mode != LoopMode::Restart ||
+        (m_options.loop_count > 0 && m_loops_done + 1 >= m_options.loop_count)) {
+        return;  // No next pass to blend into
+    }
+
+    // How far into the window before the wrap, and the matching position
+    // at the start of the next pass (where wrap() continues at the end)
+    double into;
+    double target;
+    if (m_clock.isReverse()) {
+        into = m_options.start_time_ms + m_crossfade_ms - position;
+        target = getEndTime() - into;
+    } else {
+        into = position - (getEndTime() - m_crossfade_ms);
+        target = m_options.start_time_ms + into;
+    }
+    if (into <= 0) {
+        return;
+    }
+
+    size_t index = m_fade_cursor.advance(m_history.timestamps(), static_cast<uint32_t>(target));
+    m_history.readChannels(index, m_fade_channels);
+
+    double weight = std::min(into / m_crossfade_ms, 1.0);
+    for (size_t i = 0; i < m_current_channels.size(); i++) {
+        double from = m_current_channels[i];
+        m_current_channels[i] = static_cast<int16_t>(
+            std::lround(from + (m_fade_channels[i] - from) * weight));
+    }
 
-    // Send frame via callback
+    // m_current_channels no longer matches a decoded frame
+    m_decoded_index = SIZE_MAX;
+    m_channels_changed = true;
+}
+
+bool PlaybackController::sendCurrentFrame() {
     if (m_callback) {
         if (!m_callback(m_current_channels)) {
             // Callback returned false, stop playback
@@ -243,11 +369,15 @@ bool PlaybackController::tick() {
 }
 
 uint32_t PlaybackController::getLoopDuration() const {
+    return getEndTime() - m_options.start_time_ms;
+}
+
+uint32_t PlaybackController::getEndTime() const {
     uint32_t end_time = m_options.end_time_ms;
-    if (end_time == 0 && !m_frames.empty()) {
-        end_time = m_frames.back().timestamp_ms;
+    if (end_time == 0 && !m_history.empty()) {
+        end_time = m_history.endTimestamp();
     }
-    return end_time - m_options.start_time_ms;
+    return end_time;
 }
 
 }  // namespace playback
@@ -6,19 +6,32 @@
 #include <vector>
 
 #include "expresslrs_sender/types.hpp"
+#include "history/columnar_history.hpp"
+#include "playback/playback_clock.hpp"
+#include "scheduling/latency_histogram.hpp"
 
 namespace elrs {
 namespace playback {
 
+// What happens at the end of the play range when looping
+enum class LoopMode {
+    Restart,        // Jump back to the other end
+    PingPong        // Turn around (each direction counts as one loop)
+};
+
 // Playback options
 struct PlaybackOptions {
     double rate_hz = 500.0;         // Packet send rate
     bool loop = false;              // Loop playback
     int loop_count = 0;             // 0 = infinite
+    LoopMode loop_mode = LoopMode::Restart;
+    bool reverse = false;           // Play from end_time_ms back to start_time_ms
+    uint32_t crossfade_ms = 0;      // Restart loops: blend the last N ms into the first N ms
     uint32_t start_time_ms = 0;     // Start position
     uint32_t end_time_ms = 0;       // End position (0 = end of file)
     double speed = 1.0;             // Playback speed multiplier
     uint32_t arm_delay_ms = 3000;   // Delay before arm allowed
+    bool collapse_duplicates = true; // Load identical consecutive frames as one keyframe
 };
 
 // Playback statistics
@@ -29,6 +42,8 @@ struct PlaybackStats {
     double actual_rate_hz;
     double timing_jitter_us;
     double max_jitter_us;
+    uint64_t missed_slots;      // Slots dropped by snap-forward
+    double start_error_us;      // First frame send time - first slot deadline
 };
 
 // Callback type for frame sending
@@ -39,21 +54,42 @@ public:
     PlaybackController();
     ~PlaybackController();
 
-    // Set frames to play
+    // Set frames to play (converted to columnar storage)
     void setFrames(std::vector<HistoryFrame> frames);
+    void setHistory(history::ColumnarHistory history);
+
+    // Loaded history
+    const history::ColumnarHistory& getHistory() const { return m_history; }
 
     // Set options
     void setOptions(const PlaybackOptions& options);
+    const PlaybackOptions& getOptions() const { return m_options; }
 
     // Set callback for frame sending
     void setFrameCallback(FrameSendCallback callback);
 
+    // Record per-slot wakeup latency into histogram (nullptr = disabled).
+    // The histogram must outlive playback.
+    void setLatencyHistogram(scheduling::LatencyHistogram* histogram);
+
     // Control playback
     void start();
+    // Start with the slot clock anchored at start_time (first slot is one
+    // interval later); used to stagger several ports or schedule a start
+    void start(std::chrono::steady_clock::time_point start_time);
     void stop();
+    // While paused the current frame keeps being sent each slot (holding
+    // position), so the receiver does not failsafe
     void pause();
     void resume();
 
+    // Runtime changes (control socket); take effect at the next slot.
+    // Jump to history time `time_ms`, clamped to the play range
+    void seek(uint32_t time_ms);
+    // Change the speed multiplier (> 0) without moving the position
+    void setSpeed(double speed);
+    void setLoop(bool loop, int loop_count);
+
     // Get state
     PlaybackState getState() const;
     PlaybackStats getStats() const;
@@ -61,15 +97,30 @@ public:
     // Get current frame (for dry-run or monitoring)
     const ChannelData& getCurrentFrame() const;
 
+    // True if the channels of the last processed tick differ from the
+    // previous tick (false while a keyframe is held)
+    bool currentFrameChanged() const { return m_channels_changed; }
+
+    // Slot index of the current tick (counts missed slots), and the
+    // history position it plays; valid inside the frame callback
+    uint64_t getSlotIndex() const { return m_frames_sent + m_missed_slots; }
+    uint32_t getPlaybackTimeMs() const { return m_playback_time_ms; }
+
     // Check if playback is complete
     bool isComplete() const;
 
+    // Deadline of the next send slot (for the caller's sleep strategy)
+    std::chrono::steady_clock::time_point getNextSendTime() const;
+
     // Run one iteration (call in main loop)
     // Returns true if a frame was processed
     bool tick();
+    // Same, with the current time supplied by the caller (offline rendering
+    // drives playback from a virtual clock)
+    bool tick(std::chrono::steady_clock::time_point now);
 
 private:
-    std::vector<HistoryFrame> m_frames;
+    history::ColumnarHistory m_history;
     PlaybackOptions m_options;
     FrameSendCallback m_callback;
 
@@ -77,11 +128,17 @@ private:
     std::atomic<bool> m_complete;
 
     // Timing
-    std::chrono::steady_clock::time_point m_start_time;
+    PlaybackClock m_clock;
+    std::chrono::steady_clock::time_point m_session_start;      // Wall-clock start for stats
     std::chrono::steady_clock::time_point m_last_send_time;
     std::chrono::microseconds m_send_interval;
+    std::chrono::steady_clock::time_point m_first_send_time;
+    bool m_first_sent;
 
     // Position
+    FrameCursor m_cursor;
+    FrameCursor m_fade_cursor;      // Crossfade target
+    uint32_t m_crossfade_ms;        // Effective crossfade (at most half a loop)
     size_t m_current_index;
     uint32_t m_playback_time_ms;
     int m_loops_done;
@@ -91,18 +148,33 @@ private:
     double m_jitter_sum;
     uint64_t m_jitter_count;
     double m_max_jitter;
+    uint64_t m_missed_slots;
+    scheduling::LatencyHistogram* m_latency_histogram;
 
     // Current frame data
     ChannelData m_current_channels;
-
-    // Find frame index for given timestamp
-    size_t findFrameIndex(uint32_t timestamp_ms) const;
+    size_t m_decoded_index;         // frame m_current_channels was decoded from
+    bool m_channels_changed;
+    ChannelData m_fade_channels;
 
     // Update current channels from frame index
     void updateCurrentChannels();
 
     // Get loop duration
     uint32_t getLoopDuration() const;
+
+    // Position after passing the end of the play range (next loop pass)
+    double wrap(std::chrono::steady_clock::time_point now, double position);
+
+    // Blend the start of the next pass into m_current_channels when
+    // `position` is within the crossfade window before the wrap
+    void applyCrossfade(double position);
+
+    // End of the play range
+    uint32_t getEndTime() const;
+
+    // Send m_current_channels through the callback and count the frame
+    bool sendCurrentFrame();
 };
 
 }  // namespace playback
@@ -0,0 +1,225 @@
+#include "raw_stream.hpp"
+
+#include <cstring>
+#include <fstream>
+
+#include "crsf/crsf.hpp"
+#include "playback/frame_pipeline.hpp"
+
+namespace elrs {
+namespace playback {
+
+namespace {
+
+constexpr char MAGIC[4] = {'E', 'L', 'R', 'W'};
+constexpr size_t HEADER_SIZE = 40;
+constexpr size_t INDEX_ENTRY_SIZE = 16;
+
+void putU16(std::vector<uint8_t>& out, uint16_t v) {
+    out.push_back(static_cast<uint8_t>(v));
+    out.push_back(static_cast<uint8_t>(v >> 8));
+}
+
+void putU32(std::vector<uint8_t>& out, uint32_t v) {
+    for (int i = 0; i < 4; i++) {
+        out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+    }
+}
+
+void putU64(std::vector<uint8_t>& out, uint64_t v) {
+    for (int i = 0; i < 8; i++) {
+        out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+    }
+}
+
+uint16_t getU16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t getU32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+        (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint64_t getU64(const uint8_t* p) {
+    return static_cast<uint64_t>(getU32(p)) | (static_cast<uint64_t>(getU32(p + 4)) << 32);
+}
+
+}  // namespace
+
+RawStream renderRawStream(history::ColumnarHistory history,
+                          const PlaybackOptions& options,
+                          const safety::SafetyConfig& safety_config,
+                          uint64_t max_slots,
+                          const ChannelTransform* transform) {
+    RawStream stream;
+    if (history.empty() || options.rate_hz <= 0) {
+        return stream;
+    }
+
+    safety::SafetyMonitor safety_monitor;
+    safety_monitor.setConfig(safety_config);
+
+    // Virtual clock: advanced by exactly one slot per tick, so playback sees
+    // every deadline on time and the output does not depend on the host
+    const std::chrono::steady_clock::time_point origin{};
+    std::chrono::steady_clock::time_point now = origin;
+
+    PlaybackController playback;
+    playback.setHistory(std::move(history));
+    playback.setOptions(options);
+    auto pipeline = makeFramePipeline(safety_monitor, transform);
+    playback.setFrameCallback([&](const ChannelData& channels) -> bool {
+        ChannelData safe_channels;
+        const auto& frame = pipeline->process(channels, now, safe_channels);
+
+        RawSlot slot{};
+        slot.deadline_ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now - origin).count());
+        slot.size = static_cast<uint16_t>(frame.size());
+
+        // Held keyframes reuse the previous slot's bytes
+        if (!stream.slots.empty()) {
+            const RawSlot& prev = stream.slots.back();
+            if (prev.size == frame.size() &&
+                std::memcmp(stream.data.data() + prev.offset, frame.data(), frame.size()) == 0) {
+                slot.offset = prev.offset;
+                stream.slots.push_back(slot);
+                return true;
+            }
+        }
+
+        slot.offset = static_cast<uint32_t>(stream.data.size());
+        stream.data.insert(stream.data.end(), frame.begin(), frame.end());
+        stream.slots.push_back(slot);
+        return true;
+    });
+
+    playback.start(origin);
+    auto interval = playback.getNextSendTime() - origin;
+    stream.interval_ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(interval).count());
+
+    while (playback.getState() == PlaybackState::Playing &&
+           (max_slots == 0 || stream.slots.size() < max_slots)) {
+        now += interval;
+        playback.tick(now);
+    }
+
+    return stream;
+}
+
+std::vector<uint8_t> encodeRawStream(const RawStream& stream) {
+    std::vector<uint8_t> out;
+    out.reserve(HEADER_SIZE + stream.slots.size() * INDEX_ENTRY_SIZE + stream.data.size());
+
+    uint64_t data_offset = HEADER_SIZE + stream.slots.size() * INDEX_ENTRY_SIZE;
+    for (char c : MAGIC) {
+        out.push_back(static_cast<uint8_t>(c));
+    }
+    putU16(out, RAW_STREAM_VERSION);
+    putU16(out, INDEX_ENTRY_SIZE);
+    putU64(out, stream.interval_ns);
+    putU64(out, stream.slots.size());
+    putU64(out, data_offset);
+    putU64(out, stream.data.size());
+
+    for (const auto& slot : stream.slots) {
+        putU64(out, slot.deadline_ns);
+        putU32(out, slot.offset);
+        putU16(out, slot.size);
+        putU16(out, 0);
+    }
+
+    out.insert(out.end(), stream.data.begin(), stream.data.end());
+    return out;
+}
+
+Result<void> saveRawStream(const std::string& filepath, const RawStream& stream) {
+    auto data = encodeRawStream(stream);
+
+    std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return Result<void>::failure(ErrorCode::HistoryError, "Cannot create file: " + filepath);
+    }
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    if (!file) {
+        return Result<void>::failure(ErrorCode::HistoryError, "Write failed: " + filepath);
+    }
+    return Result<void>::success();
+}
+
+RawStreamReader::RawStreamReader()
+    : m_index(nullptr)
+    , m_payload(nullptr)
+    , m_slot_count(0)
+    , m_data_size(0)
+    , m_interval_ns(0) {}
+
+Result<void> RawStreamReader::open(const std::string& filepath) {
+    auto result = m_file.open(filepath);
+    if (!result.ok()) {
+        return result;
+    }
+    return openBuffer(reinterpret_cast<const uint8_t*>(m_file.data()), m_file.size());
+}
+
+Result<void> RawStreamReader::openBuffer(const uint8_t* data, size_t size) {
+    m_slot_count = 0;
+
+    if (size < HEADER_SIZE || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+        return Result<void>::failure(ErrorCode::HistoryError, "Not a raw CRSF stream file");
+    }
+
+    uint16_t version = getU16(data + 4);
+    uint16_t entry_size = getU16(data + 6);
+    if (version != RAW_STREAM_VERSION || entry_size != INDEX_ENTRY_SIZE) {
+        return Result<void>::failure(
+            ErrorCode::HistoryError,
+            "Unsupported raw stream version " + std::to_string(version)
+        );
+    }
+
+    uint64_t interval_ns = getU64(data + 8);
+    uint64_t slot_count = getU64(data + 16);
+    uint64_t data_offset = getU64(data + 24);
+    uint64_t data_size = getU64(data + 32);
+
+    if (slot_count > (size - HEADER_SIZE) / INDEX_ENTRY_SIZE ||
+        data_offset != HEADER_SIZE + slot_count * INDEX_ENTRY_SIZE ||
+        data_offset > size || data_size > size - data_offset) {
+        return Result<void>::failure(ErrorCode::HistoryError, "Corrupt raw stream header");
+    }
+
+    const uint8_t* index = data + HEADER_SIZE;
+    for (uint64_t i = 0; i < slot_count; i++) {
+        const uint8_t* p = index + i * INDEX_ENTRY_SIZE;
+        uint64_t offset = getU32(p + 8);
+        uint64_t frame_size = getU16(p + 12);
+        if (offset + frame_size > data_size) {
+            return Result<void>::failure(
+                ErrorCode::HistoryError,
+                "Corrupt raw stream index at slot " + std::to_string(i)
+            );
+        }
+    }
+
+    m_index = index;
+    m_payload = data + data_offset;
+    m_slot_count = static_cast<size_t>(slot_count);
+    m_data_size = static_cast<size_t>(data_size);
+    m_interval_ns = interval_ns;
+    return Result<void>::success();
+}
+
+double RawStreamReader::rateHz() const {
+    return m_interval_ns > 0 ? 1e9 / static_cast<double>(m_interval_ns) : 0.0;
+}
+
+RawSlot RawStreamReader::slot(size_t index) const {
+    const uint8_t* p = m_index + index * INDEX_ENTRY_SIZE;
+    return RawSlot{getU64(p), getU32(p + 8), getU16(p + 12)};
+}
+
+}  // namespace playback
+}  // namespace elrs
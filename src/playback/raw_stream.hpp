@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "expresslrs_sender/types.hpp"
+#include "history/columnar_history.hpp"
+#include "history/mapped_file.hpp"
+#include "playback/channel_transform.hpp"
+#include "playback/playback_controller.hpp"
+#include "safety/safety_monitor.hpp"
+
+namespace elrs {
+namespace playback {
+
+// Pre-rendered CRSF wire stream (.crsfraw)
+//
+// Layout (little endian):
+//   header  "ELRW", u16 version, u16 index entry size, u64 slot interval ns,
+//           u64 slot count, u64 data offset, u64 data size
+//   index   per slot: u64 deadline ns (from playback start), u32 data
+//           offset, u16 frame size, u16 reserved
+//   data    encoded frames exactly as written to the UART
+//
+// Consecutive slots with identical bytes (held keyframes) share one copy
+// in the data section.
+constexpr uint32_t RAW_STREAM_VERSION = 1;
+
+struct RawSlot {
+    uint64_t deadline_ns;   // Send time relative to playback start
+    uint32_t offset;        // Frame bytes in the data section
+    uint16_t size;
+};
+
+struct RawStream {
+    uint64_t interval_ns = 0;
+    std::vector<RawSlot> slots;
+    std::vector<uint8_t> data;
+};
+
+// Run a history through PlaybackController slot timing, channel
+// transforms, safety shaping and CRSF encoding on a virtual clock. The
+// result depends only on the inputs, so the same history and options
+// always produce the same bytes. max_slots limits the output (0 = until
+// playback completes; required for infinite loops).
+RawStream renderRawStream(history::ColumnarHistory history,
+                          const PlaybackOptions& options,
+                          const safety::SafetyConfig& safety_config,
+                          uint64_t max_slots = 0,
+                          const ChannelTransform* transform = nullptr);
+
+// Encode a stream into the .crsfraw byte layout
+std::vector<uint8_t> encodeRawStream(const RawStream& stream);
+
+// Encode and write a .crsfraw file
+Result<void> saveRawStream(const std::string& filepath, const RawStream& stream);
+
+// Read-only view of a .crsfraw file. All slots are bounds-checked on open,
+// so slotData() can be used from the send loop without further checks.
+class RawStreamReader {
+public:
+    RawStreamReader();
+
+    // Map and validate a .crsfraw file
+    Result<void> open(const std::string& filepath);
+
+    // Read from a caller-owned buffer (must outlive the reader)
+    Result<void> openBuffer(const uint8_t* data, size_t size);
+
+    size_t slotCount() const { return m_slot_count; }
+    uint64_t intervalNs() const { return m_interval_ns; }
+    double rateHz() const;
+    size_t dataSize() const { return m_data_size; }
+
+    RawSlot slot(size_t index) const;
+    const uint8_t* slotData(const RawSlot& slot) const { return m_payload + slot.offset; }
+
+private:
+    history::MappedFile m_file;
+    const uint8_t* m_index;
+    const uint8_t* m_payload;
+    size_t m_slot_count;
+    size_t m_data_size;
+    uint64_t m_interval_ns;
+};
+
+}  // namespace playback
+}  // namespace elrs
@@ -0,0 +1,325 @@
+#include "flight_recorder.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <spdlog/spdlog.h>
+
+#include "safety/safety_monitor.hpp"
+
+namespace elrs {
+namespace recorder {
+
+namespace {
+
+constexpr char MAGIC[4] = {'E', 'L', 'R', 'R'};
+constexpr size_t HEADER_SIZE = 32;
+
+struct FileHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t record_size;
+    uint32_t reserved0;
+    uint64_t record_count;
+    uint64_t dropped;
+};
+static_assert(sizeof(FileHeader) == HEADER_SIZE, "Header layout");
+
+size_t roundUpPowerOfTwo(size_t n) {
+    size_t p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+// Flush thread runs at normal policy with a low nice value so it never
+// competes with the sender, even if created from an RT thread
+void lowerThreadPriority() {
+#ifdef __linux__
+    struct sched_param param{};
+    param.sched_priority = 0;
+    sched_setscheduler(0, SCHED_OTHER, &param);
+    setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 10);
+#endif
+}
+
+const char* safetyStateName(uint8_t state) {
+    switch (static_cast<safety::SafetyState>(state)) {
+        case safety::SafetyState::Disarmed: return "disarmed";
+        case safety::SafetyState::ArmPending: return "arm_pending";
+        case safety::SafetyState::Armed: return "armed";
+        case safety::SafetyState::Failsafe: return "failsafe";
+        case safety::SafetyState::EmergencyStop: return "emergency_stop";
+    }
+    return "unknown";
+}
+
+}  // namespace
+
+FlightRecorder::FlightRecorder()
+    : m_mask(0)
+    , m_head(0)
+    , m_tail(0)
+    , m_dropped(0)
+    , m_running(false)
+    , m_flush_interval_ms(100) {}
+
+FlightRecorder::~FlightRecorder() {
+    close();
+}
+
+Result<void> FlightRecorder::open(const std::string& filepath,
+                                  const FlightRecorderOptions& options) {
+    close();
+
+    m_file.open(filepath, std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open()) {
+        return Result<void>::failure(ErrorCode::GeneralError, "Cannot create file: " + filepath);
+    }
+
+    // Assigning zeroed records touches every page up front
+    size_t capacity = roundUpPowerOfTwo(std::max<size_t>(options.ring_records, 2));
+    m_ring.assign(capacity, FlightRecord{});
+    m_ready.reset(new std::atomic<uint64_t>[capacity]);
+    for (size_t i = 0; i < capacity; i++) {
+        m_ready[i].store(0, std::memory_order_relaxed);
+    }
+    m_mask = capacity - 1;
+    m_head = 0;
+    m_tail = 0;
+    m_dropped = 0;
+    m_flush_interval_ms = std::max<uint32_t>(options.flush_interval_ms, 1);
+
+    writeHeader(0, 0);
+    if (!m_file) {
+        m_file.close();
+        return Result<void>::failure(ErrorCode::GeneralError, "Write failed: " + filepath);
+    }
+
+    m_running = true;
+    m_thread = std::thread(&FlightRecorder::flushLoop, this);
+    spdlog::info("Flight recorder: {} ({} record ring, {} KB)", filepath, capacity,
+        capacity * sizeof(FlightRecord) / 1024);
+    return Result<void>::success();
+}
+
+void FlightRecorder::close() {
+    {
+        std::lock_guard<std::mutex> lock(m_stop_mutex);
+        if (!m_running.exchange(false)) {
+            return;
+        }
+    }
+    m_stop_cv.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    flushPending();
+    writeHeader(m_tail.load(), m_dropped.load());
+    m_file.close();
+
+    if (m_dropped.load() > 0) {
+        spdlog::warn("Flight recorder dropped {} records (ring full)", m_dropped.load());
+    }
+}
+
+bool FlightRecorder::record(const FlightRecord& record) {
+    uint64_t head = m_head.load(std::memory_order_relaxed);
+    do {
+        if (head - m_tail.load(std::memory_order_acquire) > m_mask) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    } while (!m_head.compare_exchange_weak(head, head + 1, std::memory_order_relaxed,
+                                           std::memory_order_relaxed));
+
+    m_ring[head & m_mask] = record;
+    m_ready[head & m_mask].store(head + 1, std::memory_order_release);
+    return true;
+}
+
+void FlightRecorder::flushLoop() {
+    lowerThreadPriority();
+
+    // Polls on an interval so the RT side never has to signal; the
+    // condition variable only shortens the wait on close()
+    std::unique_lock<std::mutex> lock(m_stop_mutex);
+    while (m_running.load()) {
+        m_stop_cv.wait_for(lock, std::chrono::milliseconds(m_flush_interval_ms),
+                           [this] { return !m_running.load(); });
+        lock.unlock();
+        flushPending();
+        lock.lock();
+    }
+}
+
+void FlightRecorder::flushPending() {
+    // Published prefix: a claimed slot still being written ends it
+    uint64_t tail = m_tail.load(std::memory_order_relaxed);
+    uint64_t head = tail;
+    while (m_ready[head & m_mask].load(std::memory_order_acquire) == head + 1) {
+        head++;
+    }
+    if (head == tail) {
+        return;
+    }
+
+    // Up to two contiguous spans (the pending range may wrap)
+    while (tail < head) {
+        size_t start = static_cast<size_t>(tail & m_mask);
+        size_t count = static_cast<size_t>(std::min<uint64_t>(head - tail, m_ring.size() - start));
+        m_file.write(reinterpret_cast<const char*>(&m_ring[start]),
+                     static_cast<std::streamsize>(count * sizeof(FlightRecord)));
+        tail += count;
+    }
+    m_file.flush();
+    m_tail.store(tail, std::memory_order_release);
+}
+
+void FlightRecorder::writeHeader(uint64_t records, uint64_t dropped) {
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FLIGHT_RECORD_VERSION;
+    header.record_size = sizeof(FlightRecord);
+    header.record_count = records;
+    header.dropped = dropped;
+
+    auto pos = m_file.tellp();
+    m_file.seekp(0);
+    m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (pos > 0) {
+        m_file.seekp(pos);
+    }
+    m_file.flush();
+}
+
+Result<void> FlightRecordReader::open(const std::string& filepath) {
+    auto result = m_file.open(filepath);
+    if (!result.ok()) {
+        return result;
+    }
+
+    FileHeader header{};
+    if (m_file.size() < HEADER_SIZE) {
+        return Result<void>::failure(ErrorCode::GeneralError, "Not a flight recorder file");
+    }
+    std::memcpy(&header, m_file.data(), sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        return Result<void>::failure(ErrorCode::GeneralError, "Not a flight recorder file");
+    }
+    if (header.version != FLIGHT_RECORD_VERSION || header.record_size != sizeof(FlightRecord)) {
+        return Result<void>::failure(
+            ErrorCode::GeneralError,
+            "Unsupported flight recorder version " + std::to_string(header.version)
+        );
+    }
+
+    m_records = m_file.data() + HEADER_SIZE;
+    m_count = (m_file.size() - HEADER_SIZE) / sizeof(FlightRecord);
+    m_dropped = header.dropped;
+    return Result<void>::success();
+}
+
+void FlightRecordReader::read(size_t index, FlightRecord& record) const {
+    std::memcpy(&record, m_records + index * sizeof(FlightRecord), sizeof(FlightRecord));
+}
+
+Result<size_t> convertRecordingToCsv(const std::string& record_path,
+                                     const std::string& csv_path,
+                                     bool details) {
+    FlightRecordReader reader;
+    auto open_result = reader.open(record_path);
+    if (!open_result.ok()) {
+        return Result<size_t>::failure(open_result.error, open_result.message);
+    }
+
+    std::ofstream out(csv_path, std::ios::trunc);
+    if (!out.is_open()) {
+        return Result<size_t>::failure(ErrorCode::GeneralError, "Cannot create file: " + csv_path);
+    }
+
+    out << "timestamp_ms";
+    for (size_t ch = 0; ch < CRSF_MAX_CHANNELS; ch++) {
+        out << ",ch" << (ch + 1);
+    }
+    if (details) {
+        out << ",slot,playback_time_ms,safety_state,flags,telemetry";
+    }
+    out << "\n";
+
+    // A history keeps only transmitted slot frames; a dry run (nothing
+    // transmitted) keeps the slot frames it would have sent
+    constexpr uint16_t NOT_SLOT = FLIGHT_RECORD_WATCHDOG | FLIGHT_RECORD_DISARM;
+    FlightRecord record{};
+    bool dry_run = true;
+    for (size_t i = 0; i < reader.size() && dry_run; i++) {
+        reader.read(i, record);
+        dry_run = (record.flags & (NOT_SLOT | FLIGHT_RECORD_NOT_SENT)) != 0;
+    }
+    uint16_t skip = dry_run ? NOT_SLOT : NOT_SLOT | FLIGHT_RECORD_NOT_SENT;
+
+    // Send order, not ring order
+    std::vector<std::pair<uint64_t, size_t>> order;
+    order.reserve(reader.size());
+    for (size_t i = 0; i < reader.size(); i++) {
+        reader.read(i, record);
+        if (details || (record.flags & skip) == 0) {
+            order.emplace_back(record.send_time_ns, i);
+        }
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+    uint64_t first_ns = order.empty() ? 0 : order.front().first;
+    auto timestamp_ms = [first_ns](uint64_t send_ns) {
+        return (send_ns - first_ns + 500000) / 1000000;
+    };
+
+    size_t rows = 0;
+    char hex[3];
+    for (size_t k = 0; k < order.size(); k++) {
+        // Several frames per millisecond (rates above 1kHz): the last one
+        // is what was on the link at the end of that millisecond
+        uint64_t time_ms = timestamp_ms(order[k].first);
+        if (!details && k + 1 < order.size() && timestamp_ms(order[k + 1].first) == time_ms) {
+            continue;
+        }
+        reader.read(order[k].second, record);
+
+        out << time_ms;
+        for (int16_t value : record.channels) {
+            out << ',' << value;
+        }
+        if (details) {
+            out << ',' << record.slot << ',' << record.playback_time_ms << ','
+                << safetyStateName(record.safety_state) << ',' << record.flags << ',';
+            size_t n = std::min<size_t>(record.telemetry_size, FLIGHT_RECORD_TELEMETRY_BYTES);
+            for (size_t b = 0; b < n; b++) {
+                std::snprintf(hex, sizeof(hex), "%02x", record.telemetry[b]);
+                out << hex;
+            }
+        }
+        out << "\n";
+        rows++;
+    }
+
+    if (!out) {
+        return Result<size_t>::failure(ErrorCode::GeneralError, "Write failed: " + csv_path);
+    }
+    return Result<size_t>::success(rows);
+}
+
+}  // namespace recorder
+}  // namespace elrs
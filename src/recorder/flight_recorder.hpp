@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "expresslrs_sender/types.hpp"
+#include "history/mapped_file.hpp"
+
+namespace elrs {
+namespace recorder {
+
+// Flight recorder file (.elrsrec)
+//
+// Layout (host byte order, little endian on all supported targets):
+//   header  "ELRR", u16 version, u16 record size, u32 reserved,
+//           u64 record count, u64 dropped records
+//   records FlightRecord, back to back
+//
+// The counts in the header are written on close(); readers derive the
+// record count from the file size so a file cut short by a crash is still
+// readable up to the last flushed record.
+constexpr uint32_t FLIGHT_RECORD_VERSION = 1;
+constexpr size_t FLIGHT_RECORD_TELEMETRY_BYTES = 72;
+
+// FlightRecord::flags
+constexpr uint16_t FLIGHT_RECORD_NOT_SENT = 0x0001;            // dry-run or write failed
+constexpr uint16_t FLIGHT_RECORD_TELEMETRY_TRUNCATED = 0x0002; // more telemetry than captured
+constexpr uint16_t FLIGHT_RECORD_WATCHDOG = 0x0004;            // failsafe frame from the watchdog (no slot)
+constexpr uint16_t FLIGHT_RECORD_DISARM = 0x0008;              // emergency disarm frame (no slot)
+
+// One transmitted frame
+struct FlightRecord {
+    uint64_t send_time_ns;          // steady_clock time of the UART write
+    uint64_t slot;                  // Playback slot index (gaps = missed slots)
+    uint32_t playback_time_ms;      // History position of the frame
+    uint8_t safety_state;           // safety::SafetyState after processing
+    uint8_t telemetry_size;         // Valid bytes in telemetry
+    uint16_t flags;
+    ChannelData channels;           // Channels as sent (after safety overrides)
+    uint8_t telemetry[FLIGHT_RECORD_TELEMETRY_BYTES];  // Bytes drained after the write
+};
+static_assert(sizeof(FlightRecord) == 128, "FlightRecord is part of the file format");
+
+// Recorder options (config "recorder" section)
+struct FlightRecorderOptions {
+    size_t ring_records = 65536;    // Ring capacity (rounded up to a power of two)
+    uint32_t flush_interval_ms = 100;
+};
+
+// Records frames from the RT threads into a preallocated ring; a
+// low-priority thread writes them to disk. record() never allocates,
+// blocks or makes system calls; when the ring is full the record is
+// dropped and counted instead. Several threads may record (the sender and
+// the failsafe watchdog): a slot is claimed with a CAS and published with
+// a per-slot sequence, so a producer never waits for another one and the
+// flush thread only writes the published prefix.
+class FlightRecorder {
+public:
+    FlightRecorder();
+    ~FlightRecorder();
+
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    // Allocate and prefault the ring, create the file and start the flush
+    // thread. Call before RT placement so the thread does not inherit it.
+    Result<void> open(const std::string& filepath, const FlightRecorderOptions& options = {});
+
+    // Stop the flush thread, write remaining records and finalize the header
+    void close();
+
+    bool isOpen() const { return m_running.load(); }
+
+    // RT side, any thread: append one record (false = ring full, dropped)
+    bool record(const FlightRecord& record);
+
+    uint64_t recorded() const { return m_head.load(std::memory_order_relaxed); }
+    uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+    uint64_t flushed() const { return m_tail.load(std::memory_order_relaxed); }
+
+private:
+    std::vector<FlightRecord> m_ring;
+    size_t m_mask;
+    std::unique_ptr<std::atomic<uint64_t>[]> m_ready;  // Position + 1 once slot is written
+    std::atomic<uint64_t> m_head;      // Next position to claim (record())
+    std::atomic<uint64_t> m_tail;      // Written by the flush thread
+    std::atomic<uint64_t> m_dropped;
+    std::atomic<bool> m_running;
+    uint32_t m_flush_interval_ms;
+    std::ofstream m_file;
+    std::thread m_thread;
+    std::mutex m_stop_mutex;
+    std::condition_variable m_stop_cv;  // Wakes the flush thread on close()
+
+    void flushLoop();
+    void flushPending();
+    void writeHeader(uint64_t records, uint64_t dropped);
+};
+
+// Read-only view of a .elrsrec file
+class FlightRecordReader {
+public:
+    Result<void> open(const std::string& filepath);
+
+    size_t size() const { return m_count; }
+    uint64_t dropped() const { return m_dropped; }
+
+    // Copy out record `index` (< size())
+    void read(size_t index, FlightRecord& record) const;
+
+private:
+    history::MappedFile m_file;
+    const char* m_records = nullptr;
+    size_t m_count = 0;
+    uint64_t m_dropped = 0;
+};
+
+// Convert a recording into a history CSV (timestamp_ms relative to the
+// earliest send, rounded to 1ms, ch1..ch16 as sent), ordered by send time
+// (the watchdog may claim ring slots ahead of a sender blocked in write).
+// Only slot frames that were actually written are kept (all slot frames
+// for a dry-run recording), and of frames sharing a millisecond the last
+// one, so the output is a valid history.
+// With details, every record is written and slot, playback time, safety
+// state, flags and telemetry (hex) columns are appended; such a file is
+// for analysis and is not loadable as a history.
+// Returns the number of rows written.
+Result<size_t> convertRecordingToCsv(const std::string& record_path,
+                                     const std::string& csv_path,
+                                     bool details = false);
+
+}  // namespace recorder
+}  // namespace elrs
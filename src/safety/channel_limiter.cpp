@@ -0,0 +1,191 @@
+#include "channel_limiter.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace elrs {
+namespace safety {
+
+static_assert(CRSF_MAX_CHANNELS == 16, "limiter assumes two 8-lane vectors");
+
+ChannelLimiter::ChannelLimiter()
+    : m_enabled(false)
+    , m_has_previous(false)
+    , m_previous{} {
+    setLimits(ChannelLimits{});
+}
+
+void ChannelLimiter::setLimits(const ChannelLimits& limits) {
+    bool was_enabled = m_enabled;
+    m_enabled = false;
+    for (size_t ch = 0; ch < CRSF_MAX_CHANNELS; ch++) {
+        m_min[ch] = limits[ch].min;
+        m_max[ch] = limits[ch].max;
+        m_rate[ch] = limits[ch].max_delta_per_ms;
+        m_deadband[ch] = std::max<int16_t>(limits[ch].deadband, 0);
+        m_enabled = m_enabled || limits[ch].active();
+    }
+    // The last committed output stays the reference, so limits changed
+    // mid-stream (config reload) cannot let a channel jump. Nothing was
+    // committed while disabled.
+    m_step.fill(INT16_MAX);
+    if (!was_enabled) {
+        m_has_previous = false;
+    }
+}
+
+void ChannelLimiter::apply(ChannelData& channels, std::chrono::steady_clock::time_point now) {
+    if (!m_enabled) {
+        return;
+    }
+
+    if (m_has_previous) {
+        float elapsed_ms = std::chrono::duration<float, std::milli>(now - m_previous_time).count();
+        for (size_t ch = 0; ch < CRSF_MAX_CHANNELS; ch++) {
+            // At least one unit per frame so a limited channel always converges
+            float step = std::min(std::max(m_rate[ch] * elapsed_ms, 1.0f), 32767.0f);
+            m_step[ch] = m_rate[ch] > 0 ? static_cast<int16_t>(step) : INT16_MAX;
+        }
+    }
+
+    uint32_t range = 0;
+    uint32_t deadband = 0;
+    uint32_t slew = 0;
+    limit(channels, range, deadband, slew);
+    count(m_stats.range, range);
+    count(m_stats.deadband, deadband);
+    count(m_stats.slew, slew);
+}
+
+void ChannelLimiter::commit(const ChannelData& channels,
+                            std::chrono::steady_clock::time_point now) {
+    if (!m_enabled) {
+        return;
+    }
+    m_previous = channels;
+    m_previous_time = now;
+    m_has_previous = true;
+}
+
+void ChannelLimiter::count(std::array<uint64_t, CRSF_MAX_CHANNELS>& counters, uint32_t mask) {
+    while (mask != 0) {
+        counters[static_cast<size_t>(__builtin_ctz(mask))]++;
+        mask &= mask - 1;
+    }
+}
+
+void ChannelLimiter::limit(ChannelData& channels, uint32_t& range, uint32_t& deadband,
+                           uint32_t& slew) const {
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(-1);
+    __m128i range_mask[2], deadband_mask[2], slew_mask[2];
+
+    for (int half = 0; half < 2; half++) {
+        const size_t base = static_cast<size_t>(half) * 8;
+        auto load = [base](const int16_t* p) {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + base));
+        };
+
+        __m128i in = load(channels.data());
+        __m128i out = _mm_min_epi16(_mm_max_epi16(in, load(m_min.data())), load(m_max.data()));
+        range_mask[half] = _mm_xor_si128(_mm_cmpeq_epi16(in, out), ones);
+        deadband_mask[half] = zero;
+        slew_mask[half] = zero;
+
+        if (m_has_previous) {
+            __m128i prev = load(m_previous.data());
+            __m128i delta = _mm_subs_epi16(out, prev);
+            __m128i magnitude = _mm_max_epi16(delta, _mm_subs_epi16(zero, delta));
+
+            // Hold the previous output for small non-zero changes
+            __m128i held = _mm_andnot_si128(
+                _mm_or_si128(_mm_cmpgt_epi16(magnitude, load(m_deadband.data())),
+                             _mm_cmpeq_epi16(delta, zero)),
+                ones);
+            delta = _mm_andnot_si128(held, delta);
+
+            __m128i step = load(m_step.data());
+            __m128i limited = _mm_min_epi16(_mm_max_epi16(delta, _mm_subs_epi16(zero, step)), step);
+            slew_mask[half] = _mm_xor_si128(_mm_cmpeq_epi16(limited, delta), ones);
+            deadband_mask[half] = held;
+            out = _mm_adds_epi16(prev, limited);
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(channels.data() + base), out);
+    }
+
+    // 0/-1 lanes pack to 0/-1 bytes in channel order
+    auto bits = [](const __m128i* mask) {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(mask[0], mask[1])));
+    };
+    range = bits(range_mask);
+    deadband = bits(deadband_mask);
+    slew = bits(slew_mask);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    static const uint16_t weights[8] = {1, 2, 4, 8, 16, 32, 64, 128};
+    const uint16x8_t w = vld1q_u16(weights);
+    const int16x8_t zero = vdupq_n_s16(0);
+    range = deadband = slew = 0;
+
+    for (int half = 0; half < 2; half++) {
+        const size_t base = static_cast<size_t>(half) * 8;
+        auto bits = [&w, half](uint16x8_t mask) {
+            return static_cast<uint32_t>(vaddvq_u16(vandq_u16(mask, w))) << (half * 8);
+        };
+
+        int16x8_t in = vld1q_s16(channels.data() + base);
+        int16x8_t out = vminq_s16(vmaxq_s16(in, vld1q_s16(m_min.data() + base)),
+                                  vld1q_s16(m_max.data() + base));
+        range |= bits(vmvnq_u16(vceqq_s16(in, out)));
+
+        if (m_has_previous) {
+            int16x8_t prev = vld1q_s16(m_previous.data() + base);
+            int16x8_t delta = vqsubq_s16(out, prev);
+
+            // Hold the previous output for small non-zero changes
+            uint16x8_t held = vbicq_u16(
+                vcleq_s16(vqabsq_s16(delta), vld1q_s16(m_deadband.data() + base)),
+                vceqq_s16(delta, zero));
+            delta = vbslq_s16(held, zero, delta);
+
+            int16x8_t step = vld1q_s16(m_step.data() + base);
+            int16x8_t limited = vminq_s16(vmaxq_s16(delta, vnegq_s16(step)), step);
+            slew |= bits(vmvnq_u16(vceqq_s16(limited, delta)));
+            deadband |= bits(held);
+            out = vqaddq_s16(prev, limited);
+        }
+
+        vst1q_s16(channels.data() + base, out);
+    }
+#else
+    range = deadband = slew = 0;
+    for (size_t ch = 0; ch < CRSF_MAX_CHANNELS; ch++) {
+        int32_t in = channels[ch];
+        int32_t out = std::min<int32_t>(std::max<int32_t>(in, m_min[ch]), m_max[ch]);
+        range |= static_cast<uint32_t>(out != in) << ch;
+
+        if (m_has_previous) {
+            int32_t prev = m_previous[ch];
+            int32_t delta = out - prev;
+            bool held = delta != 0 && std::abs(delta) <= m_deadband[ch];
+            delta = held ? 0 : delta;
+            int32_t limited = std::min<int32_t>(std::max<int32_t>(delta, -m_step[ch]), m_step[ch]);
+            slew |= static_cast<uint32_t>(limited != delta) << ch;
+            deadband |= static_cast<uint32_t>(held) << ch;
+            out = prev + limited;
+        }
+
+        channels[ch] = static_cast<int16_t>(out);
+    }
+#endif
+}
+
+}  // namespace safety
+}  // namespace elrs
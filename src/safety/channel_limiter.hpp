@@ -0,0 +1,74 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+#include "expresslrs_sender/types.hpp"
+
+namespace elrs {
+namespace safety {
+
+// Limits for one channel (config "safety.limits" entry). The defaults
+// leave the channel untouched.
+struct ChannelLimit {
+    int16_t min = INT16_MIN;          // Output range
+    int16_t max = INT16_MAX;
+    float max_delta_per_ms = 0;       // Slew rate limit (0 = unlimited)
+    int16_t deadband = 0;             // Changes up to this size are held
+
+    bool active() const {
+        return min != INT16_MIN || max != INT16_MAX || max_delta_per_ms > 0 || deadband > 0;
+    }
+};
+
+using ChannelLimits = std::array<ChannelLimit, CRSF_MAX_CHANNELS>;
+
+// Per-channel trigger counts (frames in which each limit changed the value)
+struct LimiterStats {
+    std::array<uint64_t, CRSF_MAX_CHANNELS> range{};
+    std::array<uint64_t, CRSF_MAX_CHANNELS> slew{};
+    std::array<uint64_t, CRSF_MAX_CHANNELS> deadband{};
+};
+
+// Range clamp, deadband and slew-rate limit over all 16 channels at once
+// (SSE2 / AArch64 NEON, scalar otherwise). Stages run in that order; the
+// deadband and slew limit are relative to the previous output passed to
+// commit(). Keeps per-stream state: one caller at a time.
+class ChannelLimiter {
+public:
+    ChannelLimiter();
+
+    void setLimits(const ChannelLimits& limits);
+    bool enabled() const { return m_enabled; }
+
+    // Limit channels in place; `now` sets the slew budget since the last
+    // commit(). No slew or deadband before the first commit().
+    void apply(ChannelData& channels, std::chrono::steady_clock::time_point now);
+
+    // Record the value actually sent (after safety overrides) as the
+    // reference for the next frame
+    void commit(const ChannelData& channels, std::chrono::steady_clock::time_point now);
+
+    // Forget the previous output (next frame is range-limited only)
+    void reset() { m_has_previous = false; }
+
+    const LimiterStats& getStats() const { return m_stats; }
+
+private:
+    bool m_enabled;
+    bool m_has_previous;
+    std::array<float, CRSF_MAX_CHANNELS> m_rate;
+    std::array<int16_t, CRSF_MAX_CHANNELS> m_min, m_max, m_deadband;
+    std::array<int16_t, CRSF_MAX_CHANNELS> m_step;   // Slew budget of this frame
+    ChannelData m_previous;
+    std::chrono::steady_clock::time_point m_previous_time;
+    LimiterStats m_stats;
+
+    // Returns trigger bitmasks (bit n = channel n+1)
+    void limit(ChannelData& channels, uint32_t& range, uint32_t& deadband, uint32_t& slew) const;
+    static void count(std::array<uint64_t, CRSF_MAX_CHANNELS>& counters, uint32_t mask);
+};
+
+}  // namespace safety
+}  // namespace elrs
@@ -0,0 +1,230 @@
+#include "failsafe_watchdog.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/timerfd.h>
+#endif
+
+#include <spdlog/spdlog.h>
+
+#include "crsf/crsf.hpp"
+
+namespace elrs {
+namespace safety {
+
+FailsafeWatchdog::FailsafeWatchdog()
+    : m_monitor(nullptr)
+    , m_timeout_ms(500)
+    , m_fd(-1)
+    , m_timer_fd(-1)
+    , m_recorder(nullptr)
+    , m_failsafe_channels{}
+    , m_failsafe_frame{}
+    , m_heartbeat(0)
+    , m_sender_done(false)
+    , m_taken_over(false)
+    , m_running(false)
+    , m_takeovers(0)
+    , m_failsafe_frames(0)
+    , m_max_stall_ms(0) {}
+
+FailsafeWatchdog::~FailsafeWatchdog() {
+    stop();
+}
+
+Result<void> FailsafeWatchdog::start(SafetyMonitor& monitor, const std::string& device,
+                                     const WatchdogOptions& options,
+                                     recorder::FlightRecorder* recorder) {
+    stop();
+
+    m_monitor = &monitor;
+    m_recorder = recorder;
+    m_options = options;
+    if (m_options.interval_ms == 0) {
+        m_options.interval_ms = 1;
+    }
+    m_timeout_ms = monitor.getConfig().failsafe_timeout_ms;
+    m_failsafe_channels = monitor.getFailsafeChannels();
+    m_failsafe_frame = crsf::buildRcChannelsFrame(m_failsafe_channels);
+    m_heartbeat = 0;
+    m_sender_done = false;
+    m_taken_over = false;
+    m_takeovers = 0;
+    m_failsafe_frames = 0;
+    m_max_stall_ms = 0;
+
+    // Separate open file description: O_NONBLOCK here does not affect the
+    // sender's descriptor, and a full or wedged port never blocks us
+    if (!device.empty()) {
+        m_fd = ::open(device.c_str(), O_WRONLY | O_NOCTTY | O_NONBLOCK);
+        if (m_fd < 0) {
+            return Result<void>::failure(
+                ErrorCode::DeviceError,
+                "Watchdog cannot open " + device + ": " + strerror(errno)
+            );
+        }
+    }
+
+#ifdef __linux__
+    m_timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (m_timer_fd < 0) {
+        int err = errno;
+        stop();
+        return Result<void>::failure(
+            ErrorCode::GeneralError,
+            std::string("Watchdog timerfd_create failed: ") + strerror(err)
+        );
+    }
+    struct itimerspec spec{};
+    spec.it_interval.tv_sec = m_options.interval_ms / 1000;
+    spec.it_interval.tv_nsec = static_cast<long>(m_options.interval_ms % 1000) * 1000000L;
+    spec.it_value = spec.it_interval;
+    timerfd_settime(m_timer_fd, 0, &spec, nullptr);
+#endif
+
+    m_running = true;
+    m_thread = std::thread(&FailsafeWatchdog::run, this);
+    spdlog::info("Failsafe watchdog: timeout {}ms, check every {}ms{}", m_timeout_ms.load(),
+        m_options.interval_ms, m_fd < 0 ? " (no device)" : "");
+    return Result<void>::success();
+}
+
+void FailsafeWatchdog::stop() {
+    // The thread may already have exited on its own (timer failure)
+    m_running = false;
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    if (m_timer_fd >= 0) {
+        ::close(m_timer_fd);
+        m_timer_fd = -1;
+    }
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+    m_taken_over = false;
+}
+
+WatchdogStats FailsafeWatchdog::getStats() const {
+    WatchdogStats stats;
+    stats.takeovers = m_takeovers.load();
+    stats.failsafe_frames = m_failsafe_frames.load();
+    stats.max_stall_ms = m_max_stall_ms.load();
+    return stats;
+}
+
+bool FailsafeWatchdog::waitTick() {
+#ifdef __linux__
+    uint64_t expirations = 0;
+    ssize_t n = ::read(m_timer_fd, &expirations, sizeof(expirations));
+    return n == sizeof(expirations) || errno == EINTR;
+#else
+    std::this_thread::sleep_for(std::chrono::milliseconds(m_options.interval_ms));
+    return true;
+#endif
+}
+
+void FailsafeWatchdog::run() {
+#ifdef __linux__
+    // Above the sender so a spinning or wedged sender cannot starve us
+    struct sched_param param{};
+    param.sched_priority = m_options.priority;
+    if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0) {
+        spdlog::debug("Watchdog running without SCHED_FIFO (insufficient privileges)");
+    }
+#endif
+
+    uint64_t last_count = m_heartbeat.load(std::memory_order_acquire);
+    auto last_change = std::chrono::steady_clock::now();
+
+    while (m_running.load()) {
+        if (!waitTick()) {
+            // Never leave the sender muted with nobody writing failsafe frames
+            int err = errno;
+            m_taken_over.store(false, std::memory_order_release);
+            m_running.store(false);
+            spdlog::error("Watchdog: timer wait failed ({}), watchdog stopped", strerror(err));
+            return;
+        }
+
+        // A finished sender is silent, not stalled
+        if (m_sender_done.load(std::memory_order_acquire)) {
+            m_taken_over.store(false, std::memory_order_release);
+            continue;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        uint64_t count = m_heartbeat.load(std::memory_order_acquire);
+        auto stalled_ms = static_cast<uint32_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(now - last_change).count());
+
+        if (count != last_count) {
+            // Sender is alive again: hand the port back. Its safety monitor
+            // is in failsafe and recovers to disarmed on its next frame.
+            if (m_taken_over.load()) {
+                m_taken_over.store(false, std::memory_order_release);
+                spdlog::warn("Watchdog: sender resumed after {}ms, returning port", stalled_ms);
+            }
+            last_count = count;
+            last_change = now;
+            continue;
+        }
+
+        // No slot sent yet (e.g. waiting for a scheduled start)
+        if (count == 0) {
+            last_change = now;
+            continue;
+        }
+
+        if (stalled_ms > m_max_stall_ms.load()) {
+            m_max_stall_ms.store(stalled_ms);
+        }
+        if (stalled_ms < m_timeout_ms.load(std::memory_order_relaxed)) {
+            continue;
+        }
+
+        bool first = !m_taken_over.exchange(true, std::memory_order_acq_rel);
+        if (first) {
+            m_monitor->triggerFailsafe();
+        }
+        bool sent = false;
+        auto send_time = std::chrono::steady_clock::now();
+        if (m_fd >= 0) {
+            ssize_t written = ::write(m_fd, m_failsafe_frame.data(), m_failsafe_frame.size());
+            if (written == static_cast<ssize_t>(m_failsafe_frame.size())) {
+                m_failsafe_frames.fetch_add(1);
+                sent = true;
+            }
+        }
+        if (m_recorder) {
+            // No slot: the sender owns the slot clock and is stalled
+            recorder::FlightRecord record{};
+            record.send_time_ns = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    send_time.time_since_epoch()).count());
+            record.safety_state = static_cast<uint8_t>(m_monitor->getState());
+            record.flags = recorder::FLIGHT_RECORD_WATCHDOG;
+            if (!sent) {
+                record.flags |= recorder::FLIGHT_RECORD_NOT_SENT;
+            }
+            record.channels = m_failsafe_channels;
+            m_recorder->record(record);
+        }
+        if (first) {
+            m_takeovers.fetch_add(1);
+            spdlog::error("Watchdog: sender stalled for {}ms, sending failsafe frames", stalled_ms);
+        }
+    }
+}
+
+}  // namespace safety
+}  // namespace elrs
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include "expresslrs_sender/types.hpp"
+#include "recorder/flight_recorder.hpp"
+#include "safety/safety_monitor.hpp"
+
+namespace elrs {
+namespace safety {
+
+// Failsafe watchdog options (config "safety.watchdog" section).
+// The stall timeout is SafetyConfig::failsafe_timeout_ms.
+struct WatchdogOptions {
+    bool enabled = true;
+    uint32_t interval_ms = 10;   // timerfd period: stall check and failsafe frame rate
+    int priority = 60;           // SCHED_FIFO priority (above the sender's)
+};
+
+// Watchdog counters
+struct WatchdogStats {
+    uint64_t takeovers = 0;          // Times the sender was declared stalled
+    uint64_t failsafe_frames = 0;    // Frames written by the watchdog
+    uint32_t max_stall_ms = 0;       // Longest observed gap between heartbeats
+};
+
+// Independent failsafe watchdog. The sender bumps a heartbeat counter each
+// slot; a separate thread driven by its own timer checks it. When the
+// sender stalls for failsafe_timeout_ms, the watchdog takes the port over
+// and writes pre-encoded failsafe frames through its own non-blocking
+// descriptor until the heartbeat resumes, then hands the port back.
+//
+// Ownership handoff is a single atomic: the sender checks
+// senderOwnsPort() before each write and never waits on the watchdog.
+// A frame the sender had already started is completed by the tty layer
+// before the watchdog's frame, so frames do not interleave.
+class FailsafeWatchdog {
+public:
+    FailsafeWatchdog();
+    ~FailsafeWatchdog();
+
+    FailsafeWatchdog(const FailsafeWatchdog&) = delete;
+    FailsafeWatchdog& operator=(const FailsafeWatchdog&) = delete;
+
+    // Start the watchdog thread. device is opened a second time for the
+    // failsafe writes (empty = detect and report only, e.g. dry-run).
+    // With a recorder, each takeover frame is recorded with
+    // FLIGHT_RECORD_WATCHDOG; the recorder must outlive the watchdog.
+    Result<void> start(SafetyMonitor& monitor, const std::string& device,
+                       const WatchdogOptions& options,
+                       recorder::FlightRecorder* recorder = nullptr);
+
+    // Stop the thread and close the descriptor (ownership returns to the sender)
+    void stop();
+
+    // False after stop() or if the thread exited on a timer error
+    bool isRunning() const { return m_running.load(); }
+
+    // Sender side: call once per slot. Lock-free, no system calls.
+    void heartbeat() { m_heartbeat.fetch_add(1, std::memory_order_release); }
+
+    // Sender side: playback is over. The heartbeat stops for good, so the
+    // watchdog hands the port back and no longer treats silence as a stall.
+    void senderDone() { m_sender_done.store(true, std::memory_order_release); }
+
+    // Change the stall timeout while running (config reload). Lock-free.
+    void setTimeout(uint32_t timeout_ms) {
+        m_timeout_ms.store(timeout_ms, std::memory_order_relaxed);
+    }
+
+    // Sender side: false while the watchdog owns the port
+    bool senderOwnsPort() const { return !m_taken_over.load(std::memory_order_acquire); }
+
+    WatchdogStats getStats() const;
+
+private:
+    SafetyMonitor* m_monitor;
+    WatchdogOptions m_options;
+    std::atomic<uint32_t> m_timeout_ms;
+    int m_fd;
+    int m_timer_fd;
+    recorder::FlightRecorder* m_recorder;
+    ChannelData m_failsafe_channels;
+    std::array<uint8_t, CRSF_RC_FRAME_SIZE> m_failsafe_frame;
+
+    std::atomic<uint64_t> m_heartbeat;
+    std::atomic<bool> m_sender_done;
+    std::atomic<bool> m_taken_over;
+    std::atomic<bool> m_running;
+    std::thread m_thread;
+
+    std::atomic<uint64_t> m_takeovers;
+    std::atomic<uint64_t> m_failsafe_frames;
+    std::atomic<uint32_t> m_max_stall_ms;
+
+    void run();
+    bool waitTick();
+};
+
+}  // namespace safety
+}  // namespace elrs
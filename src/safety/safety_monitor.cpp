@@ -1,9 +1,21 @@
 #include "safety_monitor.hpp"
 
+#include <cerrno>
 #include <csignal>
 #include <cstring>
+#include <thread>
+
+#include <fcntl.h>
 #include <unistd.h>
 
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <time.h>
+#else
+#include <sys/select.h>
+#endif
+
 #include <spdlog/spdlog.h>
 
 namespace elrs {
@@ -11,12 +23,86 @@ namespace safety {
 
 std::atomic<SafetyMonitor*> SafetyMonitor::s_instance{nullptr};
 std::atomic<bool> SafetyMonitor::s_shutdown_requested{false};
+std::atomic<int64_t> SafetyMonitor::s_shutdown_signal_ns{0};
+int SafetyMonitor::s_wake_read_fd = -1;
+int SafetyMonitor::s_wake_write_fd = -1;
+
+namespace {
+
+// Unpacked SafetyMonitor state word (see the layout in the header)
+constexpr unsigned TICK_BITS = 30;
+constexpr uint32_t TICK_MASK = (1u << TICK_BITS) - 1;
+constexpr unsigned LAST_FRAME_SHIFT = 4;
+constexpr unsigned ARM_REQUEST_SHIFT = LAST_FRAME_SHIFT + TICK_BITS;
+
+struct StateWord {
+    SafetyState state;
+    uint32_t last_frame_tick;
+    uint32_t arm_request_tick;
+};
+
+uint64_t packWord(const StateWord& word) {
+    return static_cast<uint64_t>(word.state) |
+           (static_cast<uint64_t>(word.last_frame_tick & TICK_MASK) << LAST_FRAME_SHIFT) |
+           (static_cast<uint64_t>(word.arm_request_tick & TICK_MASK) << ARM_REQUEST_SHIFT);
+}
 
-SafetyMonitor::SafetyMonitor()
-    : m_state(SafetyState::Disarmed) {
-    m_last_frame_time = std::chrono::steady_clock::now();
+StateWord unpackWord(uint64_t word) {
+    StateWord unpacked;
+    unpacked.state = static_cast<SafetyState>(word & 0xF);
+    unpacked.last_frame_tick = static_cast<uint32_t>(word >> LAST_FRAME_SHIFT) & TICK_MASK;
+    unpacked.arm_request_tick = static_cast<uint32_t>(word >> ARM_REQUEST_SHIFT) & TICK_MASK;
+    return unpacked;
+}
+
+// Milliseconds from tick `from` to tick `to` (modulo the tick range). A
+// `to` sampled just before another thread stored `from` is slightly
+// behind it; differences in the upper half of the range count as zero.
+uint32_t tickDiff(uint32_t to, uint32_t from) {
+    uint32_t diff = (to - from) & TICK_MASK;
+    return diff > (TICK_MASK >> 1) ? 0 : diff;
+}
+
+// Create the shutdown wake descriptors once per process (non-blocking so
+// the handler never blocks and draining stops when empty)
+void createWakeFds(int& read_fd, int& write_fd) {
+    if (read_fd >= 0) {
+        return;
+    }
+#ifdef __linux__
+    int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd >= 0) {
+        read_fd = fd;
+        write_fd = fd;
+    }
+#else
+    int fds[2];
+    if (pipe(fds) == 0) {
+        for (int fd : fds) {
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+            fcntl(fd, F_SETFD, FD_CLOEXEC);
+        }
+        read_fd = fds[0];
+        write_fd = fds[1];
+    }
+#endif
+    if (read_fd < 0) {
+        spdlog::warn("Shutdown wake descriptor unavailable: {}", strerror(errno));
+    }
 }
 
+void drainWakeFd(int fd) {
+    uint64_t buffer[8];
+    while (fd >= 0 && read(fd, buffer, sizeof(buffer)) > 0) {
+    }
+}
+
+}  // namespace
+
+SafetyMonitor::SafetyMonitor()
+    : m_epoch(std::chrono::steady_clock::now())
+    , m_word(packWord({SafetyState::Disarmed, 0, 0})) {}
+
 SafetyMonitor::~SafetyMonitor() {
     // Clear static instance if this was it
     SafetyMonitor* expected = this;
@@ -25,74 +111,91 @@ SafetyMonitor::~SafetyMonitor() {
 
 void SafetyMonitor::setConfig(const SafetyConfig& config) {
     m_config = config;
+    m_limiter.setLimits(config.limits);
+}
+
+uint32_t SafetyMonitor::toTick(std::chrono::steady_clock::time_point time) const {
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(time - m_epoch).count();
+    return static_cast<uint32_t>(static_cast<uint64_t>(ms) & TICK_MASK);
 }
 
 void SafetyMonitor::processChannels(ChannelData& channels) {
-    SafetyState current_state = m_state.load();
+    processChannels(channels, std::chrono::steady_clock::now());
+}
 
-    // Emergency stop takes precedence
-    if (current_state == SafetyState::EmergencyStop) {
-        channels = getFailsafeChannels();
-        return;
-    }
+void SafetyMonitor::processChannels(ChannelData& channels,
+                                    std::chrono::steady_clock::time_point now) {
+    // Check arm request in channels (before limiting, so a slewed or
+    // deadbanded arm channel does not delay arm/disarm)
+    processChannels(channels, now, isArmRequested(channels));
+}
 
-    // Check failsafe
-    if (current_state == SafetyState::Failsafe) {
-        channels = getFailsafeChannels();
-        return;
-    }
+void SafetyMonitor::processChannels(ChannelData& channels,
+                                    std::chrono::steady_clock::time_point now,
+                                    bool arm_requested) {
+    Transition transition = advance(channels, now, arm_requested);
+    applyOverrides<THROTTLE_CHANNEL>(channels, transition);
 
-    // Check arm request in channels
-    bool arm_requested = isArmRequested(channels);
-
-    switch (current_state) {
-        case SafetyState::Disarmed:
-            // Force throttle to minimum when disarmed
-            channels[2] = m_config.throttle_min;
-
-            if (arm_requested) {
-                // Start arm delay
-                m_arm_request_time = std::chrono::steady_clock::now();
-                m_state = SafetyState::ArmPending;
-                spdlog::info("Arm requested, waiting {}ms", m_config.arm_delay_ms);
-            }
-            break;
-
-        case SafetyState::ArmPending:
-            // Force throttle to minimum during arm delay
-            channels[2] = m_config.throttle_min;
-
-            if (!arm_requested) {
-                // Arm cancelled
-                m_state = SafetyState::Disarmed;
-                spdlog::info("Arm cancelled");
-            } else {
-                // Check if delay has passed
-                auto now = std::chrono::steady_clock::now();
-                auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-                    now - m_arm_request_time
-                );
-
-                if (elapsed.count() >= static_cast<int64_t>(m_config.arm_delay_ms)) {
-                    m_state = SafetyState::Armed;
-                    spdlog::warn("ARMED - throttle enabled");
+    // Safety overrides are never slewed; the next frame is limited
+    // relative to what was actually output
+    m_limiter.commit(channels, now);
+}
+
+SafetyMonitor::Transition SafetyMonitor::advance(ChannelData& channels,
+                                                 std::chrono::steady_clock::time_point now,
+                                                 bool arm_requested) {
+    uint32_t now_tick = toTick(now);
+    m_limiter.apply(channels, now);
+
+    uint64_t word = m_word.load(std::memory_order_acquire);
+    StateWord current;
+    StateWord next;
+    do {
+        current = unpackWord(word);
+        next = current;
+
+        switch (current.state) {
+            case SafetyState::Disarmed:
+                if (arm_requested) {
+                    // Start arm delay
+                    next.state = SafetyState::ArmPending;
+                    next.arm_request_tick = now_tick;
                 }
-            }
-            break;
+                break;
+
+            case SafetyState::ArmPending:
+                if (!arm_requested) {
+                    // Arm cancelled
+                    next.state = SafetyState::Disarmed;
+                } else if (tickDiff(now_tick, current.arm_request_tick) >= m_config.arm_delay_ms) {
+                    // Delay has passed
+                    next.state = SafetyState::Armed;
+                }
+                break;
 
-        case SafetyState::Armed:
-            if (!arm_requested) {
-                // Disarm
-                m_state = SafetyState::Disarmed;
-                channels[2] = m_config.throttle_min;
-                spdlog::info("Disarmed");
-            }
-            // When armed, pass through throttle as-is
-            break;
+            case SafetyState::Armed:
+                if (!arm_requested) {
+                    next.state = SafetyState::Disarmed;
+                }
+                break;
 
-        default:
-            break;
+            default:
+                break;
+        }
+    } while (next.state != current.state &&
+             !m_word.compare_exchange_weak(word, packWord(next), std::memory_order_acq_rel,
+                                           std::memory_order_acquire));
+
+    if (current.state == SafetyState::Disarmed && next.state == SafetyState::ArmPending) {
+        spdlog::info("Arm requested, waiting {}ms", m_config.arm_delay_ms);
+    } else if (current.state == SafetyState::ArmPending && next.state == SafetyState::Disarmed) {
+        spdlog::info("Arm cancelled");
+    } else if (current.state == SafetyState::ArmPending && next.state == SafetyState::Armed) {
+        spdlog::warn("ARMED - throttle enabled");
+    } else if (current.state == SafetyState::Armed && next.state == SafetyState::Disarmed) {
+        spdlog::info("Disarmed");
     }
+    return {current.state, next.state};
 }
 
 bool SafetyMonitor::isArmRequested(const ChannelData& channels) const {
@@ -105,66 +208,113 @@ bool SafetyMonitor::isArmRequested(const ChannelData& channels) const {
 }
 
 void SafetyMonitor::requestArm() {
-    SafetyState expected = SafetyState::Disarmed;
-    if (m_state.compare_exchange_strong(expected, SafetyState::ArmPending)) {
-        m_arm_request_time = std::chrono::steady_clock::now();
-        spdlog::info("Manual arm requested");
+    uint32_t now_tick = toTick(std::chrono::steady_clock::now());
+    uint64_t word = m_word.load(std::memory_order_acquire);
+    StateWord next = unpackWord(word);
+    while (next.state == SafetyState::Disarmed) {
+        next.state = SafetyState::ArmPending;
+        next.arm_request_tick = now_tick;
+        if (m_word.compare_exchange_weak(word, packWord(next), std::memory_order_acq_rel,
+                                         std::memory_order_acquire)) {
+            spdlog::info("Manual arm requested");
+            return;
+        }
+        next = unpackWord(word);
     }
 }
 
 void SafetyMonitor::requestDisarm() {
-    SafetyState current = m_state.load();
-    if (current == SafetyState::Armed || current == SafetyState::ArmPending) {
-        m_state = SafetyState::Disarmed;
-        spdlog::info("Manual disarm");
+    uint64_t word = m_word.load(std::memory_order_acquire);
+    StateWord next = unpackWord(word);
+    while (next.state == SafetyState::Armed || next.state == SafetyState::ArmPending) {
+        next.state = SafetyState::Disarmed;
+        if (m_word.compare_exchange_weak(word, packWord(next), std::memory_order_acq_rel,
+                                         std::memory_order_acquire)) {
+            spdlog::info("Manual disarm");
+            return;
+        }
+        next = unpackWord(word);
     }
 }
 
 void SafetyMonitor::emergencyStop() {
-    SafetyState prev = m_state.exchange(SafetyState::EmergencyStop);
-    if (prev != SafetyState::EmergencyStop) {
-        spdlog::critical("EMERGENCY STOP");
+    // Also called from the signal handler: one CAS loop, no allocation and
+    // no logging (the woken sender reports the stop)
+    uint64_t word = m_word.load(std::memory_order_acquire);
+    StateWord next = unpackWord(word);
+    while (next.state != SafetyState::EmergencyStop) {
+        next.state = SafetyState::EmergencyStop;
+        if (m_word.compare_exchange_weak(word, packWord(next), std::memory_order_acq_rel,
+                                         std::memory_order_acquire)) {
+            return;
+        }
+        next = unpackWord(word);
     }
 }
 
 SafetyState SafetyMonitor::getState() const {
-    return m_state.load();
+    return unpackWord(m_word.load(std::memory_order_acquire)).state;
 }
 
 bool SafetyMonitor::isArmed() const {
-    return m_state.load() == SafetyState::Armed;
+    return getState() == SafetyState::Armed;
 }
 
 void SafetyMonitor::notifyFrameSent() {
-    m_last_frame_time = std::chrono::steady_clock::now();
+    uint32_t now_tick = toTick(std::chrono::steady_clock::now());
+    uint64_t word = m_word.load(std::memory_order_acquire);
+    StateWord current;
+    StateWord next;
+    do {
+        current = unpackWord(word);
+        next = current;
+        next.last_frame_tick = now_tick;
+        // Reset failsafe if we were in it
+        if (current.state == SafetyState::Failsafe) {
+            next.state = SafetyState::Disarmed;
+        }
+    } while (!m_word.compare_exchange_weak(word, packWord(next), std::memory_order_acq_rel,
+                                           std::memory_order_acquire));
 
-    // Reset failsafe if we were in it
-    SafetyState expected = SafetyState::Failsafe;
-    if (m_state.compare_exchange_strong(expected, SafetyState::Disarmed)) {
+    if (current.state == SafetyState::Failsafe) {
         spdlog::info("Recovered from failsafe");
     }
 }
 
 void SafetyMonitor::checkFailsafe() {
-    SafetyState current = m_state.load();
-
-    // Don't override emergency stop
-    if (current == SafetyState::EmergencyStop) {
-        return;
+    uint32_t now_tick = toTick(std::chrono::steady_clock::now());
+    uint64_t word = m_word.load(std::memory_order_acquire);
+    StateWord next = unpackWord(word);
+
+    // Don't override emergency stop; a frame sent meanwhile fails the CAS
+    // and the timeout is re-evaluated against its tick
+    while (next.state != SafetyState::EmergencyStop && next.state != SafetyState::Failsafe) {
+        uint32_t elapsed = tickDiff(now_tick, next.last_frame_tick);
+        if (elapsed < m_config.failsafe_timeout_ms) {
+            return;
+        }
+        next.state = SafetyState::Failsafe;
+        if (m_word.compare_exchange_weak(word, packWord(next), std::memory_order_acq_rel,
+                                         std::memory_order_acquire)) {
+            spdlog::error("FAILSAFE - no frames sent for {}ms", elapsed);
+            return;
+        }
+        next = unpackWord(word);
     }
+}
 
-    auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now - m_last_frame_time
-    );
-
-    if (elapsed.count() >= static_cast<int64_t>(m_config.failsafe_timeout_ms)) {
-        SafetyState expected = current;
-        if (current != SafetyState::Failsafe &&
-            m_state.compare_exchange_strong(expected, SafetyState::Failsafe)) {
-            spdlog::error("FAILSAFE - no frames sent for {}ms", elapsed.count());
+bool SafetyMonitor::triggerFailsafe() {
+    uint64_t word = m_word.load(std::memory_order_acquire);
+    StateWord next = unpackWord(word);
+    while (next.state != SafetyState::EmergencyStop && next.state != SafetyState::Failsafe) {
+        next.state = SafetyState::Failsafe;
+        if (m_word.compare_exchange_weak(word, packWord(next), std::memory_order_acq_rel,
+                                         std::memory_order_acquire)) {
+            return true;
         }
+        next = unpackWord(word);
     }
+    return false;
 }
 
 ChannelData SafetyMonitor::getFailsafeChannels() const {
@@ -172,7 +322,7 @@ ChannelData SafetyMonitor::getFailsafeChannels() const {
     channels.fill(CRSF_CHANNEL_MID);
 
     // Throttle to minimum
-    channels[2] = m_config.throttle_min;
+    channels[THROTTLE_CHANNEL] = m_config.throttle_min;
 
     // Arm switch to disarm
     if (m_config.arm_channel >= 0 &&
@@ -185,6 +335,9 @@ ChannelData SafetyMonitor::getFailsafeChannels() const {
 
 void SafetyMonitor::installSignalHandlers(SafetyMonitor* monitor) {
     s_instance.store(monitor);
+    createWakeFds(s_wake_read_fd, s_wake_write_fd);
+    drainWakeFd(s_wake_read_fd);
+    s_shutdown_signal_ns.store(0);
     s_shutdown_requested.store(false);
 
     struct sigaction sa{};
@@ -200,9 +353,65 @@ bool SafetyMonitor::isShutdownRequested() {
     return s_shutdown_requested.load();
 }
 
+bool SafetyMonitor::waitForShutdown(std::chrono::nanoseconds timeout) {
+    if (s_shutdown_requested.load()) {
+        return true;
+    }
+    if (s_wake_read_fd < 0) {
+        std::this_thread::sleep_for(timeout);
+        return s_shutdown_requested.load();
+    }
+    if (timeout.count() < 0) {
+        timeout = std::chrono::nanoseconds(0);
+    }
+
+    // The descriptor is never drained while shutdown is pending, so it
+    // wakes all waiting threads and every later wait returns immediately
+#ifdef __linux__
+    struct pollfd pfd{};
+    pfd.fd = s_wake_read_fd;
+    pfd.events = POLLIN;
+    struct timespec ts{};
+    ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+    ts.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+    ppoll(&pfd, 1, &ts, nullptr);
+#else
+    fd_set fds;
+    FD_ZERO(&fds);
+    FD_SET(s_wake_read_fd, &fds);
+    struct timeval tv{};
+    tv.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+    tv.tv_usec = static_cast<suseconds_t>((timeout.count() % 1000000000) / 1000);
+    select(s_wake_read_fd + 1, &fds, nullptr, nullptr, &tv);
+#endif
+    return s_shutdown_requested.load();
+}
+
+int64_t SafetyMonitor::getShutdownSignalTimeNs() {
+    return s_shutdown_signal_ns.load();
+}
+
 void SafetyMonitor::signalHandler(int signum) {
+    // First signal only: a repeated Ctrl-C must not move the latency origin
+    if (s_shutdown_signal_ns.load() == 0) {
+#ifdef __linux__
+        // clock_gettime is async-signal-safe; CLOCK_MONOTONIC is steady_clock
+        struct timespec ts{};
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        s_shutdown_signal_ns.store(static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec);
+#else
+        s_shutdown_signal_ns.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
     s_shutdown_requested.store(true);
 
+    // Wake sender threads sleeping until their next slot
+    if (s_wake_write_fd >= 0) {
+        uint64_t one = 1;
+        (void)write(s_wake_write_fd, &one, sizeof(one));
+    }
+
     SafetyMonitor* monitor = s_instance.load();
     if (monitor) {
         monitor->emergencyStop();
@@ -2,13 +2,18 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <functional>
 
 #include "expresslrs_sender/types.hpp"
+#include "safety/channel_limiter.hpp"
 
 namespace elrs {
 namespace safety {
 
+// Throttle (0-indexed, CH3): held at throttle_min unless armed
+constexpr int THROTTLE_CHANNEL = 2;
+
 // Safety configuration
 struct SafetyConfig {
     int arm_channel = 4;              // 0-indexed (CH5)
@@ -17,6 +22,7 @@ struct SafetyConfig {
     uint32_t failsafe_timeout_ms = 500;
     uint32_t arm_delay_ms = 3000;     // Delay before arm is allowed
     int disarm_frames = 10;           // Frames to send on emergency stop
+    ChannelLimits limits;             // Per-channel range/slew/deadband (0-indexed)
 };
 
 // Safety state
@@ -28,18 +34,46 @@ enum class SafetyState {
     EmergencyStop
 };
 
+// Safety state machine. All state lives in one 64-bit atomic word (state,
+// last-frame tick, arm-request tick) updated by compare-and-swap, so
+// processChannels(), notifyFrameSent(), checkFailsafe() and the state
+// changes below may be called concurrently from different threads
+// (sender, watchdog, input) and from the signal handler without locks.
 class SafetyMonitor {
 public:
     SafetyMonitor();
     ~SafetyMonitor();
 
-    // Configuration
+    // Configuration. Not synchronized: call only from the sender thread
+    // (setup or a config reload between slots). m_config is read only by
+    // the sender-side methods; the watchdog copies what it needs at start().
     void setConfig(const SafetyConfig& config);
     const SafetyConfig& getConfig() const { return m_config; }
 
     // Process channels through safety checks
-    // Modifies channels in-place if safety override is needed
+    // Modifies channels in-place if safety override is needed. The
+    // channel limiter keeps per-stream state, so this has one caller at a
+    // time (the sender); the other methods may run concurrently with it.
     void processChannels(ChannelData& channels);
+    // Same, with the current time supplied by the caller (arm delay is
+    // measured against it)
+    void processChannels(ChannelData& channels, std::chrono::steady_clock::time_point now);
+    // Same, with the arm switch already evaluated by the caller
+    void processChannels(ChannelData& channels, std::chrono::steady_clock::time_point now,
+                         bool arm_requested);
+    // Same, for a channel layout fixed at compile time (see
+    // playback::SpecializedFramePipeline): the arm switch is read and the
+    // throttle overridden at constant indices. ArmChannel must match the
+    // configured arm channel.
+    template <int ArmChannel, int ThrottleChannel>
+    void processChannelsFixed(ChannelData& channels, std::chrono::steady_clock::time_point now) {
+        static_assert(ArmChannel >= 0 && ArmChannel < static_cast<int>(CRSF_MAX_CHANNELS),
+                      "arm channel out of range");
+        bool arm_requested = channels[ArmChannel] > m_config.arm_threshold;
+        Transition transition = advance(channels, now, arm_requested);
+        applyOverrides<ThrottleChannel>(channels, transition);
+        m_limiter.commit(channels, now);
+    }
 
     // Check if arming is requested in the given channels
     bool isArmRequested(const ChannelData& channels) const;
@@ -58,24 +92,86 @@ public:
     // Failsafe handling
     void notifyFrameSent();  // Call after each successful frame send
     void checkFailsafe();    // Call periodically to check timeout
+    // Enter failsafe now (e.g. from the watchdog); no effect during
+    // emergency stop. Returns true if the state changed.
+    bool triggerFailsafe();
 
     // Get failsafe/disarm channel data
     ChannelData getFailsafeChannels() const;
 
+    // Channel limiter trigger counts (read from the processChannels caller
+    // or after it has stopped)
+    const LimiterStats& getLimiterStats() const { return m_limiter.getStats(); }
+
     // Install signal handlers (SIGINT, SIGTERM)
     static void installSignalHandlers(SafetyMonitor* monitor);
 
     // Check if shutdown was requested via signal
     static bool isShutdownRequested();
 
+    // Sleep for up to `timeout`, returning early (true) as soon as a
+    // shutdown signal arrives. The signal handler writes an eventfd
+    // (self-pipe elsewhere) that stays readable, so every sender thread
+    // wakes. Falls back to a plain sleep before installSignalHandlers().
+    static bool waitForShutdown(std::chrono::nanoseconds timeout);
+
+    // steady_clock time of the shutdown signal in ns since the clock's
+    // epoch (0 = none); the start of the emergency disarm latency
+    static int64_t getShutdownSignalTimeNs();
+
 private:
+    // State word layout: state in bits 0-3, last-frame tick in bits 4-33,
+    // arm-request tick in bits 34-63. Ticks are milliseconds since m_epoch
+    // modulo 2^30; only differences between ticks (up to about 6 days) are used.
     SafetyConfig m_config;
-    std::atomic<SafetyState> m_state;
-    std::chrono::steady_clock::time_point m_last_frame_time;
-    std::chrono::steady_clock::time_point m_arm_request_time;
+    const std::chrono::steady_clock::time_point m_epoch;
+    std::atomic<uint64_t> m_word;
+    ChannelLimiter m_limiter;
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free,
+                  "SafetyMonitor is used from a signal handler");
+
+    uint32_t toTick(std::chrono::steady_clock::time_point time) const;
+
+    struct Transition {
+        SafetyState from;
+        SafetyState to;
+    };
+
+    // Limiter pass and one state machine step (logs the change)
+    Transition advance(ChannelData& channels, std::chrono::steady_clock::time_point now,
+                       bool arm_requested);
+
+    // Channel overrides for the state the frame was processed in
+    template <int ThrottleChannel>
+    void applyOverrides(ChannelData& channels, Transition transition) const {
+        static_assert(ThrottleChannel >= 0 && ThrottleChannel < static_cast<int>(CRSF_MAX_CHANNELS),
+                      "throttle channel out of range");
+        switch (transition.from) {
+            case SafetyState::EmergencyStop:
+            case SafetyState::Failsafe:
+                // Emergency stop and failsafe override everything
+                channels = getFailsafeChannels();
+                break;
+            case SafetyState::Disarmed:
+            case SafetyState::ArmPending:
+                // Throttle at minimum while disarmed and during the arm delay
+                channels[ThrottleChannel] = m_config.throttle_min;
+                break;
+            case SafetyState::Armed:
+                // Armed passes throttle through, except on the disarming frame
+                if (transition.to == SafetyState::Disarmed) {
+                    channels[ThrottleChannel] = m_config.throttle_min;
+                }
+                break;
+        }
+    }
 
     static std::atomic<SafetyMonitor*> s_instance;
     static std::atomic<bool> s_shutdown_requested;
+    static std::atomic<int64_t> s_shutdown_signal_ns;
+    static int s_wake_read_fd;
+    static int s_wake_write_fd;
 
     static void signalHandler(int signum);
 };
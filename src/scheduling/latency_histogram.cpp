@@ -0,0 +1,68 @@
+#include "latency_histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace elrs {
+namespace scheduling {
+
+LatencyHistogram::LatencyHistogram(size_t range_us)
+    : m_buckets(std::max<size_t>(range_us, 1), 0)
+    , m_overflow(0)
+    , m_count(0)
+    , m_max(0)
+    , m_sum(0) {}
+
+void LatencyHistogram::record(int64_t latency_us) {
+    if (latency_us < 0) {
+        latency_us = 0;
+    }
+
+    if (static_cast<uint64_t>(latency_us) < m_buckets.size()) {
+        m_buckets[static_cast<size_t>(latency_us)]++;
+    } else {
+        m_overflow++;
+    }
+
+    m_count++;
+    m_sum += static_cast<double>(latency_us);
+    if (latency_us > m_max) {
+        m_max = latency_us;
+    }
+}
+
+void LatencyHistogram::reset() {
+    std::fill(m_buckets.begin(), m_buckets.end(), 0);
+    m_overflow = 0;
+    m_count = 0;
+    m_max = 0;
+    m_sum = 0;
+}
+
+double LatencyHistogram::mean() const {
+    return m_count > 0 ? m_sum / static_cast<double>(m_count) : 0.0;
+}
+
+int64_t LatencyHistogram::percentile(double p) const {
+    if (m_count == 0) {
+        return 0;
+    }
+
+    p = std::clamp(p, 0.0, 100.0);
+    auto target = static_cast<uint64_t>(std::ceil(p / 100.0 * static_cast<double>(m_count)));
+    if (target == 0) {
+        target = 1;
+    }
+
+    uint64_t seen = 0;
+    for (size_t us = 0; us < m_buckets.size(); us++) {
+        seen += m_buckets[us];
+        if (seen >= target) {
+            return static_cast<int64_t>(us);
+        }
+    }
+    return m_max;
+}
+
+}  // namespace scheduling
+}  // namespace elrs
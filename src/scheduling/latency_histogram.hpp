@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace elrs {
+namespace scheduling {
+
+// Fixed-bucket wakeup latency histogram (1us resolution).
+// Storage is allocated up front; record() never allocates, so it is safe
+// to call from the RT loop.
+class LatencyHistogram {
+public:
+    static constexpr size_t DEFAULT_RANGE_US = 10000;  // 10ms
+
+    explicit LatencyHistogram(size_t range_us = DEFAULT_RANGE_US);
+
+    // Record one sample (negative values count as 0)
+    void record(int64_t latency_us);
+
+    // Clear all samples
+    void reset();
+
+    uint64_t count() const { return m_count; }
+    int64_t max() const { return m_max; }
+    double mean() const;
+
+    // Latency at or below which p% of samples fall (p in 0-100).
+    // Samples beyond the range report the observed maximum.
+    int64_t percentile(double p) const;
+
+private:
+    std::vector<uint32_t> m_buckets;
+    uint64_t m_overflow;
+    uint64_t m_count;
+    int64_t m_max;
+    double m_sum;
+};
+
+}  // namespace scheduling
+}  // namespace elrs
@@ -1,15 +1,106 @@
 #include "realtime.hpp"
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
 #include <spdlog/spdlog.h>
 
 #ifdef __linux__
+#include <alloca.h>
+#include <dirent.h>
+#include <malloc.h>
+#include <pthread.h>
 #include <sched.h>
+#include <unistd.h>
 #include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
 #endif
 
 namespace elrs {
 namespace scheduling {
 
+namespace {
+
+// Stack left untouched below the prefaulted region
+constexpr size_t PREFAULT_STACK_MARGIN = 64 * 1024;
+
+// Read the first line of a sysfs/procfs file ("" if unavailable)
+std::string readFirstLine(const std::string& path) {
+    std::ifstream file(path);
+    std::string line;
+    if (file.is_open()) {
+        std::getline(file, line);
+    }
+    return line;
+}
+
+#ifdef __linux__
+bool setAffinity(int pid, const std::vector<int>& cpus) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return sched_setaffinity(pid, sizeof(set), &set) == 0;
+}
+
+void pinUartIrq(const RealtimeOptions& options, const std::string& uart_device,
+                const std::vector<int>& rt_cpus) {
+    int irq = findUartIrq(uart_device);
+    if (irq < 0) {
+        spdlog::warn("UART IRQ for {} not found - IRQ pinning skipped", uart_device);
+        return;
+    }
+
+    const std::vector<int>& irq_cpus =
+        options.irq_cpu_affinity.empty() ? rt_cpus : options.irq_cpu_affinity;
+
+    if (!irq_cpus.empty()) {
+        // Hardware IRQ affinity (the IRQ thread follows it on next wakeup)
+        std::ofstream affinity("/proc/irq/" + std::to_string(irq) + "/smp_affinity_list");
+        affinity << formatCpuList(irq_cpus);
+        affinity.flush();
+        if (!affinity) {
+            spdlog::warn("Failed to set IRQ {} affinity to CPU {}",
+                         irq, formatCpuList(irq_cpus));
+        } else {
+            spdlog::info("IRQ {} ({}) affinity set to CPU {}",
+                         irq, uart_device, formatCpuList(irq_cpus));
+        }
+    }
+
+    int pid = findIrqThread(irq);
+    if (pid < 0) {
+        spdlog::debug("No threaded handler for IRQ {} (threadirqs not enabled?)", irq);
+        return;
+    }
+
+    if (!irq_cpus.empty() && !setAffinity(pid, irq_cpus)) {
+        spdlog::warn("Failed to pin IRQ thread {} to CPU {}: {}",
+                     pid, formatCpuList(irq_cpus), strerror(errno));
+    }
+
+    struct sched_param param{};
+    param.sched_priority = options.irq_priority;
+    if (sched_setscheduler(pid, SCHED_FIFO, &param) != 0) {
+        spdlog::warn("Failed to set IRQ thread {} priority {}: {}",
+                     pid, options.irq_priority, strerror(errno));
+    } else {
+        spdlog::info("IRQ thread {} (irq {}) set to SCHED_FIFO priority {}",
+                     pid, irq, options.irq_priority);
+    }
+}
+#endif
+
+}  // namespace
+
 void enableRealtimeScheduling(int priority) {
 #ifdef __linux__
     // Set SCHED_FIFO with the requested priority
@@ -38,6 +129,59 @@ void enableRealtimeScheduling(int priority) {
 #endif
 }
 
+void enableRealtimeScheduling(const RealtimeOptions& options, const std::string& uart_device) {
+#ifdef __linux__
+    // CPU placement first, so the RT thread never runs on a shared core
+    auto isolated = getIsolatedCpus();
+    auto nohz_full = getNohzFullCpus();
+    if (!isolated.empty() || !nohz_full.empty()) {
+        spdlog::debug("Isolated CPUs: [{}], nohz_full CPUs: [{}]",
+                      formatCpuList(isolated), formatCpuList(nohz_full));
+    }
+
+    auto rt_cpus = selectRealtimeCpus(options, isolated, nohz_full);
+    if (!rt_cpus.empty()) {
+        if (setAffinity(0, rt_cpus)) {
+            spdlog::info("Pinned sender to CPU {}{}", formatCpuList(rt_cpus),
+                         options.cpu_affinity.empty() ? " (isolated)" : "");
+        } else {
+            spdlog::warn("Failed to set CPU affinity {}: {}",
+                         formatCpuList(rt_cpus), strerror(errno));
+        }
+    }
+
+    // Timer slack: default 50us would delay every nanosleep wakeup
+    if (options.timer_slack_ns > 0) {
+        if (prctl(PR_SET_TIMERSLACK, static_cast<unsigned long>(options.timer_slack_ns)) != 0) {
+            spdlog::warn("Failed to set timer slack {}ns: {}",
+                         options.timer_slack_ns, strerror(errno));
+        } else {
+            spdlog::debug("Timer slack set to {}ns", options.timer_slack_ns);
+        }
+    }
+
+    enableRealtimeScheduling(options.priority);
+
+    // Pre-touch stack and heap growth now that MCL_FUTURE is in effect
+    if (options.prefault_stack_kb > 0 || options.prefault_heap_kb > 0) {
+        auto before = getPageFaultCounts();
+        prefaultHeap(options.prefault_heap_kb * 1024);
+        prefaultStack(options.prefault_stack_kb * 1024);
+        auto after = getPageFaultCounts();
+        spdlog::info("Prefaulted {}KB stack, {}KB heap ({} minor faults)",
+                     options.prefault_stack_kb, options.prefault_heap_kb,
+                     after.minor - before.minor);
+    }
+
+    if (options.pin_uart_irq && !uart_device.empty()) {
+        pinUartIrq(options, uart_device, rt_cpus);
+    }
+#else
+    (void)uart_device;
+    enableRealtimeScheduling(options.priority);
+#endif
+}
+
 void disableRealtimeScheduling() {
 #ifdef __linux__
     struct sched_param param{};
@@ -48,5 +192,235 @@ void disableRealtimeScheduling() {
 #endif
 }
 
+void prefaultStack(size_t bytes) {
+#ifdef __linux__
+    if (bytes == 0) {
+        return;
+    }
+
+    // Stay within the calling thread's stack (port threads get the default
+    // std::thread size), keeping a margin for the frames called later
+    pthread_attr_t attr;
+    if (pthread_getattr_np(pthread_self(), &attr) == 0) {
+        void* stack_addr = nullptr;
+        size_t stack_size = 0;
+        if (pthread_attr_getstack(&attr, &stack_addr, &stack_size) == 0) {
+            volatile unsigned char marker = 0;
+            auto used = reinterpret_cast<uintptr_t>(&marker);
+            auto lowest = reinterpret_cast<uintptr_t>(stack_addr);
+            size_t available = used > lowest ? static_cast<size_t>(used - lowest) : 0;
+            size_t limit = available > PREFAULT_STACK_MARGIN ? available - PREFAULT_STACK_MARGIN : 0;
+            if (bytes > limit) {
+                spdlog::warn("Stack prefault {}KB exceeds this thread's free stack, "
+                             "using {}KB", bytes / 1024, limit / 1024);
+                bytes = limit;
+            }
+        }
+        pthread_attr_destroy(&attr);
+    }
+    if (bytes == 0) {
+        return;
+    }
+
+    // alloca extends this frame; touching one byte per page faults it in
+    auto* stack = static_cast<volatile unsigned char*>(alloca(bytes));
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    for (size_t i = 0; i < bytes; i += page) {
+        stack[i] = 0;
+    }
+#else
+    (void)bytes;
+#endif
+}
+
+void prefaultHeap(size_t bytes) {
+#if defined(__linux__) && defined(__GLIBC__)
+    // Keep freed memory in the arena and never serve allocations via mmap,
+    // otherwise the prefaulted pages are returned to the kernel
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+
+    if (bytes == 0) {
+        return;
+    }
+    auto* heap = static_cast<volatile unsigned char*>(malloc(bytes));
+    if (!heap) {
+        spdlog::warn("Failed to prefault {} bytes of heap", bytes);
+        return;
+    }
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    for (size_t i = 0; i < bytes; i += page) {
+        heap[i] = 0;
+    }
+    free(const_cast<unsigned char*>(heap));
+#else
+    (void)bytes;
+#endif
+}
+
+PageFaultCounts getPageFaultCounts() {
+    PageFaultCounts counts;
+#ifdef __linux__
+    struct rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        counts.minor = usage.ru_minflt;
+        counts.major = usage.ru_majflt;
+    }
+#endif
+    return counts;
+}
+
+std::chrono::steady_clock::time_point mapRealtimeToSteady(
+    std::chrono::system_clock::time_point target) {
+    // Bracket the monotonic read with two realtime reads and use the midpoint
+    auto real_before = std::chrono::system_clock::now();
+    auto steady_now = std::chrono::steady_clock::now();
+    auto real_after = std::chrono::system_clock::now();
+    auto real_now = real_before + (real_after - real_before) / 2;
+
+    return steady_now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        target - real_now);
+}
+
+std::vector<int> parseCpuList(const std::string& list) {
+    std::vector<int> cpus;
+    std::istringstream ss(list);
+    std::string token;
+
+    while (std::getline(ss, token, ',')) {
+        // Trim whitespace/newline
+        size_t first = token.find_first_not_of(" \t\r\n");
+        size_t last = token.find_last_not_of(" \t\r\n");
+        if (first == std::string::npos) {
+            continue;
+        }
+        token = token.substr(first, last - first + 1);
+
+        try {
+            size_t dash = token.find('-');
+            if (dash == std::string::npos) {
+                cpus.push_back(std::stoi(token));
+            } else {
+                int lo = std::stoi(token.substr(0, dash));
+                int hi = std::stoi(token.substr(dash + 1));
+                for (int cpu = lo; cpu <= hi; cpu++) {
+                    cpus.push_back(cpu);
+                }
+            }
+        } catch (...) {
+            // Skip invalid token
+        }
+    }
+
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+std::string formatCpuList(const std::vector<int>& cpus) {
+    std::vector<int> sorted = cpus;
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    std::string out;
+    for (size_t i = 0; i < sorted.size();) {
+        size_t j = i;
+        while (j + 1 < sorted.size() && sorted[j + 1] == sorted[j] + 1) {
+            j++;
+        }
+        if (!out.empty()) {
+            out += ",";
+        }
+        out += std::to_string(sorted[i]);
+        if (j > i) {
+            out += "-" + std::to_string(sorted[j]);
+        }
+        i = j + 1;
+    }
+    return out;
+}
+
+std::vector<int> getIsolatedCpus() {
+    return parseCpuList(readFirstLine("/sys/devices/system/cpu/isolated"));
+}
+
+std::vector<int> getNohzFullCpus() {
+    std::string list = readFirstLine("/sys/devices/system/cpu/nohz_full");
+    // Kernels without CONFIG_NO_HZ_FULL report "(null)"
+    if (list.find('(') != std::string::npos) {
+        return {};
+    }
+    return parseCpuList(list);
+}
+
+std::vector<int> selectRealtimeCpus(const RealtimeOptions& options,
+                                    const std::vector<int>& isolated,
+                                    const std::vector<int>& nohz_full) {
+    if (!options.cpu_affinity.empty()) {
+        return parseCpuList(formatCpuList(options.cpu_affinity));
+    }
+    if (!options.prefer_isolated_cpus || isolated.empty()) {
+        return {};
+    }
+
+    // Isolated + tickless is the quietest placement
+    std::vector<int> both;
+    std::set_intersection(isolated.begin(), isolated.end(),
+                          nohz_full.begin(), nohz_full.end(),
+                          std::back_inserter(both));
+    return both.empty() ? isolated : both;
+}
+
+int findUartIrq(const std::string& device) {
+    std::string name = device;
+    size_t slash = name.rfind('/');
+    if (slash != std::string::npos) {
+        name = name.substr(slash + 1);
+    }
+    if (name.empty()) {
+        return -1;
+    }
+
+    // serial_core exports the port IRQ for every UART driver
+    std::string irq = readFirstLine("/sys/class/tty/" + name + "/irq");
+    try {
+        int value = std::stoi(irq);
+        return value > 0 ? value : -1;
+    } catch (...) {
+        return -1;
+    }
+}
+
+int findIrqThread(int irq) {
+#ifdef __linux__
+    if (irq < 0) {
+        return -1;
+    }
+
+    std::string prefix = "irq/" + std::to_string(irq) + "-";
+    DIR* proc = opendir("/proc");
+    if (!proc) {
+        return -1;
+    }
+
+    int found = -1;
+    while (struct dirent* entry = readdir(proc)) {
+        if (entry->d_name[0] < '0' || entry->d_name[0] > '9') {
+            continue;
+        }
+        std::string comm = readFirstLine(std::string("/proc/") + entry->d_name + "/comm");
+        if (comm.compare(0, prefix.size(), prefix) == 0) {
+            found = std::atoi(entry->d_name);
+            break;
+        }
+    }
+    closedir(proc);
+    return found;
+#else
+    (void)irq;
+    return -1;
+#endif
+}
+
 }  // namespace scheduling
 }  // namespace elrs
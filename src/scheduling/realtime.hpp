@@ -1,15 +1,88 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
 namespace elrs {
 namespace scheduling {
 
+// Real-time scheduling options (config "scheduling" section)
+struct RealtimeOptions {
+    int priority = 49;                   // SCHED_FIFO priority (1-99)
+    std::vector<int> cpu_affinity;       // 送信スレッドを固定する CPU（空 = 自動選択）
+    bool prefer_isolated_cpus = true;    // cpu_affinity 未指定時に isolcpus/nohz_full コアを使用
+    bool pin_uart_irq = false;           // UART の IRQ スレッドのアフィニティ/優先度を設定
+    std::vector<int> irq_cpu_affinity;   // IRQ スレッドの CPU（空 = 送信スレッドと同じ）
+    int irq_priority = 50;               // IRQ スレッドの SCHED_FIFO priority
+    long timer_slack_ns = 1;             // PR_SET_TIMERSLACK（0 = 変更しない）
+    size_t prefault_stack_kb = 512;      // 事前にタッチするスタック量（0 = 無効）
+    size_t prefault_heap_kb = 4096;      // 事前に確保/タッチするヒープ量（0 = 無効）
+};
+
+// Page fault counters (getrusage)
+struct PageFaultCounts {
+    long minor = 0;
+    long major = 0;
+};
+
 // Enable SCHED_FIFO real-time scheduling and lock memory.
 // Falls back gracefully with a warning if insufficient privileges.
 // priority: RT priority (1-99, default 49)
 void enableRealtimeScheduling(int priority = 49);
 
+// Enable real-time scheduling with CPU placement, IRQ thread pinning and
+// timer slack. uart_device is used to locate the UART IRQ thread.
+// Every step is best-effort and logs what was applied.
+void enableRealtimeScheduling(const RealtimeOptions& options,
+                              const std::string& uart_device = "");
+
 // Restore default (SCHED_OTHER) scheduling and unlock memory.
 void disableRealtimeScheduling();
 
+// Largest accepted scheduling.prefault_stack_kb
+constexpr size_t MAX_PREFAULT_STACK_KB = 4096;
+
+// Touch `bytes` of stack below the caller so later growth does not fault.
+// Call after mlockall(MCL_FUTURE) so the pages stay resident. Clamped (with
+// a warning) to the calling thread's free stack minus a margin.
+void prefaultStack(size_t bytes);
+
+// Disable malloc trimming/mmap and pre-grow the heap arena by `bytes`, so
+// later allocations are served from already-faulted, locked pages.
+void prefaultHeap(size_t bytes);
+
+// Page faults of the calling process so far
+PageFaultCounts getPageFaultCounts();
+
+// Map a CLOCK_REALTIME instant onto the monotonic clock using the current
+// offset between the two (sampled back-to-back to minimise error)
+std::chrono::steady_clock::time_point mapRealtimeToSteady(
+    std::chrono::system_clock::time_point target);
+
+// Parse a kernel CPU list ("0-2,5") into sorted CPU numbers.
+// Invalid tokens are skipped.
+std::vector<int> parseCpuList(const std::string& list);
+
+// Format CPU numbers as a kernel CPU list ("0-2,5")
+std::string formatCpuList(const std::vector<int>& cpus);
+
+// CPUs isolated from the scheduler (isolcpus=) / running tickless (nohz_full=)
+std::vector<int> getIsolatedCpus();
+std::vector<int> getNohzFullCpus();
+
+// Pick CPUs for the RT loop: explicit list if given, otherwise isolated
+// CPUs (preferring those that are also nohz_full). Empty = leave as is.
+std::vector<int> selectRealtimeCpus(const RealtimeOptions& options,
+                                    const std::vector<int>& isolated,
+                                    const std::vector<int>& nohz_full);
+
+// Find the IRQ number of a serial device (/dev/ttyAMA0 -> 33), -1 if unknown
+int findUartIrq(const std::string& device);
+
+// Find the threaded IRQ handler ("irq/<N>-...") pid, -1 if not found
+int findIrqThread(int irq);
+
 }  // namespace scheduling
 }  // namespace elrs
@@ -0,0 +1,36 @@
+#include "start_barrier.hpp"
+
+#include <algorithm>
+
+namespace elrs {
+namespace scheduling {
+
+StartBarrier::StartBarrier(size_t parties)
+    : m_parties(parties)
+    , m_arrived(0)
+    , m_released(false)
+    , m_fixed_start(false) {}
+
+void StartBarrier::setStartTime(std::chrono::steady_clock::time_point start_time) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_start_time = start_time;
+    m_fixed_start = true;
+}
+
+std::chrono::steady_clock::time_point StartBarrier::arriveAndWait() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (++m_arrived >= m_parties) {
+        auto now = std::chrono::steady_clock::now();
+        m_start_time = m_fixed_start ? std::max(m_start_time, now) : now;
+        m_released = true;
+        m_cv.notify_all();
+        return m_start_time;
+    }
+
+    m_cv.wait(lock, [this] { return m_released; });
+    return m_start_time;
+}
+
+}  // namespace scheduling
+}  // namespace elrs
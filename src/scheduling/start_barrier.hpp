@@ -0,0 +1,36 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+namespace elrs {
+namespace scheduling {
+
+// Rendezvous for sender threads that must start their slot clocks together.
+// Each thread finishes its RT setup, then calls arriveAndWait(); all of them
+// are released with the same start time once the last one arrives.
+class StartBarrier {
+public:
+    explicit StartBarrier(size_t parties);
+
+    // Release at a fixed start time instead of "when the last one arrives".
+    // If that time has already passed on release, the release time is used.
+    void setStartTime(std::chrono::steady_clock::time_point start_time);
+
+    // Block until all parties have arrived; returns the common start time
+    std::chrono::steady_clock::time_point arriveAndWait();
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    size_t m_parties;
+    size_t m_arrived;
+    bool m_released;
+    bool m_fixed_start;
+    std::chrono::steady_clock::time_point m_start_time;
+};
+
+}  // namespace scheduling
+}  // namespace elrs
@@ -290,8 +290,12 @@ Result<std::vector<uint8_t>> UartDriver::read(size_t max_len, int timeout_ms) {
 }
 
 void UartDriver::drainTelemetry(int timeout_ms) {
+    drainTelemetry(timeout_ms, nullptr, 0);
+}
+
+size_t UartDriver::drainTelemetry(int timeout_ms, uint8_t* capture, size_t capacity) {
     if (!m_options.half_duplex || m_fd < 0) {
-        return;
+        return 0;
     }
 
     auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
@@ -316,12 +320,17 @@ void UartDriver::drainTelemetry(int timeout_ms) {
         if (n <= 0) {
             break;
         }
+        if (total_bytes < capacity) {
+            size_t copy = std::min(capacity - total_bytes, static_cast<size_t>(n));
+            std::memcpy(capture + total_bytes, buf, copy);
+        }
         total_bytes += static_cast<size_t>(n);
     }
 
     if (total_bytes > 0) {
         spdlog::debug("Drained {} telemetry bytes", total_bytes);
     }
+    return total_bytes;
 }
 
 void UartDriver::setTxEnabled(bool /* enabled */) {
@@ -52,6 +52,8 @@ public:
 
     // 半二重モードで TX モジュールからのテレメトリを読み捨てる
     void drainTelemetry(int timeout_ms = 1);
+    // 読み捨てたバイトの先頭 capacity バイトを capture にコピーし、読んだ総バイト数を返す
+    size_t drainTelemetry(int timeout_ms, uint8_t* capture, size_t capacity);
 
     // Enable/disable TX (for half-duplex direction control)
     void setTxEnabled(bool enabled);
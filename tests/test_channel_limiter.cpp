@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "safety/channel_limiter.hpp"
+#include "safety/safety_monitor.hpp"
+
+using namespace elrs;
+using namespace elrs::safety;
+
+class ChannelLimiterTest : public ::testing::Test {
+protected:
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point at(int ms) {
+        return Clock::time_point(std::chrono::milliseconds(ms));
+    }
+
+    ChannelData channels(int16_t value = CRSF_CHANNEL_MID) {
+        ChannelData ch;
+        ch.fill(value);
+        return ch;
+    }
+
+    // Apply and commit one frame
+    ChannelData step(ChannelLimiter& limiter, ChannelData ch, int ms) {
+        limiter.apply(ch, at(ms));
+        limiter.commit(ch, at(ms));
+        return ch;
+    }
+};
+
+// LIM-001: Default limits are disabled and leave channels untouched
+TEST_F(ChannelLimiterTest, DisabledByDefault) {
+    ChannelLimiter limiter;
+    EXPECT_FALSE(limiter.enabled());
+
+    auto input = channels();
+    input[2] = 0;
+    input[5] = 2047;
+    EXPECT_EQ(step(limiter, input, 0), input);
+    EXPECT_EQ(step(limiter, channels(), 2), channels());
+    EXPECT_EQ(limiter.getStats().range[2], 0u);
+}
+
+// LIM-002: Range clamp per channel, counted per channel
+TEST_F(ChannelLimiterTest, RangeClamp) {
+    ChannelLimits limits;
+    limits[2].min = 300;
+    limits[2].max = 1500;
+    limits[15].max = 1000;
+    ChannelLimiter limiter;
+    limiter.setLimits(limits);
+
+    auto input = channels();
+    input[2] = CRSF_CHANNEL_MIN;
+    input[15] = CRSF_CHANNEL_MAX;
+    auto out = step(limiter, input, 0);
+    EXPECT_EQ(out[2], 300);
+    EXPECT_EQ(out[15], 1000);
+    EXPECT_EQ(out[0], CRSF_CHANNEL_MID);
+
+    input[2] = CRSF_CHANNEL_MAX;
+    out = step(limiter, input, 2);
+    EXPECT_EQ(out[2], 1500);
+
+    EXPECT_EQ(limiter.getStats().range[2], 2u);
+    EXPECT_EQ(limiter.getStats().range[15], 2u);
+    EXPECT_EQ(limiter.getStats().range[0], 0u);
+}
+
+// LIM-003: Slew limit scales with the time since the last frame
+TEST_F(ChannelLimiterTest, SlewRate) {
+    ChannelLimits limits;
+    limits[2].max_delta_per_ms = 5;
+    ChannelLimiter limiter;
+    limiter.setLimits(limits);
+
+    auto input = channels(CRSF_CHANNEL_MIN);
+    step(limiter, input, 0);  // First frame: no reference, not limited
+
+    // Full throttle in one 2ms frame is limited to 10 units per frame
+    input[2] = CRSF_CHANNEL_MAX;
+    input[0] = CRSF_CHANNEL_MAX;  // Unlimited channel follows immediately
+    auto out = step(limiter, input, 2);
+    EXPECT_EQ(out[2], CRSF_CHANNEL_MIN + 10);
+    EXPECT_EQ(out[0], CRSF_CHANNEL_MAX);
+
+    out = step(limiter, input, 22);
+    EXPECT_EQ(out[2], CRSF_CHANNEL_MIN + 110);
+
+    // Downward steps are limited too
+    input[2] = CRSF_CHANNEL_MIN;
+    out = step(limiter, input, 24);
+    EXPECT_EQ(out[2], CRSF_CHANNEL_MIN + 100);
+
+    EXPECT_EQ(limiter.getStats().slew[2], 3u);
+    EXPECT_EQ(limiter.getStats().slew[0], 0u);
+}
+
+// LIM-004: Deadband holds small changes; larger ones pass
+TEST_F(ChannelLimiterTest, Deadband) {
+    ChannelLimits limits;
+    limits[0].deadband = 3;
+    ChannelLimiter limiter;
+    limiter.setLimits(limits);
+
+    auto input = channels(1000);
+    step(limiter, input, 0);
+
+    input[0] = 1003;
+    EXPECT_EQ(step(limiter, input, 2)[0], 1000);
+    input[0] = 997;
+    EXPECT_EQ(step(limiter, input, 4)[0], 1000);
+    input[0] = 1004;
+    EXPECT_EQ(step(limiter, input, 6)[0], 1004);
+    EXPECT_EQ(limiter.getStats().deadband[0], 2u);
+}
+
+// LIM-005: SafetyMonitor limits history values but never slews its own
+// overrides; ramps start from the value actually sent
+TEST_F(ChannelLimiterTest, SafetyMonitorStage) {
+    SafetyConfig config;
+    config.arm_delay_ms = 0;
+    config.limits[2].max_delta_per_ms = 1;
+    SafetyMonitor monitor;
+    monitor.setConfig(config);
+
+    auto input = channels();
+    input[2] = CRSF_CHANNEL_MAX;
+    input[4] = CRSF_CHANNEL_MAX;
+
+    auto frame = input;
+    monitor.processChannels(frame, at(0));  // Disarmed -> ArmPending
+    EXPECT_EQ(frame[2], CRSF_CHANNEL_MIN);
+    frame = input;
+    monitor.processChannels(frame, at(10));  // Armed (throttle still held low)
+    ASSERT_EQ(monitor.getState(), SafetyState::Armed);
+    frame = input;
+    monitor.processChannels(frame, at(20));
+    EXPECT_EQ(frame[2], CRSF_CHANNEL_MIN + 10);
+
+    // Emergency stop output is immediate
+    monitor.emergencyStop();
+    frame = input;
+    monitor.processChannels(frame, at(22));
+    EXPECT_EQ(frame, monitor.getFailsafeChannels());
+    EXPECT_GT(monitor.getLimiterStats().slew[2], 0u);
+}
+
+// LIM-006: Changing limits mid-stream keeps the last output as reference
+TEST_F(ChannelLimiterTest, SetLimitsKeepsPrevious) {
+    ChannelLimits limits;
+    limits[2].max_delta_per_ms = 100;
+    ChannelLimiter limiter;
+    limiter.setLimits(limits);
+    step(limiter, channels(CRSF_CHANNEL_MIN), 0);
+
+    // Tighter limit after a reload: no jump on the next frame
+    limits[2].max_delta_per_ms = 5;
+    limiter.setLimits(limits);
+    auto out = step(limiter, channels(CRSF_CHANNEL_MAX), 2);
+    EXPECT_EQ(out[2], CRSF_CHANNEL_MIN + 10);
+    EXPECT_EQ(out[0], CRSF_CHANNEL_MAX);
+}
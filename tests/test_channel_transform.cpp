@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include "playback/channel_transform.hpp"
+
+using namespace elrs;
+using namespace elrs::playback;
+
+class ChannelTransformTest : public ::testing::Test {
+protected:
+    ChannelData channels() {
+        ChannelData ch;
+        for (size_t i = 0; i < CRSF_MAX_CHANNELS; i++) {
+            ch[i] = static_cast<int16_t>(CRSF_CHANNEL_MIN + 100 * i);
+        }
+        return ch;
+    }
+
+    TransformStep step(TransformStep::Op op, std::vector<int> chs) {
+        TransformStep s;
+        s.op = op;
+        s.channels = std::move(chs);
+        return s;
+    }
+
+    ChannelData run(const TransformConfig& steps, ChannelData ch) {
+        ChannelTransform transform;
+        transform.compile(steps);
+        transform.apply(ch);
+        return ch;
+    }
+};
+
+// TRN-001: No steps is the identity
+TEST_F(ChannelTransformTest, Identity) {
+    ChannelTransform transform;
+    transform.compile({});
+    EXPECT_TRUE(transform.isIdentity());
+    EXPECT_EQ(run({}, channels()), channels());
+
+    // An identity remap compiles to the identity too
+    TransformStep remap;
+    remap.op = TransformStep::Op::Remap;
+    for (size_t i = 0; i < CRSF_MAX_CHANNELS; i++) {
+        remap.map[i] = static_cast<int>(i);
+    }
+    transform.compile({remap});
+    EXPECT_TRUE(transform.isIdentity());
+}
+
+// TRN-002: Remap, reverse and override
+TEST_F(ChannelTransformTest, RemapReverseOverride) {
+    TransformStep swap;
+    swap.op = TransformStep::Op::Remap;
+    for (size_t i = 0; i < CRSF_MAX_CHANNELS; i++) {
+        swap.map[i] = static_cast<int>(i);
+    }
+    swap.map[0] = 3;  // Swap CH1 and CH4
+    swap.map[3] = 0;
+
+    auto reverse = step(TransformStep::Op::Reverse, {3});
+    auto override = step(TransformStep::Op::Override, {7});
+    override.value = CRSF_CHANNEL_MAX;
+
+    auto in = channels();
+    auto out = run({swap, reverse, override}, in);
+    EXPECT_EQ(out[0], in[3]);
+    EXPECT_EQ(out[3], CRSF_CHANNEL_MIN + CRSF_CHANNEL_MAX - in[0]);
+    EXPECT_EQ(out[7], CRSF_CHANNEL_MAX);
+    EXPECT_EQ(out[5], in[5]);
+}
+
+// TRN-003: Value steps compose in order and follow a later remap
+TEST_F(ChannelTransformTest, ComposeAndRemap) {
+    auto scale = step(TransformStep::Op::Scale, {2});
+    scale.center = CRSF_CHANNEL_MIN;
+    scale.scale = 0.5;
+    auto offset = step(TransformStep::Op::Scale, {2});
+    offset.offset = 10;
+
+    TransformStep move;
+    move.op = TransformStep::Op::Remap;
+    for (size_t i = 0; i < CRSF_MAX_CHANNELS; i++) {
+        move.map[i] = static_cast<int>(i);
+    }
+    move.map[5] = 2;  // CH6 takes the transformed CH3
+
+    ChannelData in = channels();
+    in[2] = 1172;
+    auto out = run({scale, offset, move}, in);
+    EXPECT_EQ(out[2], 172 + 500 + 10);
+    EXPECT_EQ(out[5], 172 + 500 + 10);
+
+    // Results are clamped to the CRSF range
+    auto big = step(TransformStep::Op::Scale, {0});
+    big.scale = 10;
+    EXPECT_EQ(run({big}, in)[0], CRSF_CHANNEL_MIN);
+    in[0] = 1500;
+    EXPECT_EQ(run({big}, in)[0], CRSF_CHANNEL_MAX);
+}
+
+// TRN-004: Expo keeps center and end points and softens around center
+TEST_F(ChannelTransformTest, Expo) {
+    auto expo = step(TransformStep::Op::Expo, {0});
+    expo.expo = 0.5;
+
+    ChannelData in = channels();
+    in[0] = CRSF_CHANNEL_MID;
+    EXPECT_EQ(run({expo}, in)[0], CRSF_CHANNEL_MID);
+    in[0] = CRSF_CHANNEL_MAX;
+    EXPECT_EQ(run({expo}, in)[0], CRSF_CHANNEL_MAX);
+    in[0] = CRSF_CHANNEL_MIN;
+    EXPECT_EQ(run({expo}, in)[0], CRSF_CHANNEL_MIN);
+
+    in[0] = CRSF_CHANNEL_MID + 200;
+    int16_t out = run({expo}, in)[0];
+    EXPECT_GT(out, CRSF_CHANNEL_MID);
+    EXPECT_LT(out, CRSF_CHANNEL_MID + 200);
+}
+
+// TRN-005: Compiled programs survive copies
+TEST_F(ChannelTransformTest, Copyable) {
+    ChannelTransform transform;
+    transform.compile({step(TransformStep::Op::Reverse, {0, 1})});
+    ChannelTransform copy = transform;
+    transform = ChannelTransform();
+
+    auto in = channels();
+    auto out = in;
+    copy.apply(out);
+    EXPECT_EQ(out[0], CRSF_CHANNEL_MIN + CRSF_CHANNEL_MAX - in[0]);
+    EXPECT_EQ(out[1], CRSF_CHANNEL_MIN + CRSF_CHANNEL_MAX - in[1]);
+}
@@ -33,7 +33,7 @@ TEST_F(CliTest, VersionFlagRecognition) {
 
 // CLI-003: Valid commands
 TEST_F(CliTest, ValidCommands) {
-    const char* valid_commands[] = {"play", "validate", "ping", "info", "send"};
+    const char* valid_commands[] = {"play", "validate", "ping", "info", "send", "latency-test", "compress", "probe", "export-crsf", "play-raw", "record-export", "bench-pipeline"};
 
     for (const char* cmd : valid_commands) {
         // All valid commands should be non-empty
@@ -62,6 +62,7 @@ TEST_F(CliTest, ShortOptionMapping) {
         {"-l", "--loop"},
         {"-s", "--speed"},
         {"-n", "--dry-run"},
+        {"-P", "--port"},
     };
 
     for (const auto& m : mappings) {
@@ -90,7 +91,14 @@ TEST_F(CliTest, SubcommandRecognition) {
                strcmp(cmd, "validate") == 0 ||
                strcmp(cmd, "ping") == 0 ||
                strcmp(cmd, "info") == 0 ||
-               strcmp(cmd, "send") == 0;
+               strcmp(cmd, "send") == 0 ||
+               strcmp(cmd, "latency-test") == 0 ||
+               strcmp(cmd, "compress") == 0 ||
+               strcmp(cmd, "probe") == 0 ||
+               strcmp(cmd, "export-crsf") == 0 ||
+               strcmp(cmd, "play-raw") == 0 ||
+               strcmp(cmd, "record-export") == 0 ||
+               strcmp(cmd, "bench-pipeline") == 0;
     };
 
     EXPECT_TRUE(isValidCommand("play"));
@@ -98,6 +106,13 @@ TEST_F(CliTest, SubcommandRecognition) {
     EXPECT_TRUE(isValidCommand("ping"));
     EXPECT_TRUE(isValidCommand("info"));
     EXPECT_TRUE(isValidCommand("send"));
+    EXPECT_TRUE(isValidCommand("latency-test"));
+    EXPECT_TRUE(isValidCommand("compress"));
+    EXPECT_TRUE(isValidCommand("probe"));
+    EXPECT_TRUE(isValidCommand("export-crsf"));
+    EXPECT_TRUE(isValidCommand("play-raw"));
+    EXPECT_TRUE(isValidCommand("record-export"));
+    EXPECT_TRUE(isValidCommand("bench-pipeline"));
     EXPECT_FALSE(isValidCommand("unknown"));
     EXPECT_FALSE(isValidCommand(""));
 }
@@ -139,7 +154,8 @@ TEST_F(CliTest, OptionWithValue) {
         "--history", "--rate", "--speed",
         "--loop-count", "--start-time", "--end-time",
         "--arm-delay", "--timeout", "--count",
-        "--channels", "--duration"
+        "--channels", "--duration", "--port", "--start-at",
+        "--output", "--block-frames", "--input", "--record"
     };
 
     for (const char* opt : options_with_values) {
@@ -152,7 +168,7 @@ TEST_F(CliTest, OptionWithValue) {
 TEST_F(CliTest, BooleanOptions) {
     const char* boolean_options[] = {
         "--verbose", "--quiet", "--loop",
-        "--dry-run", "--strict", "--arm"
+        "--dry-run", "--strict", "--arm", "--pty", "--full", "--no-cache", "--details"
     };
 
     for (const char* opt : boolean_options) {
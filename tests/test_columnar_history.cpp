@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include "history/columnar_history.hpp"
+
+using namespace elrs;
+using namespace elrs::history;
+
+class ColumnarHistoryTest : public ::testing::Test {
+protected:
+    std::vector<HistoryFrame> createFrames(size_t count) {
+        std::vector<HistoryFrame> frames;
+        for (size_t i = 0; i < count; i++) {
+            HistoryFrame frame;
+            frame.timestamp_ms = static_cast<uint32_t>(i * 2);
+            frame.channels.fill(CRSF_CHANNEL_MID);
+            frame.channels[0] = static_cast<int16_t>((i * 37) % 2048);
+            frame.channels[2] = static_cast<int16_t>(CRSF_CHANNEL_MIN + i % 100);
+            frame.channels[4] = CRSF_CHANNEL_MIN;  // constant, non-center
+            frames.push_back(frame);
+        }
+        return frames;
+    }
+};
+
+// COL-001: Round trip is lossless
+TEST_F(ColumnarHistoryTest, RoundTrip) {
+    auto frames = createFrames(1001);
+    auto history = ColumnarHistory::fromFrames(frames);
+
+    ASSERT_EQ(history.size(), frames.size());
+    auto restored = history.toFrames();
+    for (size_t i = 0; i < frames.size(); i++) {
+        ASSERT_EQ(restored[i].timestamp_ms, frames[i].timestamp_ms);
+        ASSERT_EQ(restored[i].channels, frames[i].channels);
+    }
+}
+
+// COL-002: Constant channels are elided
+TEST_F(ColumnarHistoryTest, ConstantChannels) {
+    auto history = ColumnarHistory::fromFrames(createFrames(100));
+
+    EXPECT_FALSE(history.isConstant(0));
+    EXPECT_TRUE(history.isConstant(1));
+    EXPECT_FALSE(history.isConstant(2));
+    EXPECT_TRUE(history.isConstant(4));
+    EXPECT_EQ(history.constantMask(), 0xFFFAu);
+    EXPECT_EQ(history.channel(50, 4), CRSF_CHANNEL_MIN);
+}
+
+// COL-003: Out-of-range values fall back to raw storage
+TEST_F(ColumnarHistoryTest, RawFallback) {
+    auto frames = createFrames(10);
+    frames[3].channels[5] = -100;
+    frames[7].channels[5] = 3000;
+
+    auto history = ColumnarHistory::fromFrames(frames);
+
+    EXPECT_EQ(history.channel(3, 5), -100);
+    EXPECT_EQ(history.channel(7, 5), 3000);
+    EXPECT_EQ(history.channel(0, 5), CRSF_CHANNEL_MID);
+}
+
+// COL-004: Memory is well below row storage
+TEST_F(ColumnarHistoryTest, MemoryFootprint) {
+    auto frames = createFrames(10000);
+    auto history = ColumnarHistory::fromFrames(frames);
+
+    EXPECT_LT(history.memoryBytes() * 3, frames.size() * sizeof(HistoryFrame));
+}
+
+// COL-005: Empty history
+TEST_F(ColumnarHistoryTest, Empty) {
+    auto history = ColumnarHistory::fromFrames({});
+
+    EXPECT_TRUE(history.empty());
+    EXPECT_TRUE(history.toFrames().empty());
+}
+
+// COL-006: Collapsing duplicate frames into keyframes
+TEST_F(ColumnarHistoryTest, CollapseDuplicates) {
+    std::vector<HistoryFrame> frames;
+    for (uint32_t t = 0; t < 3000; t += 2) {
+        HistoryFrame frame{t, {}};
+        frame.channels.fill(CRSF_CHANNEL_MID);
+        frame.channels[2] = (t < 2000) ? CRSF_CHANNEL_MIN : static_cast<int16_t>(CRSF_CHANNEL_MIN + (t - 2000) / 100);
+        frames.push_back(frame);
+    }
+
+    auto history = ColumnarHistory::fromFrames(frames, true);
+
+    // 1 keyframe of padding (throttle step 0 equals it) + 9 throttle steps
+    EXPECT_EQ(history.size(), 10u);
+    EXPECT_EQ(history.sourceFrameCount(), frames.size());
+    EXPECT_EQ(history.timestamp(0), 0u);
+    EXPECT_EQ(history.duration(0), 2100u);
+    EXPECT_EQ(history.timestamp(1), 2100u);
+    EXPECT_EQ(history.endTimestamp(), 2998u);
+    EXPECT_EQ(history.timestamp(9), 2900u);
+    EXPECT_EQ(history.duration(9), 98u);
+}
+
+// COL-007: Change-point index
+TEST_F(ColumnarHistoryTest, ChangePoints) {
+    std::vector<HistoryFrame> frames;
+    for (uint32_t i = 0; i < 200; i++) {
+        HistoryFrame frame{i * 2, {}};
+        frame.channels.fill(CRSF_CHANNEL_MID);
+        frame.channels[0] = (i < 70) ? 500 : (i < 150 ? 600 : 700);
+        frames.push_back(frame);
+    }
+
+    auto history = ColumnarHistory::fromFrames(frames);
+
+    EXPECT_EQ(history.size(), 200u);
+    EXPECT_TRUE(history.isChangePoint(0));
+    EXPECT_FALSE(history.isChangePoint(1));
+    EXPECT_TRUE(history.isChangePoint(70));
+    EXPECT_EQ(history.nextChangePoint(0), 70u);
+    EXPECT_EQ(history.nextChangePoint(70), 150u);
+    EXPECT_EQ(history.nextChangePoint(150), 200u);
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+#include "history/compressed_history.hpp"
+#include "history/history_loader.hpp"
+
+using namespace elrs;
+using namespace elrs::history;
+
+class CompressedHistoryTest : public ::testing::Test {
+protected:
+    std::string test_dir;
+
+    void SetUp() override {
+        test_dir = std::filesystem::temp_directory_path() / "elrs_elrsz_test";
+        std::filesystem::create_directories(test_dir);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(test_dir);
+    }
+
+    // 1500 frames of disarmed padding, then slowly moving sticks
+    std::vector<HistoryFrame> createFrames() {
+        std::vector<HistoryFrame> frames;
+        uint32_t t = 0;
+        for (size_t i = 0; i < 1500; i++, t += 2) {
+            HistoryFrame frame{t, {}};
+            frame.channels.fill(CRSF_CHANNEL_MID);
+            frame.channels[2] = CRSF_CHANNEL_MIN;
+            frames.push_back(frame);
+        }
+        for (size_t i = 0; i < 3000; i++, t += 2) {
+            HistoryFrame frame = frames.back();
+            frame.timestamp_ms = t;
+            frame.channels[0] = static_cast<int16_t>(992 + (i % 40) - 20);
+            frame.channels[2] = static_cast<int16_t>(CRSF_CHANNEL_MIN + i / 10);
+            frame.channels[4] = (i > 100) ? CRSF_CHANNEL_MAX : CRSF_CHANNEL_MIN;
+            frames.push_back(frame);
+        }
+        frames.back().channels[7] = -5;  // out-of-range values survive
+        return frames;
+    }
+
+    void expectSame(const HistoryFrame& a, const HistoryFrame& b) {
+        EXPECT_EQ(a.timestamp_ms, b.timestamp_ms);
+        EXPECT_EQ(a.channels, b.channels);
+    }
+};
+
+// CMP-001: Encode/decode round trip across blocks
+TEST_F(CompressedHistoryTest, RoundTrip) {
+    auto frames = createFrames();
+    auto data = encodeCompressedHistory(frames, 1000);
+
+    CompressedHistoryReader reader;
+    ASSERT_TRUE(reader.openBuffer(data.data(), data.size()).ok());
+    EXPECT_EQ(reader.frameCount(), frames.size());
+    EXPECT_EQ(reader.blockCount(), 5u);
+
+    HistoryFrame frame{};
+    for (const auto& expected : frames) {
+        ASSERT_TRUE(reader.next(frame));
+        expectSame(frame, expected);
+    }
+    EXPECT_FALSE(reader.next(frame));
+    EXPECT_TRUE(reader.error().empty());
+}
+
+// CMP-002: Much smaller than raw frames
+TEST_F(CompressedHistoryTest, CompressionRatio) {
+    auto frames = createFrames();
+    auto data = encodeCompressedHistory(frames);
+
+    EXPECT_LT(data.size() * 10, frames.size() * sizeof(HistoryFrame));
+}
+
+// CMP-003: Seek via block index
+TEST_F(CompressedHistoryTest, Seek) {
+    auto frames = createFrames();
+    auto data = encodeCompressedHistory(frames, 256);
+
+    CompressedHistoryReader reader;
+    ASSERT_TRUE(reader.openBuffer(data.data(), data.size()).ok());
+
+    HistoryFrame frame{};
+    reader.seek(5001);  // between frames 2500 (5000ms) and 2501
+    ASSERT_TRUE(reader.next(frame));
+    expectSame(frame, frames[2500]);
+    ASSERT_TRUE(reader.next(frame));
+    expectSame(frame, frames[2501]);
+
+    reader.seek(1000);  // inside the padding run
+    ASSERT_TRUE(reader.next(frame));
+    expectSame(frame, frames[500]);
+
+    reader.seek(0);
+    ASSERT_TRUE(reader.next(frame));
+    expectSame(frame, frames[0]);
+
+    reader.seek(UINT32_MAX);
+    ASSERT_TRUE(reader.next(frame));
+    expectSame(frame, frames.back());
+}
+
+// CMP-004: Corrupt data is rejected
+TEST_F(CompressedHistoryTest, Corrupt) {
+    auto data = encodeCompressedHistory(createFrames());
+
+    CompressedHistoryReader reader;
+    EXPECT_FALSE(reader.openBuffer(data.data(), 10).ok());
+
+    data.resize(data.size() - 20);
+    EXPECT_FALSE(reader.openBuffer(data.data(), data.size()).ok());
+
+    std::vector<uint8_t> text = {'0', ',', '9', '9', '2'};
+    EXPECT_FALSE(reader.openBuffer(text.data(), text.size()).ok());
+}
+
+// CMP-005: HistoryLoader reads .elrsz files (also without the extension)
+TEST_F(CompressedHistoryTest, LoaderIntegration) {
+    auto frames = createFrames();
+    std::string path = test_dir + "/history.bin";
+    ASSERT_TRUE(saveCompressedHistory(path, frames).ok());
+
+    HistoryLoader loader;
+    auto result = loader.load(path);
+
+    ASSERT_TRUE(result.ok()) << result.message;
+    EXPECT_EQ(loader.getMetadata().format, "elrsz");
+    ASSERT_EQ(result.value.size(), frames.size());
+    expectSame(result.value[4000], frames[4000]);
+}
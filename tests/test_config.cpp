@@ -209,3 +209,188 @@ TEST_F(ConfigTest, NestedObjectMissing) {
     auto defaults = getDefaultConfig();
     EXPECT_EQ(result.value.device_port, defaults.device_port);
 }
+
+// CFG-009: Scheduling placement options
+TEST_F(ConfigTest, SchedulingPlacementOptions) {
+    std::string content = R"({
+        "scheduling": {
+            "realtime": true,
+            "priority": 60,
+            "cpu_affinity": [3],
+            "prefer_isolated_cpus": false,
+            "pin_uart_irq": true,
+            "irq_cpu_affinity": [2, 3],
+            "irq_priority": 70,
+            "timer_slack_ns": 0,
+            "prefault_stack_kb": 256,
+            "prefault_heap_kb": 0
+        }
+    })";
+
+    auto path = createFile("scheduling.json", content);
+    auto result = loadConfig(path);
+
+    ASSERT_TRUE(result.ok());
+    EXPECT_FALSE(result.value.no_realtime);
+    EXPECT_EQ(result.value.realtime.priority, 60);
+    EXPECT_EQ(result.value.realtime.cpu_affinity, (std::vector<int>{3}));
+    EXPECT_FALSE(result.value.realtime.prefer_isolated_cpus);
+    EXPECT_TRUE(result.value.realtime.pin_uart_irq);
+    EXPECT_EQ(result.value.realtime.irq_cpu_affinity, (std::vector<int>{2, 3}));
+    EXPECT_EQ(result.value.realtime.irq_priority, 70);
+    EXPECT_EQ(result.value.realtime.timer_slack_ns, 0);
+    EXPECT_EQ(result.value.realtime.prefault_stack_kb, 256u);
+    EXPECT_EQ(result.value.realtime.prefault_heap_kb, 0u);
+}
+
+// CFG-010: latency-test thresholds
+TEST_F(ConfigTest, LatencyTestThresholds) {
+    std::string content = R"({
+        "latency_test": {
+            "duration_s": 30,
+            "max_p99_us": 150,
+            "max_latency_us": 500,
+            "max_missed_slots": 2
+        }
+    })";
+
+    auto path = createFile("latency.json", content);
+    auto result = loadConfig(path);
+
+    ASSERT_TRUE(result.ok());
+    EXPECT_EQ(result.value.latency_test.duration_s, 30u);
+    EXPECT_EQ(result.value.latency_test.max_p99_us, 150);
+    EXPECT_EQ(result.value.latency_test.max_latency_us, 500);
+    EXPECT_EQ(result.value.latency_test.max_missed_slots, 2u);
+}
+
+// CFG-011: Duplicate-frame collapsing
+TEST_F(ConfigTest, CollapseDuplicates) {
+    auto defaults = getDefaultConfig();
+    EXPECT_TRUE(defaults.playback.collapse_duplicates);
+
+    auto path = createFile("collapse.json", R"({"playback": {"collapse_duplicates": false}})");
+    auto result = loadConfig(path);
+
+    ASSERT_TRUE(result.ok());
+    EXPECT_FALSE(result.value.playback.collapse_duplicates);
+}
+
+// CFG-012: History cache directory
+TEST_F(ConfigTest, HistoryCache) {
+    auto path = createFile("cache.json", R"({"history_cache": {"dir": "/tmp/elrs_cache"}})");
+    auto result = loadConfig(path);
+
+    ASSERT_TRUE(result.ok());
+    EXPECT_TRUE(result.value.history_cache.enabled);
+    EXPECT_EQ(resolveHistoryCacheDir(result.value.history_cache), "/tmp/elrs_cache");
+
+    result.value.history_cache.enabled = false;
+    EXPECT_EQ(resolveHistoryCacheDir(result.value.history_cache), "");
+}
+
+// CFG-013: Flight recorder section
+TEST_F(ConfigTest, Recorder) {
+    auto path = createFile("recorder.json", R"({
+        "recorder": {"path": "/tmp/flight.elrsrec", "ring_records": 4096, "flush_interval_ms": 50}
+    })");
+    auto result = loadConfig(path);
+
+    ASSERT_TRUE(result.ok());
+    EXPECT_EQ(result.value.record_path, "/tmp/flight.elrsrec");
+    EXPECT_EQ(result.value.recorder.ring_records, 4096u);
+    EXPECT_EQ(result.value.recorder.flush_interval_ms, 50u);
+
+    EXPECT_TRUE(getDefaultConfig().record_path.empty());
+}
+
+// CFG-014: Failsafe watchdog options
+TEST_F(ConfigTest, Watchdog) {
+    auto path = createFile("watchdog.json", R"({
+        "safety": {"failsafe_timeout_ms": 200, "watchdog": {"enabled": false, "interval_ms": 20, "priority": 70}}
+    })");
+    auto result = loadConfig(path);
+
+    ASSERT_TRUE(result.ok());
+    EXPECT_EQ(result.value.safety.failsafe_timeout_ms, 200u);
+    EXPECT_FALSE(result.value.watchdog.enabled);
+    EXPECT_EQ(result.value.watchdog.interval_ms, 20u);
+    EXPECT_EQ(result.value.watchdog.priority, 70);
+    EXPECT_TRUE(getDefaultConfig().watchdog.enabled);
+}
+
+// CFG-015: Per-channel limits
+TEST_F(ConfigTest, ChannelLimits) {
+    auto path = createFile("limits.json", R"({
+        "safety": {"limits": [
+            {"channel": 3, "min": 172, "max": 1700, "max_delta_per_ms": 2.5, "deadband": 4}
+        ]}
+    })");
+    auto result = loadConfig(path);
+
+    ASSERT_TRUE(result.ok());
+    const auto& limit = result.value.safety.limits[2];
+    EXPECT_EQ(limit.min, 172);
+    EXPECT_EQ(limit.max, 1700);
+    EXPECT_FLOAT_EQ(limit.max_delta_per_ms, 2.5f);
+    EXPECT_EQ(limit.deadband, 4);
+    EXPECT_FALSE(result.value.safety.limits[0].active());
+    EXPECT_FALSE(getDefaultConfig().safety.limits[2].active());
+
+    auto bad_channel = createFile("limits_bad.json", R"({
+        "safety": {"limits": [{"channel": 17, "max": 1000}]}
+    })");
+    EXPECT_EQ(loadConfig(bad_channel).error, ErrorCode::ConfigError);
+
+    auto bad_range = createFile("limits_range.json", R"({
+        "safety": {"limits": [{"channel": 1, "min": 1500, "max": 1000}]}
+    })");
+    EXPECT_EQ(loadConfig(bad_range).error, ErrorCode::ConfigError);
+}
+
+// CFG-016: Channel transforms
+TEST_F(ConfigTest, Transforms) {
+    auto path = createFile("transforms.json", R"({
+        "transforms": [
+            {"op": "remap", "map": [4, 2, 3, 1, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16]},
+            {"op": "reverse", "channel": 4},
+            {"op": "scale", "channel": 3, "scale": 0.8, "center": 172},
+            {"op": "expo", "channels": [1, 2], "expo": 0.3},
+            {"op": "override", "channel": 8, "value": 1811}
+        ]
+    })");
+    auto result = loadConfig(path);
+
+    ASSERT_TRUE(result.ok()) << result.message;
+    const auto& steps = result.value.transforms;
+    ASSERT_EQ(steps.size(), 5u);
+    EXPECT_EQ(steps[0].op, playback::TransformStep::Op::Remap);
+    EXPECT_EQ(steps[0].map[0], 3);
+    EXPECT_EQ(steps[1].channels, std::vector<int>{3});
+    EXPECT_DOUBLE_EQ(steps[2].scale, 0.8);
+    EXPECT_DOUBLE_EQ(steps[2].center, 172.0);
+    EXPECT_EQ(steps[3].channels, (std::vector<int>{0, 1}));
+    EXPECT_EQ(steps[4].value, 1811);
+    EXPECT_TRUE(getDefaultConfig().transforms.empty());
+
+    auto bad_op = createFile("transforms_op.json", R"({"transforms": [{"op": "mix", "channel": 1}]})");
+    EXPECT_EQ(loadConfig(bad_op).error, ErrorCode::ConfigError);
+    auto bad_map = createFile("transforms_map.json", R"({"transforms": [{"op": "remap", "map": [1, 2]}]})");
+    EXPECT_EQ(loadConfig(bad_map).error, ErrorCode::ConfigError);
+    auto bad_expo = createFile("transforms_expo.json",
+                               R"({"transforms": [{"op": "expo", "channel": 1, "expo": 2}]})");
+    EXPECT_EQ(loadConfig(bad_expo).error, ErrorCode::ConfigError);
+}
+
+// CFG-017: Stack prefault size is range-checked
+TEST_F(ConfigTest, PrefaultStackRange) {
+    auto path = createFile("stack.json", R"({"scheduling": {"prefault_stack_kb": 1024}})");
+    auto result = loadConfig(path);
+    ASSERT_TRUE(result.ok()) << result.message;
+    EXPECT_EQ(result.value.realtime.prefault_stack_kb, 1024u);
+
+    auto too_large = createFile("stack_large.json", R"({"scheduling": {"prefault_stack_kb": 65536}})");
+    EXPECT_EQ(loadConfig(too_large).error, ErrorCode::ConfigError);
+    auto negative = createFile("stack_negative.json", R"({"scheduling": {"prefault_stack_kb": -1}})");
+    EXPECT_EQ(loadConfig(negative).error, ErrorCode::ConfigError);
+}
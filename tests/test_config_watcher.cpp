@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#include "config/config_watcher.hpp"
+
+using namespace elrs;
+using namespace elrs::config;
+
+class ConfigWatcherTest : public ::testing::Test {
+protected:
+    std::string test_dir;
+    std::string path;
+
+    void SetUp() override {
+        test_dir = std::filesystem::temp_directory_path() / "elrs_config_watcher_test";
+        std::filesystem::create_directories(test_dir);
+        path = test_dir + "/config.json";
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(test_dir);
+    }
+
+    void writeConfig(const std::string& content) {
+        std::ofstream file(path, std::ios::trunc);
+        file << content;
+    }
+
+    static std::string configJson(uint32_t failsafe_timeout_ms, int baudrate = 921600) {
+        return R"({
+            "device": { "port": "/dev/ttyUSB0", "baudrate": )" + std::to_string(baudrate) + R"( },
+            "safety": { "failsafe_timeout_ms": )" + std::to_string(failsafe_timeout_ms) + R"( },
+            "reload": { "debounce_ms": 20 },
+            "logging": { "level": "info" }
+        })";
+    }
+
+    AppConfig load() {
+        auto result = loadConfig(path);
+        EXPECT_TRUE(result.ok()) << result.message;
+        return result.value;
+    }
+};
+
+// RLD-001: Restart-only keys are reported, reloadable ones are not
+TEST_F(ConfigWatcherTest, RestartRequiredChanges) {
+    AppConfig before = getDefaultConfig();
+    AppConfig after = before;
+    after.safety.failsafe_timeout_ms = 1000;
+    after.safety.limits[0].max = 1500;
+    after.log_level = "debug";
+    playback::TransformStep reverse;
+    reverse.op = playback::TransformStep::Op::Reverse;
+    reverse.channels = {0};
+    after.transforms.push_back(reverse);
+    EXPECT_TRUE(restartRequiredChanges(before, after).empty());
+
+    after.device_port = "/dev/ttyUSB1";
+    after.baudrate = 115200;
+    after.safety.arm_channel = 6;
+    auto changes = restartRequiredChanges(before, after);
+    ASSERT_EQ(changes.size(), 3u);
+    EXPECT_EQ(changes[0], "device.port");
+    EXPECT_EQ(changes[1], "device.baudrate");
+    EXPECT_EQ(changes[2], "safety.arm_channel");
+
+    // Playback options other than the rate are fixed at start too
+    AppConfig looped = before;
+    looped.playback.loop = true;
+    looped.playback.reverse = true;
+    looped.playback.speed = 2.0;
+    looped.playback.end_time_ms = 1000;
+    changes = restartRequiredChanges(before, looped);
+    ASSERT_EQ(changes.size(), 4u);
+    EXPECT_EQ(changes[0], "playback.loop");
+    EXPECT_EQ(changes[1], "playback.reverse");
+    EXPECT_EQ(changes[2], "playback.speed");
+    EXPECT_EQ(changes[3], "playback.range");
+}
+
+// RLD-002: A valid change publishes a new snapshot
+TEST_F(ConfigWatcherTest, ReloadPublishesSnapshot) {
+    writeConfig(configJson(500));
+    ConfigWatcher watcher;
+    ASSERT_TRUE(watcher.start(load()).ok());
+    uint64_t generation = watcher.generation();
+    EXPECT_EQ(watcher.current()->safety.failsafe_timeout_ms, 500u);
+
+    writeConfig(configJson(800));
+    EXPECT_TRUE(watcher.reload());
+    EXPECT_EQ(watcher.generation(), generation + 1);
+    EXPECT_EQ(watcher.current()->generation, watcher.generation());
+    EXPECT_EQ(watcher.current()->safety.failsafe_timeout_ms, 800u);
+    EXPECT_EQ(watcher.reloads(), 1u);
+}
+
+// RLD-003: Restart-only changes and invalid files are rejected as a whole
+TEST_F(ConfigWatcherTest, RejectsRestartOnlyAndInvalid) {
+    writeConfig(configJson(500));
+    ConfigWatcher watcher;
+    ASSERT_TRUE(watcher.start(load()).ok());
+    uint64_t generation = watcher.generation();
+
+    writeConfig(configJson(800, 115200));
+    EXPECT_FALSE(watcher.reload());
+    writeConfig("{ not json");
+    EXPECT_FALSE(watcher.reload());
+
+    EXPECT_EQ(watcher.generation(), generation);
+    EXPECT_EQ(watcher.current()->safety.failsafe_timeout_ms, 500u);
+    EXPECT_EQ(watcher.rejected(), 2u);
+}
+
+// RLD-004: Command-line overrides are not restart-only changes
+TEST_F(ConfigWatcherTest, OverridesKeptAcrossReload) {
+    writeConfig(configJson(500));
+    AppConfig running = load();
+    running.playback.rate_hz = 250.0;
+    running.safety.arm_delay_ms = 100;
+    ConfigWatcher watcher;
+    ASSERT_TRUE(watcher.start(running).ok());
+
+    writeConfig(configJson(700));
+    EXPECT_TRUE(watcher.reload());
+    // Reloadable fields come from the file
+    EXPECT_EQ(watcher.current()->safety.arm_delay_ms, 3000u);
+    EXPECT_EQ(watcher.current()->safety.failsafe_timeout_ms, 700u);
+}
+
+// RLD-005: The watch thread picks up a file replaced by rename
+TEST_F(ConfigWatcherTest, WatchThreadDetectsChange) {
+    writeConfig(configJson(500));
+    ConfigWatcher watcher;
+    ASSERT_TRUE(watcher.start(load()).ok());
+    auto held = watcher.current();  // A reader still using the first snapshot
+
+    std::string temp = test_dir + "/config.json.tmp";
+    {
+        std::ofstream file(temp);
+        file << configJson(900);
+    }
+    std::filesystem::rename(temp, path);
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(3);
+    while (watcher.current()->safety.failsafe_timeout_ms != 900u &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(watcher.current()->safety.failsafe_timeout_ms, 900u);
+    EXPECT_EQ(held->safety.failsafe_timeout_ms, 500u);
+    watcher.stop();
+}
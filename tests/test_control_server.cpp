@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "control/control_server.hpp"
+
+using namespace elrs;
+using namespace elrs::control;
+
+class ControlServerTest : public ::testing::Test {
+protected:
+    std::string socket_path;
+
+    void SetUp() override {
+        socket_path = (std::filesystem::temp_directory_path() / "elrs_control_test.sock").string();
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(socket_path);
+    }
+
+    // Send one request and read until the final "ok"/"error" line
+    std::string request(int fd, const std::string& line) {
+        std::string message = line + "\n";
+        EXPECT_EQ(::write(fd, message.data(), message.size()),
+                  static_cast<ssize_t>(message.size()));
+        std::string response;
+        char buffer[256];
+        while (true) {
+            ssize_t n = ::read(fd, buffer, sizeof(buffer));
+            if (n <= 0) {
+                break;
+            }
+            response.append(buffer, static_cast<size_t>(n));
+            size_t last = response.rfind('\n', response.size() - 2);
+            std::string tail = response.substr(last == std::string::npos ? 0 : last + 1);
+            if (tail.rfind("ok", 0) == 0 || tail.rfind("error", 0) == 0) {
+                break;
+            }
+        }
+        return response;
+    }
+};
+
+// CTL-001: Command queue is FIFO and bounded
+TEST_F(ControlServerTest, CommandQueue) {
+    ControlChannel channel("port");
+    ControlCommand command;
+    EXPECT_FALSE(channel.pop(command));
+
+    for (size_t i = 0; i < ControlChannel::QUEUE_CAPACITY; i++) {
+        command.type = ControlCommand::Type::Seek;
+        command.time_ms = static_cast<uint32_t>(i);
+        EXPECT_TRUE(channel.push(command));
+    }
+    EXPECT_EQ(channel.available(), 0u);
+    EXPECT_FALSE(channel.push(command));
+
+    for (size_t i = 0; i < ControlChannel::QUEUE_CAPACITY; i++) {
+        ASSERT_TRUE(channel.pop(command));
+        EXPECT_EQ(command.time_ms, i);
+    }
+    EXPECT_FALSE(channel.pop(command));
+}
+
+// CTL-002: Requests are parsed and queued on every port
+TEST_F(ControlServerTest, HandleRequest) {
+    ControlChannel a("a");
+    ControlChannel b("b");
+    ControlServer server;
+    ASSERT_TRUE(server.start(socket_path, {&a, &b}).ok());
+
+    EXPECT_EQ(server.handleRequest("seek 1500"), "ok");
+    EXPECT_EQ(server.handleRequest("speed 0.5"), "ok");
+    EXPECT_EQ(server.handleRequest("loop on 3"), "ok");
+    EXPECT_EQ(server.handleRequest("seek"), "error usage: seek <ms>");
+    EXPECT_EQ(server.handleRequest("speed -1").rfind("error", 0), 0u);
+    EXPECT_EQ(server.handleRequest("jump").rfind("error", 0), 0u);
+    EXPECT_EQ(server.handleRequest("loop on 3x"), "error usage: loop on [count] | loop off");
+    EXPECT_EQ(server.handleRequest("loop on -1"), "error usage: loop on [count] | loop off");
+    EXPECT_EQ(server.handleRequest("loop on 2 5"), "error usage: loop on [count] | loop off");
+    EXPECT_EQ(server.handleRequest("loop off 2"), "error usage: loop on [count] | loop off");
+    EXPECT_EQ(server.handleRequest("seek 100abc"), "error usage: seek <ms>");
+    EXPECT_EQ(server.handleRequest("seek 100 200"), "error usage: seek <ms>");
+    EXPECT_EQ(server.handleRequest("seek -5"), "error usage: seek <ms>");
+    EXPECT_EQ(server.handleRequest("speed 2x").rfind("error usage: speed", 0), 0u);
+    EXPECT_EQ(server.handleRequest("speed 2 3").rfind("error usage: speed", 0), 0u);
+    EXPECT_EQ(server.handleRequest("speed nan").rfind("error usage: speed", 0), 0u);
+
+    for (auto* channel : {&a, &b}) {
+        ControlCommand command;
+        ASSERT_TRUE(channel->pop(command));
+        EXPECT_EQ(command.type, ControlCommand::Type::Seek);
+        EXPECT_EQ(command.time_ms, 1500u);
+        ASSERT_TRUE(channel->pop(command));
+        EXPECT_EQ(command.type, ControlCommand::Type::Speed);
+        EXPECT_EQ(command.speed, 0.5);
+        ASSERT_TRUE(channel->pop(command));
+        EXPECT_EQ(command.type, ControlCommand::Type::Loop);
+        EXPECT_TRUE(command.loop);
+        EXPECT_EQ(command.loop_count, 3);
+        EXPECT_FALSE(channel->pop(command));
+    }
+
+    // A full queue on one port rejects the command for every port
+    ControlCommand filler;
+    while (b.available() > 0) {
+        ASSERT_TRUE(b.push(filler));
+    }
+    EXPECT_EQ(server.handleRequest("pause"), "error command queue full on b");
+    ControlCommand command;
+    EXPECT_FALSE(a.pop(command));
+}
+
+// CTL-003: Status reads are consistent while the sender publishes
+TEST_F(ControlServerTest, StatusSeqlock) {
+    ControlChannel channel("port");
+    std::atomic<bool> done{false};
+
+    std::thread writer([&] {
+        for (uint64_t i = 1; i <= 200000; i++) {
+            auto& status = channel.status();
+            status.frames_sent = i;
+            status.missed_slots = i;
+            status.telemetry_bytes = i;
+            status.playback_time_ms = static_cast<uint32_t>(i);
+            channel.publishStatus();
+        }
+        done = true;
+    });
+
+    uint64_t last = 0;
+    while (!done) {
+        ControlStatus status = channel.readStatus();
+        ASSERT_EQ(status.missed_slots, status.frames_sent);
+        ASSERT_EQ(status.telemetry_bytes, status.frames_sent);
+        ASSERT_EQ(status.playback_time_ms, static_cast<uint32_t>(status.frames_sent));
+        ASSERT_GE(status.frames_sent, last);
+        last = status.frames_sent;
+    }
+    writer.join();
+    EXPECT_EQ(channel.readStatus().frames_sent, 200000u);
+}
+
+// CTL-004: Commands reach playback through the socket
+TEST_F(ControlServerTest, SocketToPlayback) {
+    std::vector<HistoryFrame> frames(50);
+    for (size_t i = 0; i < frames.size(); i++) {
+        frames[i].timestamp_ms = static_cast<uint32_t>(i * 20);
+        frames[i].channels.fill(CRSF_CHANNEL_MID);
+    }
+    playback::PlaybackController playback;
+    playback.setFrames(frames);
+    playback::PlaybackOptions options;
+    options.rate_hz = 100;
+    playback.setOptions(options);
+    playback.start();
+    safety::SafetyMonitor monitor;
+
+    ControlChannel channel("/dev/ttyTEST");
+    ControlServer server;
+    ASSERT_TRUE(server.start(socket_path, {&channel}).ok());
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_GE(fd, 0);
+    struct sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+    ASSERT_EQ(::connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)), 0);
+
+    EXPECT_EQ(request(fd, "pause"), "ok\n");
+    EXPECT_EQ(request(fd, "seek 400"), "ok\n");
+    applyCommands(channel, playback);
+    publishStatus(channel, playback, monitor);
+    EXPECT_EQ(playback.getState(), PlaybackState::Paused);
+    EXPECT_EQ(playback.getPlaybackTimeMs(), 400u);
+
+    std::string stats = request(fd, "stats");
+    EXPECT_NE(stats.find("port=/dev/ttyTEST state=paused"), std::string::npos) << stats;
+    EXPECT_NE(stats.find("time_ms=400"), std::string::npos) << stats;
+    EXPECT_EQ(stats.substr(stats.size() - 3), "ok\n");
+
+    ::close(fd);
+    server.stop();
+    EXPECT_FALSE(std::filesystem::exists(socket_path));
+}
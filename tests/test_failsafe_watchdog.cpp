@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "crsf/crsf.hpp"
+#include "safety/failsafe_watchdog.hpp"
+
+using namespace elrs;
+using namespace elrs::safety;
+
+class FailsafeWatchdogTest : public ::testing::Test {
+protected:
+    SafetyMonitor monitor;
+    WatchdogOptions options;
+    int pty_master = -1;
+    std::string pty_slave;
+
+    void SetUp() override {
+        SafetyConfig config;
+        config.failsafe_timeout_ms = 50;
+        monitor.setConfig(config);
+        options.interval_ms = 5;
+
+        pty_master = posix_openpt(O_RDWR | O_NOCTTY);
+        ASSERT_GE(pty_master, 0);
+        ASSERT_EQ(grantpt(pty_master), 0);
+        ASSERT_EQ(unlockpt(pty_master), 0);
+        pty_slave = ptsname(pty_master);
+
+        // Raw mode so frame bytes pass through unchanged
+        int slave = open(pty_slave.c_str(), O_RDWR | O_NOCTTY);
+        ASSERT_GE(slave, 0);
+        struct termios tio{};
+        tcgetattr(slave, &tio);
+        cfmakeraw(&tio);
+        tcsetattr(slave, TCSANOW, &tio);
+        close(slave);
+    }
+
+    void TearDown() override {
+        if (pty_master >= 0) close(pty_master);
+    }
+
+    std::vector<uint8_t> readAvailable(int timeout_ms) {
+        std::vector<uint8_t> data;
+        uint8_t buf[256];
+        struct pollfd pfd{};
+        pfd.fd = pty_master;
+        pfd.events = POLLIN;
+        while (poll(&pfd, 1, timeout_ms) > 0) {
+            ssize_t n = read(pty_master, buf, sizeof(buf));
+            if (n <= 0) break;
+            data.insert(data.end(), buf, buf + n);
+            timeout_ms = 0;
+        }
+        return data;
+    }
+
+    void beatFor(FailsafeWatchdog& watchdog, int ms) {
+        auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+        while (std::chrono::steady_clock::now() < end) {
+            watchdog.heartbeat();
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+};
+
+// WDG-001: No takeover before the first heartbeat or while beating
+TEST_F(FailsafeWatchdogTest, NoTakeoverWhileAlive) {
+    FailsafeWatchdog watchdog;
+    ASSERT_TRUE(watchdog.start(monitor, pty_slave, options).ok());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));  // Not started yet
+    beatFor(watchdog, 100);
+    watchdog.stop();
+
+    EXPECT_TRUE(watchdog.senderOwnsPort());
+    EXPECT_EQ(watchdog.getStats().takeovers, 0u);
+    EXPECT_EQ(monitor.getState(), SafetyState::Disarmed);
+    EXPECT_TRUE(readAvailable(10).empty());
+}
+
+// WDG-002: Stalled sender -> watchdog owns the port and sends failsafe frames
+TEST_F(FailsafeWatchdogTest, TakeoverOnStall) {
+    FailsafeWatchdog watchdog;
+    ASSERT_TRUE(watchdog.start(monitor, pty_slave, options).ok());
+
+    watchdog.heartbeat();
+    auto stall_start = std::chrono::steady_clock::now();
+    while (watchdog.senderOwnsPort() &&
+           std::chrono::steady_clock::now() - stall_start < std::chrono::seconds(1)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    auto detect_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - stall_start).count();
+
+    ASSERT_FALSE(watchdog.senderOwnsPort());
+    EXPECT_GE(detect_ms, 45);
+    EXPECT_LT(detect_ms, 200);
+    EXPECT_EQ(monitor.getState(), SafetyState::Failsafe);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    watchdog.stop();
+
+    auto data = readAvailable(50);
+    ASSERT_GE(data.size(), static_cast<size_t>(CRSF_RC_FRAME_SIZE));
+    auto expected = crsf::buildRcChannelsFrame(monitor.getFailsafeChannels());
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), data.begin()));
+    EXPECT_EQ(data.size() % CRSF_RC_FRAME_SIZE, 0u);
+    EXPECT_EQ(watchdog.getStats().takeovers, 1u);
+    EXPECT_EQ(watchdog.getStats().failsafe_frames, data.size() / CRSF_RC_FRAME_SIZE);
+}
+
+// WDG-003: Port is handed back when the heartbeat resumes
+TEST_F(FailsafeWatchdogTest, HandBackOnResume) {
+    FailsafeWatchdog watchdog;
+    ASSERT_TRUE(watchdog.start(monitor, "", options).ok());  // Detect only
+
+    watchdog.heartbeat();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_FALSE(watchdog.senderOwnsPort());
+
+    beatFor(watchdog, 30);
+    EXPECT_TRUE(watchdog.senderOwnsPort());
+
+    // Emergency stop is never overridden by the watchdog
+    monitor.emergencyStop();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    watchdog.stop();
+    EXPECT_EQ(monitor.getState(), SafetyState::EmergencyStop);
+    EXPECT_EQ(watchdog.getStats().takeovers, 2u);
+    EXPECT_GE(watchdog.getStats().max_stall_ms, 50u);
+}
+
+// WDG-004: Takeover frames are recorded in the flight recorder
+TEST_F(FailsafeWatchdogTest, RecordsTakeoverFrames) {
+    std::string path = (std::filesystem::temp_directory_path() / "elrs_watchdog_test.elrsrec").string();
+    recorder::FlightRecorder recorder;
+    recorder::FlightRecorderOptions recorder_options;
+    recorder_options.flush_interval_ms = 1;
+    ASSERT_TRUE(recorder.open(path, recorder_options).ok());
+
+    FailsafeWatchdog watchdog;
+    ASSERT_TRUE(watchdog.start(monitor, pty_slave, options, &recorder).ok());
+    watchdog.heartbeat();
+    std::this_thread::sleep_for(std::chrono::milliseconds(120));
+    watchdog.stop();
+    recorder.close();
+
+    auto frames_written = watchdog.getStats().failsafe_frames;
+    ASSERT_GT(frames_written, 0u);
+
+    recorder::FlightRecordReader reader;
+    ASSERT_TRUE(reader.open(path).ok());
+    ASSERT_EQ(reader.size(), frames_written);
+    recorder::FlightRecord record{};
+    reader.read(0, record);
+    EXPECT_EQ(record.flags, recorder::FLIGHT_RECORD_WATCHDOG);
+    EXPECT_EQ(record.safety_state, static_cast<uint8_t>(SafetyState::Failsafe));
+    EXPECT_EQ(record.channels, monitor.getFailsafeChannels());
+    EXPECT_GT(record.send_time_ns, 0u);
+    std::filesystem::remove(path);
+}
+
+// WDG-005: A sender that finished is not treated as stalled
+TEST_F(FailsafeWatchdogTest, NoTakeoverAfterSenderDone) {
+    FailsafeWatchdog watchdog;
+    ASSERT_TRUE(watchdog.start(monitor, pty_slave, options).ok());
+
+    beatFor(watchdog, 30);
+    watchdog.senderDone();
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));  // 3x the timeout
+    EXPECT_TRUE(watchdog.isRunning());
+    watchdog.stop();
+
+    EXPECT_TRUE(watchdog.senderOwnsPort());
+    EXPECT_EQ(watchdog.getStats().takeovers, 0u);
+    EXPECT_EQ(watchdog.getStats().failsafe_frames, 0u);
+    EXPECT_EQ(monitor.getState(), SafetyState::Disarmed);
+    EXPECT_TRUE(readAvailable(10).empty());
+}
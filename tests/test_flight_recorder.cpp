@@ -0,0 +1,268 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#include "history/history_loader.hpp"
+#include "recorder/flight_recorder.hpp"
+#include "safety/safety_monitor.hpp"
+
+using namespace elrs;
+using namespace elrs::recorder;
+
+class FlightRecorderTest : public ::testing::Test {
+protected:
+    std::string test_dir;
+
+    void SetUp() override {
+        test_dir = std::filesystem::temp_directory_path() / "elrs_recorder_test";
+        std::filesystem::create_directories(test_dir);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(test_dir);
+    }
+
+    FlightRecord makeRecord(uint64_t slot) {
+        FlightRecord record{};
+        record.send_time_ns = 1000000000ULL + slot * 2000000ULL;  // 500Hz
+        record.slot = slot;
+        record.playback_time_ms = static_cast<uint32_t>(slot * 2);
+        record.safety_state = static_cast<uint8_t>(safety::SafetyState::Armed);
+        record.channels.fill(CRSF_CHANNEL_MID);
+        record.channels[2] = static_cast<int16_t>(CRSF_CHANNEL_MIN + slot);
+        record.telemetry_size = 3;
+        record.telemetry[0] = 0xC8;
+        record.telemetry[1] = 0x01;
+        record.telemetry[2] = static_cast<uint8_t>(slot);
+        return record;
+    }
+};
+
+// REC-001: Records round-trip through the ring and file
+TEST_F(FlightRecorderTest, RecordAndRead) {
+    std::string path = test_dir + "/a.elrsrec";
+    FlightRecorderOptions options;
+    options.ring_records = 64;
+    options.flush_interval_ms = 1;
+
+    FlightRecorder recorder;
+    ASSERT_TRUE(recorder.open(path, options).ok());
+    for (uint64_t slot = 0; slot < 200; slot++) {
+        while (!recorder.record(makeRecord(slot))) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    recorder.close();
+    EXPECT_EQ(recorder.flushed(), 200u);
+
+    FlightRecordReader reader;
+    ASSERT_TRUE(reader.open(path).ok());
+    ASSERT_EQ(reader.size(), 200u);
+    EXPECT_EQ(reader.dropped(), recorder.dropped());  // Retried records
+
+    FlightRecord record{};
+    for (size_t i = 0; i < reader.size(); i++) {
+        reader.read(i, record);
+        EXPECT_EQ(record.slot, i);
+        EXPECT_EQ(record.channels[2], CRSF_CHANNEL_MIN + static_cast<int>(i));
+        EXPECT_EQ(record.telemetry[2], static_cast<uint8_t>(i));
+    }
+}
+
+// REC-002: A full ring drops records instead of blocking
+TEST_F(FlightRecorderTest, DropWhenFull) {
+    std::string path = test_dir + "/b.elrsrec";
+    FlightRecorderOptions options;
+    options.ring_records = 5;           // Rounded up to 8
+    options.flush_interval_ms = 60000;  // Only close() flushes
+
+    FlightRecorder recorder;
+    ASSERT_TRUE(recorder.open(path, options).ok());
+    size_t accepted = 0;
+    for (uint64_t slot = 0; slot < 20; slot++) {
+        if (recorder.record(makeRecord(slot))) accepted++;
+    }
+    EXPECT_EQ(accepted, 8u);
+    EXPECT_EQ(recorder.dropped(), 12u);
+    recorder.close();
+
+    FlightRecordReader reader;
+    ASSERT_TRUE(reader.open(path).ok());
+    EXPECT_EQ(reader.size(), 8u);
+    EXPECT_EQ(reader.dropped(), 12u);
+}
+
+// REC-003: Recording converts back into a loadable history CSV
+TEST_F(FlightRecorderTest, ConvertToHistoryCsv) {
+    std::string path = test_dir + "/c.elrsrec";
+    std::string csv = test_dir + "/c.csv";
+    {
+        FlightRecorder recorder;
+        ASSERT_TRUE(recorder.open(path, {}).ok());
+        for (uint64_t slot = 0; slot < 50; slot++) {
+            recorder.record(makeRecord(slot));
+        }
+    }  // Destructor closes
+
+    auto result = convertRecordingToCsv(path, csv);
+    ASSERT_TRUE(result.ok());
+    EXPECT_EQ(result.value, 50u);
+
+    history::HistoryLoader loader;
+    auto frames = loader.load(csv);
+    ASSERT_TRUE(frames.ok()) << frames.message;
+    ASSERT_EQ(frames.value.size(), 50u);
+    EXPECT_EQ(frames.value[0].timestamp_ms, 0u);
+    EXPECT_EQ(frames.value[49].timestamp_ms, 98u);
+    EXPECT_EQ(frames.value[49].channels[2], CRSF_CHANNEL_MIN + 49);
+
+    std::string details = test_dir + "/d.csv";
+    ASSERT_TRUE(convertRecordingToCsv(path, details, true).ok());
+    std::ifstream in(details);
+    std::string header, first;
+    std::getline(in, header);
+    std::getline(in, first);
+    EXPECT_NE(header.find("slot,playback_time_ms,safety_state,flags,telemetry"), std::string::npos);
+    EXPECT_NE(first.find(",0,0,armed,0,c80100"), std::string::npos);
+}
+
+// REC-004: A file cut short (crash) is readable up to the last whole record
+TEST_F(FlightRecorderTest, TruncatedFile) {
+    std::string path = test_dir + "/e.elrsrec";
+    {
+        FlightRecorder recorder;
+        ASSERT_TRUE(recorder.open(path, {}).ok());
+        for (uint64_t slot = 0; slot < 10; slot++) {
+            recorder.record(makeRecord(slot));
+        }
+    }
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 100);
+
+    FlightRecordReader reader;
+    ASSERT_TRUE(reader.open(path).ok());
+    EXPECT_EQ(reader.size(), 9u);
+
+    std::ofstream(test_dir + "/bad.elrsrec") << "not a recording at all, just text....";
+    EXPECT_FALSE(reader.open(test_dir + "/bad.elrsrec").ok());
+}
+
+// REC-005: Two producers (sender and watchdog) record concurrently
+TEST_F(FlightRecorderTest, ConcurrentProducers) {
+    std::string path = test_dir + "/e.elrsrec";
+    FlightRecorderOptions options;
+    options.ring_records = 256;
+    options.flush_interval_ms = 1;
+
+    FlightRecorder recorder;
+    ASSERT_TRUE(recorder.open(path, options).ok());
+    auto produce = [&](uint16_t flags) {
+        for (uint64_t slot = 0; slot < 5000; slot++) {
+            FlightRecord record = makeRecord(slot);
+            record.flags = flags;
+            while (!recorder.record(record)) {
+                std::this_thread::yield();
+            }
+        }
+    };
+    std::thread sender(produce, 0);
+    std::thread watchdog(produce, FLIGHT_RECORD_WATCHDOG);
+    sender.join();
+    watchdog.join();
+    recorder.close();
+
+    FlightRecordReader reader;
+    ASSERT_TRUE(reader.open(path).ok());
+    ASSERT_EQ(reader.size(), 10000u);
+
+    // Each producer's records arrive complete and in its own order
+    uint64_t next[2] = {0, 0};
+    FlightRecord record{};
+    for (size_t i = 0; i < reader.size(); i++) {
+        reader.read(i, record);
+        size_t producer = (record.flags & FLIGHT_RECORD_WATCHDOG) ? 1 : 0;
+        ASSERT_EQ(record.slot, next[producer]);
+        ASSERT_EQ(record.channels[2], CRSF_CHANNEL_MIN + static_cast<int>(record.slot));
+        next[producer]++;
+    }
+    EXPECT_EQ(next[0], 5000u);
+    EXPECT_EQ(next[1], 5000u);
+}
+
+// REC-006: History export keeps sent slot frames only, in send order
+TEST_F(FlightRecorderTest, HistoryCsvIsValid) {
+    std::string path = test_dir + "/e.elrsrec";
+    std::string csv = test_dir + "/e.csv";
+    {
+        FlightRecorder recorder;
+        ASSERT_TRUE(recorder.open(path, {}).ok());
+        recorder.record(makeRecord(0));
+        recorder.record(makeRecord(1));
+
+        // Sender blocked in write: the watchdog's frames land first
+        FlightRecord failsafe = makeRecord(0);
+        failsafe.send_time_ns = makeRecord(3).send_time_ns;
+        failsafe.flags = FLIGHT_RECORD_WATCHDOG;
+        recorder.record(failsafe);
+        recorder.record(makeRecord(2));
+
+        FlightRecord unsent = makeRecord(3);
+        unsent.flags = FLIGHT_RECORD_NOT_SENT;
+        recorder.record(unsent);
+
+        // Two frames within one millisecond (rate above 1kHz)
+        FlightRecord early = makeRecord(4);
+        FlightRecord late = makeRecord(4);
+        late.send_time_ns += 400000;
+        late.channels[0] = CRSF_CHANNEL_MAX;
+        recorder.record(early);
+        recorder.record(late);
+
+        FlightRecord disarm = makeRecord(5);
+        disarm.flags = FLIGHT_RECORD_DISARM;
+        recorder.record(disarm);
+    }
+
+    auto result = convertRecordingToCsv(path, csv);
+    ASSERT_TRUE(result.ok());
+    EXPECT_EQ(result.value, 4u);
+
+    history::HistoryLoader loader;
+    auto frames = loader.load(csv);
+    ASSERT_TRUE(frames.ok()) << frames.message;
+    ASSERT_EQ(frames.value.size(), 4u);
+    auto validation = loader.validate(frames.value, true);
+    EXPECT_TRUE(validation.valid);
+    EXPECT_EQ(validation.non_monotonic.count, 0u);
+    EXPECT_EQ(validation.duplicate_timestamps.count, 0u);
+
+    EXPECT_EQ(frames.value[0].timestamp_ms, 0u);
+    EXPECT_EQ(frames.value[2].timestamp_ms, 4u);
+    EXPECT_EQ(frames.value[2].channels[2], CRSF_CHANNEL_MIN + 2);
+    EXPECT_EQ(frames.value[3].timestamp_ms, 8u);
+    EXPECT_EQ(frames.value[3].channels[0], CRSF_CHANNEL_MAX);
+
+    // Details keep every record, still in send order
+    auto details = convertRecordingToCsv(path, test_dir + "/f.csv", true);
+    ASSERT_TRUE(details.ok());
+    EXPECT_EQ(details.value, 8u);
+
+    // Dry run: nothing was sent, the slot frames are the history
+    std::string dry_path = test_dir + "/g.elrsrec";
+    {
+        FlightRecorder recorder;
+        ASSERT_TRUE(recorder.open(dry_path, {}).ok());
+        for (uint64_t slot = 0; slot < 10; slot++) {
+            FlightRecord dry = makeRecord(slot);
+            dry.flags = FLIGHT_RECORD_NOT_SENT;
+            recorder.record(dry);
+        }
+        FlightRecord disarm = makeRecord(10);
+        disarm.flags = FLIGHT_RECORD_DISARM | FLIGHT_RECORD_NOT_SENT;
+        recorder.record(disarm);
+    }
+    auto dry = convertRecordingToCsv(dry_path, test_dir + "/g.csv");
+    ASSERT_TRUE(dry.ok());
+    EXPECT_EQ(dry.value, 10u);
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include "playback/frame_pipeline.hpp"
+
+using namespace elrs;
+using namespace elrs::playback;
+
+class FramePipelineTest : public ::testing::Test {
+protected:
+    ChannelData sweep(size_t i) {
+        ChannelData ch;
+        for (size_t c = 0; c < CRSF_MAX_CHANNELS; c++) {
+            ch[c] = static_cast<int16_t>(CRSF_CHANNEL_MIN +
+                (i * 37 + c * 211) % (CRSF_CHANNEL_MAX - CRSF_CHANNEL_MIN + 1));
+        }
+        return ch;
+    }
+
+    safety::SafetyConfig safetyConfig(int arm_channel) {
+        safety::SafetyConfig config;
+        config.arm_channel = arm_channel;
+        config.arm_delay_ms = 100;
+        return config;
+    }
+};
+
+// PIP-001: Fixed encoder matches crsf::buildRcChannelsFrame
+TEST_F(FramePipelineTest, EncoderMatchesGeneric) {
+    for (size_t i = 0; i < 200; i++) {
+        ChannelData ch = sweep(i);
+        RcFrame frame;
+        encodeRcFrame16(ch, frame);
+        EXPECT_EQ(frame, crsf::buildRcChannelsFrame(ch)) << "sweep " << i;
+    }
+
+    // Out-of-range values are clamped the same way
+    ChannelData ch;
+    ch.fill(0);
+    ch[3] = 2047;
+    ch[9] = -5;
+    RcFrame frame;
+    encodeRcFrame16(ch, frame);
+    EXPECT_EQ(frame, crsf::buildRcChannelsFrame(ch));
+}
+
+// PIP-002: Specialized instantiation is chosen only for its configuration
+TEST_F(FramePipelineTest, Selection) {
+    safety::SafetyMonitor monitor;
+    monitor.setConfig(safetyConfig(4));
+    EXPECT_STREQ(makeFramePipeline(monitor, nullptr)->name(), "specialized");
+    EXPECT_STREQ(makeFramePipeline(monitor, nullptr, false)->name(), "generic");
+
+    safety::SafetyMonitor other;
+    other.setConfig(safetyConfig(6));
+    EXPECT_STREQ(makeFramePipeline(other, nullptr)->name(), "generic");
+}
+
+// PIP-003: Specialized and generic paths produce identical frames and states
+TEST_F(FramePipelineTest, SpecializedMatchesGeneric) {
+    TransformStep reverse;
+    reverse.op = TransformStep::Op::Reverse;
+    reverse.channels = {0, 2};
+    ChannelTransform transform;
+    transform.compile({reverse});
+
+    for (const ChannelTransform* t : {static_cast<const ChannelTransform*>(nullptr),
+                                      static_cast<const ChannelTransform*>(&transform)}) {
+        safety::SafetyMonitor generic_monitor;
+        safety::SafetyMonitor specialized_monitor;
+        generic_monitor.setConfig(safetyConfig(4));
+        specialized_monitor.setConfig(safetyConfig(4));
+        auto generic = makeFramePipeline(generic_monitor, t, false);
+        auto specialized = makeFramePipeline(specialized_monitor, t);
+        ASSERT_STREQ(specialized->name(), "specialized");
+
+        auto now = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < 300; i++) {
+            ChannelData ch = sweep(i);
+            // Disarmed, then armed through the arm delay, then disarmed
+            ch[4] = (i >= 50 && i < 250) ? CRSF_CHANNEL_MAX : CRSF_CHANNEL_MIN;
+            if (i % 10 == 0 && i > 0) {
+                ch = sweep(i - 1);  // Held keyframe exercises the encode cache
+                ch[4] = (i >= 50 && i < 250) ? CRSF_CHANNEL_MAX : CRSF_CHANNEL_MIN;
+            }
+
+            ChannelData generic_safe;
+            ChannelData specialized_safe;
+            RcFrame g = generic->process(ch, now, generic_safe);
+            RcFrame s = specialized->process(ch, now, specialized_safe);
+            EXPECT_EQ(g, s) << "frame " << i;
+            EXPECT_EQ(generic_safe, specialized_safe) << "frame " << i;
+            EXPECT_EQ(generic_monitor.getState(), specialized_monitor.getState()) << "frame " << i;
+            now += std::chrono::milliseconds(2);
+        }
+        EXPECT_EQ(specialized_monitor.getState(), safety::SafetyState::Disarmed);
+    }
+}
+
+// PIP-004: The fixed safety step uses its compile-time layout
+TEST_F(FramePipelineTest, FixedLayoutSafetyStep) {
+    safety::SafetyMonitor monitor;
+    monitor.setConfig(safetyConfig(4));
+    auto now = std::chrono::steady_clock::now();
+
+    // Disarmed: only the template's throttle channel is forced down
+    ChannelData ch = sweep(7);
+    ch[4] = CRSF_CHANNEL_MIN;
+    ChannelData expected = ch;
+    expected[safety::THROTTLE_CHANNEL] = monitor.getConfig().throttle_min;
+    monitor.processChannelsFixed<4, safety::THROTTLE_CHANNEL>(ch, now);
+    EXPECT_EQ(ch, expected);
+
+    // The arm switch is read at the template's arm index
+    ch[4] = CRSF_CHANNEL_MAX;
+    monitor.processChannelsFixed<4, safety::THROTTLE_CHANNEL>(ch, now);
+    EXPECT_EQ(monitor.getState(), safety::SafetyState::ArmPending);
+}
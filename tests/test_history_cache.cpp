@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "history/history_cache.hpp"
+#include "history/history_loader.hpp"
+
+using namespace elrs;
+using namespace elrs::history;
+
+class HistoryCacheTest : public ::testing::Test {
+protected:
+    std::string test_dir;
+    std::string cache_dir;
+
+    void SetUp() override {
+        test_dir = std::filesystem::temp_directory_path() / "elrs_cache_test";
+        cache_dir = test_dir + "/cache";
+        std::filesystem::create_directories(test_dir);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(test_dir);
+    }
+
+    std::string createFile(const std::string& name, const std::string& content) {
+        std::string path = test_dir + "/" + name;
+        std::ofstream file(path);
+        file << content;
+        return path;
+    }
+
+    void setMtime(const std::string& path, int seconds_ago) {
+        std::filesystem::last_write_time(
+            path, std::filesystem::file_time_type::clock::now() - std::chrono::seconds(seconds_ago));
+    }
+};
+
+// CCH-001: Second load comes from the cache with identical frames
+TEST_F(HistoryCacheTest, WarmLoad) {
+    auto path = createFile("a.csv",
+        "timestamp_ms,ch1,ch2\n0,992,172\n20,1000,180\n40,1811,191\n");
+
+    HistoryLoader cold;
+    cold.setCacheDir(cache_dir);
+    auto first = cold.load(path);
+    ASSERT_TRUE(first.ok());
+    EXPECT_FALSE(cold.getMetadata().from_cache);
+    EXPECT_TRUE(std::filesystem::exists(HistoryCache(cache_dir).entryPath(path)));
+
+    HistoryLoader warm;
+    warm.setCacheDir(cache_dir);
+    auto second = warm.load(path);
+    ASSERT_TRUE(second.ok());
+    EXPECT_TRUE(warm.getMetadata().from_cache);
+    EXPECT_EQ(warm.getMetadata().format, "csv");
+    ASSERT_EQ(second.value.size(), first.value.size());
+    for (size_t i = 0; i < first.value.size(); i++) {
+        EXPECT_EQ(second.value[i].timestamp_ms, first.value[i].timestamp_ms);
+        EXPECT_EQ(second.value[i].channels, first.value[i].channels);
+    }
+}
+
+// CCH-002: Changed source invalidates the entry
+TEST_F(HistoryCacheTest, InvalidatedOnChange) {
+    auto path = createFile("b.csv", "0,992\n20,992\n");
+    setMtime(path, 100);
+
+    HistoryLoader loader;
+    loader.setCacheDir(cache_dir);
+    ASSERT_TRUE(loader.load(path).ok());
+
+    // Same size, different content, new mtime
+    createFile("b.csv", "0,172\n20,172\n");
+    auto result = loader.load(path);
+    ASSERT_TRUE(result.ok());
+    EXPECT_FALSE(loader.getMetadata().from_cache);
+    EXPECT_EQ(result.value[0].channels[0], 172);
+
+    // The entry was refreshed
+    ASSERT_TRUE(loader.load(path).ok());
+    EXPECT_TRUE(loader.getMetadata().from_cache);
+}
+
+// CCH-003: Touched but unchanged source is still served by content hash
+TEST_F(HistoryCacheTest, TouchedSameContent) {
+    auto path = createFile("c.csv", "0,992\n20,992\n");
+    HistoryCache cache(cache_dir);
+    ASSERT_TRUE(cache.store(path, {{0, {}}}, "csv", "").ok());
+
+    setMtime(path, 50);
+    EXPECT_TRUE(cache.lookup(path).ok());
+}
+
+// CCH-004: JSON name is kept; .elrsz and disabled cache are not cached
+TEST_F(HistoryCacheTest, JsonNameAndBypass) {
+    auto path = createFile("d.json", R"({"metadata": {"name": "cached_flight"},
+        "frames": [{"t": 0, "ch": [992]}, {"t": 20, "ch": [992]}]})");
+
+    HistoryLoader loader;
+    loader.setCacheDir(cache_dir);
+    ASSERT_TRUE(loader.load(path).ok());
+    HistoryLoader warm;
+    warm.setCacheDir(cache_dir);
+    ASSERT_TRUE(warm.load(path).ok());
+    EXPECT_TRUE(warm.getMetadata().from_cache);
+    EXPECT_EQ(warm.getMetadata().name, "cached_flight");
+    EXPECT_EQ(warm.getMetadata().format, "json");
+
+    HistoryLoader uncached;
+    auto other = createFile("e.csv", "0,992\n");
+    ASSERT_TRUE(uncached.load(other).ok());
+    EXPECT_FALSE(std::filesystem::exists(HistoryCache(cache_dir).entryPath(other)));
+}
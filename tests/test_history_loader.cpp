@@ -183,6 +183,47 @@ TEST_F(HistoryLoaderTest, JsonMissingFrames) {
     EXPECT_FALSE(result.ok());
 }
 
+// JSON-006: Streaming loader handles alternate keys and unknown fields
+TEST_F(HistoryLoaderTest, JsonAlternateKeysAndExtraFields) {
+    std::string content = R"({
+        "frames": [
+            {"timestamp_ms": 0, "extra": {"nested": [1, [2, 3]]}, "channels": [100, 200]},
+            {"note": "x", "t": 20, "ch": [300, 400, 500]}
+        ],
+        "metadata": {"name": "after_frames", "tags": ["a", "b"]}
+    })";
+
+    auto path = createFile("alt.json", content);
+
+    HistoryLoader loader;
+    auto result = loader.load(path);
+
+    ASSERT_TRUE(result.ok()) << result.message;
+    ASSERT_EQ(result.value.size(), 2u);
+    EXPECT_EQ(result.value[0].channels[1], 200);
+    EXPECT_EQ(result.value[0].channels[2], CRSF_CHANNEL_MID);
+    EXPECT_EQ(result.value[1].timestamp_ms, 20u);
+    EXPECT_EQ(result.value[1].channels[2], 500);
+    EXPECT_EQ(loader.getMetadata().name, "after_frames");
+}
+
+// JSON-007: Frame without timestamp / non-numeric channel
+TEST_F(HistoryLoaderTest, JsonFrameErrors) {
+    HistoryLoader loader;
+
+    auto no_ts = loader.load(createFile("nots.json", R"({"frames": [{"ch": [992]}]})"));
+    EXPECT_FALSE(no_ts.ok());
+    EXPECT_EQ(no_ts.message, "Missing timestamp in frame");
+
+    auto no_ch = loader.load(createFile("noch.json", R"({"frames": [{"t": 0}]})"));
+    EXPECT_FALSE(no_ch.ok());
+    EXPECT_EQ(no_ch.message, "Missing channels in frame");
+
+    auto bad_ch = loader.load(createFile("badch.json", R"({"frames": [{"t": 0, "ch": ["x"]}]})"));
+    EXPECT_FALSE(bad_ch.ok());
+    EXPECT_EQ(bad_ch.error, ErrorCode::HistoryError);
+}
+
 // VAL-001: Value below range
 TEST_F(HistoryLoaderTest, ValidateBelowRange) {
     std::vector<HistoryFrame> frames = {
@@ -297,3 +338,182 @@ TEST_F(HistoryLoaderTest, AutoDetectJson) {
     EXPECT_TRUE(result.ok());
     EXPECT_EQ(loader.getMetadata().format, "json");
 }
+
+// CSV-008: Parallel loader matches sequential loader
+TEST_F(HistoryLoaderTest, CsvParallelMatchesSequential) {
+    std::string content = "timestamp_ms,ch1,ch2,ch3,ch4\n";
+    for (int i = 0; i < 5000; i++) {
+        content += std::to_string(i * 4) + "," + std::to_string(172 + i % 1600) +
+            ",992,-5," + std::to_string(i % 7) + "\r\n";
+        if (i % 97 == 0) {
+            content += "\n";
+        }
+    }
+    auto path = createFile("big.csv", content);
+
+    HistoryLoader sequential;
+    auto expected = sequential.loadCsv(path);
+    ASSERT_TRUE(expected.ok());
+
+    for (size_t threads : {1u, 3u, 8u}) {
+        HistoryLoader parallel;
+        auto result = parallel.loadCsvParallel(path, threads);
+        ASSERT_TRUE(result.ok()) << result.message;
+        ASSERT_EQ(result.value.size(), expected.value.size());
+        for (size_t i = 0; i < result.value.size(); i++) {
+            ASSERT_EQ(result.value[i].timestamp_ms, expected.value[i].timestamp_ms);
+            ASSERT_EQ(result.value[i].channels, expected.value[i].channels);
+        }
+        EXPECT_EQ(parallel.getMetadata().frame_count, 5000u);
+    }
+}
+
+// CSV-009: Parallel loader reports global line numbers
+TEST_F(HistoryLoaderTest, CsvParallelErrorLine) {
+    std::string content = "time,a,b\n";
+    for (int i = 0; i < 3000; i++) {
+        content += (i == 2500) ? "100,992,abc\n" : "100,992,992\n";
+    }
+    auto path = createFile("bad.csv", content);
+
+    HistoryLoader loader;
+    auto result = loader.loadCsvParallel(path, 4);
+
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(result.message, "Line 2502: Invalid channel value");
+}
+
+// CSV-010: Parallel loader with header only
+TEST_F(HistoryLoaderTest, CsvParallelHeaderOnly) {
+    auto path = createFile("header_only.csv", "timestamp_ms,ch1,ch2\n");
+
+    HistoryLoader loader;
+    auto result = loader.loadCsvParallel(path, 4);
+
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(result.error, ErrorCode::HistoryError);
+}
+
+// VAL-006: Findings are aggregated and detailed messages capped
+TEST_F(HistoryLoaderTest, ValidateAggregatesAndCaps) {
+    std::vector<HistoryFrame> frames;
+    for (uint32_t i = 0; i < 1000; i++) {
+        HistoryFrame frame{i * 2, {}};
+        frame.channels.fill(CRSF_CHANNEL_MID);
+        if (i % 10 == 0) {
+            frame.channels[3] = 50;          // below range
+            frame.channels[15] = 2000;       // above range
+        }
+        frames.push_back(frame);
+    }
+    frames[500].timestamp_ms = frames[499].timestamp_ms;  // duplicate
+    frames[700].timestamp_ms = 10;                         // goes backwards
+
+    HistoryLoader loader;
+    auto result = loader.validate(frames, false);
+
+    EXPECT_FALSE(result.valid);
+    EXPECT_EQ(result.out_of_range.count, 100u);
+    EXPECT_EQ(result.out_of_range.first_index, 0u);
+    EXPECT_EQ(result.out_of_range.last_index, 990u);
+    EXPECT_EQ(result.channel_out_of_range[3], 100u);
+    EXPECT_EQ(result.channel_out_of_range[15], 100u);
+    EXPECT_EQ(result.channel_out_of_range[0], 0u);
+    EXPECT_EQ(result.channel_min[3], 50);
+    EXPECT_EQ(result.channel_max[3], CRSF_CHANNEL_MID);
+    EXPECT_EQ(result.channel_max[15], 2000);
+    EXPECT_EQ(result.duplicate_timestamps.count, 1u);
+    EXPECT_EQ(result.non_monotonic.count, 1u);
+    EXPECT_EQ(result.non_monotonic.first_index, 700u);
+
+    // 10 detailed range messages + 1 summary, 1 duplicate message
+    EXPECT_EQ(result.warnings.size(), VALIDATION_MAX_MESSAGES + 2);
+    EXPECT_EQ(result.errors.size(), 1u);
+}
+
+// VAL-007: Gap histogram
+TEST_F(HistoryLoaderTest, ValidateGapHistogram) {
+    std::vector<HistoryFrame> frames;
+    uint32_t t = 0;
+    for (uint32_t gap : {2u, 2u, 2u, 0u, 1u, 5u, 2000u}) {
+        t += gap;
+        HistoryFrame frame{t, {}};
+        frame.channels.fill(CRSF_CHANNEL_MID);
+        frames.push_back(frame);
+    }
+
+    HistoryLoader loader;
+    auto result = loader.validate(frames, false);
+
+    // First frame has no gap; gaps: 2,2,0,1,5,2000
+    EXPECT_EQ(result.gap_histogram[0], 1u);   // 0ms
+    EXPECT_EQ(result.gap_histogram[1], 1u);   // 1ms
+    EXPECT_EQ(result.gap_histogram[2], 2u);   // 2-3ms
+    EXPECT_EQ(result.gap_histogram[3], 1u);   // 4-7ms
+    EXPECT_EQ(result.gap_histogram[VALIDATION_GAP_BUCKETS - 1], 1u);
+}
+
+// PRB-001: Quick CSV probe estimates from head and tail
+TEST_F(HistoryLoaderTest, ProbeCsvQuick) {
+    std::string content = "timestamp_ms,ch1,ch2,ch3,ch4,ch5\n";
+    for (int i = 0; i < 10000; i++) {
+        content += std::to_string(i * 2) + ",992,992,172,992," + (i > 5000 ? "1811" : "992") + "\n";
+    }
+    auto path = createFile("probe.csv", content);
+
+    HistoryLoader loader;
+    auto result = loader.probe(path);
+
+    ASSERT_TRUE(result.ok()) << result.message;
+    EXPECT_TRUE(result.value.estimated);
+    EXPECT_EQ(result.value.format, "csv");
+    EXPECT_EQ(result.value.duration_ms, 19998u);
+    EXPECT_NEAR(static_cast<double>(result.value.frame_count), 10000.0, 200.0);
+    EXPECT_NEAR(result.value.packet_rate_hz, 500.0, 10.0);
+    EXPECT_EQ(result.value.channel_count, 5u);
+}
+
+// PRB-002: Full probe matches load() without keeping frames
+TEST_F(HistoryLoaderTest, ProbeFullScan) {
+    std::string content = "timestamp_ms,ch1,ch2,ch3\n";
+    for (int i = 0; i < 3000; i++) {
+        content += std::to_string(i * 4) + ",992," + std::to_string(172 + i % 7) + ",992\n";
+    }
+    auto path = createFile("full.csv", content);
+
+    HistoryLoader loader;
+    auto probed = loader.probe(path, true);
+    ASSERT_TRUE(probed.ok());
+    ASSERT_TRUE(loader.load(path).ok());
+    const auto& loaded = loader.getMetadata();
+
+    EXPECT_FALSE(probed.value.estimated);
+    EXPECT_EQ(probed.value.frame_count, loaded.frame_count);
+    EXPECT_EQ(probed.value.duration_ms, loaded.duration_ms);
+    EXPECT_DOUBLE_EQ(probed.value.packet_rate_hz, loaded.packet_rate_hz);
+    EXPECT_EQ(probed.value.channel_count, loaded.channel_count);
+}
+
+// PRB-003: JSON probe and small files are exact
+TEST_F(HistoryLoaderTest, ProbeJsonAndSmallCsv) {
+    auto json_path = createFile("probe.json", R"({
+        "metadata": {"name": "probe_me"},
+        "frames": [{"t": 0, "ch": [992]}, {"t": 20, "ch": [992]}, {"t": 40, "ch": [992]}]
+    })");
+    auto csv_path = createFile("small.csv", "0,992\n20,992\n");
+
+    HistoryLoader loader;
+    auto json_result = loader.probe(json_path);
+    ASSERT_TRUE(json_result.ok());
+    EXPECT_EQ(json_result.value.frame_count, 3u);
+    EXPECT_EQ(json_result.value.duration_ms, 40u);
+    EXPECT_EQ(json_result.value.name, "probe_me");
+    EXPECT_FALSE(json_result.value.estimated);
+
+    auto csv_result = loader.probe(csv_path);
+    ASSERT_TRUE(csv_result.ok());
+    EXPECT_EQ(csv_result.value.frame_count, 2u);
+    EXPECT_FALSE(csv_result.value.estimated);
+
+    EXPECT_FALSE(loader.probe(createFile("bad.csv", "0,992\nx,y\n"), true).ok());
+}
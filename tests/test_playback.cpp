@@ -165,6 +165,66 @@ TEST_F(PlaybackTest, GetCurrentFrame) {
     EXPECT_LE(current[0], CRSF_CHANNEL_MAX);
 }
 
+// GET-002: Columnar history is decoded into the current frame
+TEST_F(PlaybackTest, SetHistoryColumnar) {
+    PlaybackController controller;
+    auto frames = createFrames(10);
+    frames[0].channels[7] = 1811;
+    controller.setHistory(history::ColumnarHistory::fromFrames(frames));
+
+    PlaybackOptions options;
+    options.rate_hz = 50;
+    controller.setOptions(options);
+
+    controller.start();
+
+    EXPECT_EQ(controller.getHistory().size(), 10u);
+    EXPECT_EQ(controller.getCurrentFrame(), frames[0].channels);
+}
+
+// GET-003: Collapsed history plays to the original end and holds keyframes
+TEST_F(PlaybackTest, CollapsedHistory) {
+    std::vector<HistoryFrame> frames;
+    for (uint32_t t = 0; t <= 60; t += 2) {
+        HistoryFrame frame{t, {}};
+        frame.channels.fill(CRSF_CHANNEL_MID);
+        frame.channels[2] = (t < 30) ? CRSF_CHANNEL_MIN : CRSF_CHANNEL_MAX;
+        frames.push_back(frame);
+    }
+
+    PlaybackController controller;
+    controller.setHistory(history::ColumnarHistory::fromFrames(frames, true));
+    EXPECT_EQ(controller.getHistory().size(), 2u);
+
+    PlaybackOptions options;
+    options.rate_hz = 500;
+    controller.setOptions(options);
+
+    int changes = 0;
+    int sent = 0;
+    controller.setFrameCallback([&](const ChannelData&) {
+        sent++;
+        return true;
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    controller.start();
+    while (!controller.isComplete()) {
+        if (controller.tick() && controller.currentFrameChanged()) {
+            changes++;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        if (std::chrono::steady_clock::now() - start > std::chrono::seconds(2)) break;
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    EXPECT_TRUE(controller.isComplete());
+    EXPECT_GE(elapsed.count(), 55);  // plays until the last source frame (60ms)
+    EXPECT_GT(sent, changes);
+    EXPECT_LE(changes, 2);
+}
+
 // Callback test
 TEST_F(PlaybackTest, FrameCallback) {
     PlaybackController controller;
@@ -295,3 +355,186 @@ TEST_F(PlaybackTest, SpeedMultiplier) {
     EXPECT_TRUE(controller.isComplete());
     EXPECT_LT(elapsed.count(), 800);  // Should be around 500ms + overhead
 }
+
+// PLY-007: Pause keeps sending the held frame and resume continues from it
+TEST_F(PlaybackTest, PauseHoldsFrame) {
+    PlaybackController controller;
+    controller.setFrames(createFrames(50, 20));  // 1000ms
+
+    PlaybackOptions options;
+    options.rate_hz = 200;
+    controller.setOptions(options);
+
+    std::vector<int16_t> sent;
+    controller.setFrameCallback([&](const ChannelData& ch) {
+        sent.push_back(ch[2]);
+        return true;
+    });
+    controller.start();
+
+    auto run = [&](int ms) {
+        auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+        while (std::chrono::steady_clock::now() < end) {
+            controller.tick();
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    };
+
+    run(100);
+    controller.pause();
+    uint32_t paused_at = controller.getPlaybackTimeMs();
+    size_t before = sent.size();
+    run(200);
+
+    EXPECT_EQ(controller.getState(), PlaybackState::Paused);
+    EXPECT_GT(sent.size(), before + 20);  // Still sending at the slot rate
+    for (size_t i = before; i < sent.size(); i++) {
+        EXPECT_EQ(sent[i], sent[before]);
+    }
+    EXPECT_EQ(controller.getPlaybackTimeMs(), paused_at);
+
+    // No jump by the paused duration
+    controller.resume();
+    run(20);
+    EXPECT_GE(controller.getPlaybackTimeMs(), paused_at);
+    EXPECT_LT(controller.getPlaybackTimeMs(), paused_at + 100);
+}
+
+// PLY-008: Seek moves the position, speed changes keep it
+TEST_F(PlaybackTest, SeekAndSpeed) {
+    PlaybackController controller;
+    controller.setFrames(createFrames(50, 20));  // 1000ms
+
+    PlaybackOptions options;
+    options.rate_hz = 200;
+    controller.setOptions(options);
+    controller.setFrameCallback([](const ChannelData&) { return true; });
+    controller.start();
+
+    controller.seek(150);
+    EXPECT_EQ(controller.getPlaybackTimeMs(), 150u);
+    EXPECT_EQ(controller.getCurrentFrame()[2], CRSF_CHANNEL_MIN + 7);  // Frame at 140ms
+
+    controller.setSpeed(0.5);
+    EXPECT_EQ(controller.getOptions().speed, 0.5);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    controller.tick();
+    EXPECT_GE(controller.getPlaybackTimeMs(), 150u);
+    EXPECT_LT(controller.getPlaybackTimeMs(), 200u);
+
+    // Clamped to the play range
+    controller.seek(5000);
+    EXPECT_EQ(controller.getPlaybackTimeMs(), 979u);
+}
+
+// PLY-009: Reverse playback runs from the end back to the start
+TEST_F(PlaybackTest, ReversePlayback) {
+    PlaybackController controller;
+    controller.setFrames(createFrames(10, 10));  // 0..90ms
+
+    PlaybackOptions options;
+    options.rate_hz = 1000;
+    options.reverse = true;
+    controller.setOptions(options);
+
+    std::vector<int16_t> sent;
+    controller.setFrameCallback([&](const ChannelData& ch) {
+        sent.push_back(ch[2]);
+        return true;
+    });
+
+    auto t0 = std::chrono::steady_clock::now();
+    controller.start(t0);
+    for (int i = 1; i <= 200 && !controller.isComplete(); i++) {
+        controller.tick(t0 + std::chrono::milliseconds(i));
+    }
+
+    EXPECT_TRUE(controller.isComplete());
+    ASSERT_FALSE(sent.empty());
+    EXPECT_EQ(sent.front(), CRSF_CHANNEL_MIN + 8);
+    EXPECT_EQ(sent.back(), CRSF_CHANNEL_MIN);
+    for (size_t i = 1; i < sent.size(); i++) {
+        EXPECT_LE(sent[i], sent[i - 1]);
+    }
+}
+
+// PLY-010: Ping-pong loops turn around without jumping
+TEST_F(PlaybackTest, PingPongLoop) {
+    PlaybackController controller;
+    controller.setFrames(createFrames(11, 10));  // 0..100ms
+
+    PlaybackOptions options;
+    options.rate_hz = 1000;
+    options.loop = true;
+    options.loop_count = 3;
+    options.loop_mode = LoopMode::PingPong;
+    controller.setOptions(options);
+
+    std::vector<uint32_t> times;
+    controller.setFrameCallback([&](const ChannelData&) {
+        times.push_back(controller.getPlaybackTimeMs());
+        return true;
+    });
+
+    auto t0 = std::chrono::steady_clock::now();
+    controller.start(t0);
+    for (int i = 1; i <= 1000 && !controller.isComplete(); i++) {
+        controller.tick(t0 + std::chrono::milliseconds(i));
+    }
+
+    EXPECT_TRUE(controller.isComplete());
+    EXPECT_EQ(controller.getStats().loops_completed, 3u);
+    int turns = 0;
+    for (size_t i = 1; i < times.size(); i++) {
+        int64_t step = static_cast<int64_t>(times[i]) - static_cast<int64_t>(times[i - 1]);
+        EXPECT_LE(std::abs(step), 2) << "at " << i;
+        if (i >= 2) {
+            int64_t previous = static_cast<int64_t>(times[i - 1]) - static_cast<int64_t>(times[i - 2]);
+            if ((step < 0) != (previous < 0) && step != 0 && previous != 0) {
+                turns++;
+            }
+        }
+    }
+    EXPECT_EQ(turns, 2);
+}
+
+// PLY-011: Crossfade removes the jump at the loop wrap
+TEST_F(PlaybackTest, CrossfadeAtWrap) {
+    auto maxStep = [&](uint32_t crossfade_ms) {
+        PlaybackController controller;
+        std::vector<HistoryFrame> frames = createFrames(11, 10);  // 0..100ms
+        for (size_t i = 0; i < frames.size(); i++) {
+            frames[i].channels[2] = static_cast<int16_t>(CRSF_CHANNEL_MIN + i * 10);
+        }
+        controller.setFrames(frames);
+
+        PlaybackOptions options;
+        options.rate_hz = 1000;
+        options.loop = true;
+        options.loop_count = 3;
+        options.crossfade_ms = crossfade_ms;
+        controller.setOptions(options);
+
+        int16_t last = -1;
+        int max_step = 0;
+        controller.setFrameCallback([&](const ChannelData& ch) {
+            if (last >= 0) {
+                max_step = std::max(max_step, std::abs(ch[2] - last));
+            }
+            last = ch[2];
+            return true;
+        });
+
+        auto t0 = std::chrono::steady_clock::now();
+        controller.start(t0);
+        for (int i = 1; i <= 1000 && !controller.isComplete(); i++) {
+            controller.tick(t0 + std::chrono::milliseconds(i));
+        }
+        EXPECT_TRUE(controller.isComplete());
+        EXPECT_EQ(controller.getStats().loops_completed, 3u);
+        return max_step;
+    };
+
+    EXPECT_GE(maxStep(0), 80);      // Hard jump from the end back to the start
+    EXPECT_LE(maxStep(30), 20);     // Frame steps plus the blend slope
+}
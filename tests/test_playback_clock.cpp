@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <random>
+
+#include "playback/playback_clock.hpp"
+#include "playback/playback_controller.hpp"
+
+using namespace elrs;
+using namespace elrs::playback;
+
+class PlaybackClockTest : public ::testing::Test {
+protected:
+    using ms = std::chrono::milliseconds;
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+
+    std::chrono::steady_clock::time_point at(int64_t offset_ms) const {
+        return t0 + ms(offset_ms);
+    }
+};
+
+// CLK-001: Speed changes keep the position continuous
+TEST_F(PlaybackClockTest, SpeedChangeIsContinuous) {
+    PlaybackClock clock;
+    clock.start(at(0), 100.0, 1.0);
+    EXPECT_DOUBLE_EQ(clock.position(at(50)), 150.0);
+
+    clock.setSpeed(at(50), 2.0);
+    EXPECT_DOUBLE_EQ(clock.position(at(50)), 150.0);
+    EXPECT_DOUBLE_EQ(clock.position(at(60)), 170.0);
+
+    clock.setSpeed(at(60), 0.25);
+    EXPECT_DOUBLE_EQ(clock.position(at(60)), 170.0);
+    EXPECT_DOUBLE_EQ(clock.position(at(100)), 180.0);
+
+    clock.setSpeed(at(100), 0.0);   // Ignored
+    EXPECT_DOUBLE_EQ(clock.speed(), 0.25);
+}
+
+// CLK-002: Pause holds the position, resume continues from it
+TEST_F(PlaybackClockTest, PauseResume) {
+    PlaybackClock clock;
+    clock.start(at(0), 0.0, 1.5);
+    clock.pause(at(100));
+    EXPECT_TRUE(clock.isPaused());
+    EXPECT_DOUBLE_EQ(clock.position(at(100)), 150.0);
+    EXPECT_DOUBLE_EQ(clock.position(at(5000)), 150.0);
+
+    // Speed change and seek while paused apply on resume
+    clock.setSpeed(at(200), 1.0);
+    clock.seek(at(300), 400.0);
+    EXPECT_DOUBLE_EQ(clock.position(at(400)), 400.0);
+
+    clock.resume(at(1000));
+    EXPECT_FALSE(clock.isPaused());
+    EXPECT_DOUBLE_EQ(clock.position(at(1000)), 400.0);
+    EXPECT_DOUBLE_EQ(clock.position(at(1010)), 410.0);
+}
+
+// CLK-003: Many speed changes do not accumulate rounding
+TEST_F(PlaybackClockTest, NoDriftAcrossChanges) {
+    PlaybackClock clock;
+    clock.start(at(0), 0.0, 1.0);
+    for (int i = 1; i <= 1000; i++) {
+        clock.setSpeed(t0 + std::chrono::microseconds(i * 2000), (i % 2) ? 3.0 : 1.0);
+    }
+    // 500 intervals of 2ms at speed 1.0 and 500 at 3.0
+    EXPECT_NEAR(clock.position(at(2000)), 4000.0, 1e-6);
+}
+
+// CLK-004: Cursor walks give the same frame as a binary search
+TEST_F(PlaybackClockTest, CursorMatchesSearch) {
+    std::vector<uint32_t> timestamps;
+    for (uint32_t t = 100; t < 10000; t += 7) {
+        timestamps.push_back(t);
+    }
+
+    auto reference = [&](uint32_t t) {
+        size_t index = 0;
+        for (size_t i = 0; i < timestamps.size(); i++) {
+            if (timestamps[i] <= t) {
+                index = i;
+            }
+        }
+        return index;
+    };
+
+    FrameCursor cursor;
+    std::mt19937 rng(42);
+    uint32_t t = 0;
+    for (int i = 0; i < 20000; i++) {
+        switch (rng() % 4) {
+            case 0: t = rng() % 11000; break;               // Jump
+            case 1: t = t >= 5 ? t - rng() % 5 : 0; break;  // Small step back
+            default: t = std::min<uint32_t>(t + rng() % 20, 11000); break;
+        }
+        ASSERT_EQ(cursor.advance(timestamps, t), reference(t)) << "t=" << t;
+    }
+
+    EXPECT_EQ(cursor.seek(timestamps, 0), 0u);
+    EXPECT_EQ(cursor.seek(timestamps, 107), 1u);
+    EXPECT_EQ(cursor.seek(timestamps, 20000), timestamps.size() - 1);
+}
+
+// CLK-005: Speed change mid-run does not jump the played position
+TEST_F(PlaybackClockTest, ControllerSpeedChange) {
+    std::vector<HistoryFrame> frames(1000);
+    for (size_t i = 0; i < frames.size(); i++) {
+        frames[i].timestamp_ms = static_cast<uint32_t>(i * 10);
+        frames[i].channels.fill(CRSF_CHANNEL_MID);
+    }
+    PlaybackController controller;
+    controller.setFrames(frames);
+    PlaybackOptions options;
+    options.rate_hz = 1000;
+    controller.setOptions(options);
+    controller.setFrameCallback([](const ChannelData&) { return true; });
+    controller.start();
+
+    auto run = [&](int duration_ms) {
+        auto end = std::chrono::steady_clock::now() + ms(duration_ms);
+        while (std::chrono::steady_clock::now() < end) {
+            controller.tick();
+        }
+    };
+
+    run(50);
+    uint32_t before = controller.getPlaybackTimeMs();
+    controller.setSpeed(4.0);
+    run(5);
+    // ~5ms at 4x, not the whole elapsed time rescaled
+    EXPECT_GE(controller.getPlaybackTimeMs(), before);
+    EXPECT_LT(controller.getPlaybackTimeMs(), before + 60);
+
+    run(20);
+    controller.setSpeed(0.5);
+    uint32_t slowed = controller.getPlaybackTimeMs();
+    run(20);
+    EXPECT_GE(controller.getPlaybackTimeMs(), slowed);
+    EXPECT_LT(controller.getPlaybackTimeMs(), slowed + 20);
+}
+
+// CLK-006: Reverse runs the position backwards and turning is continuous
+TEST_F(PlaybackClockTest, Reverse) {
+    PlaybackClock clock;
+    clock.start(at(0), 1000.0, 2.0, true);
+    EXPECT_TRUE(clock.isReverse());
+    EXPECT_DOUBLE_EQ(clock.position(at(100)), 800.0);
+
+    clock.setReverse(at(100), false);
+    EXPECT_DOUBLE_EQ(clock.position(at(100)), 800.0);
+    EXPECT_DOUBLE_EQ(clock.position(at(110)), 820.0);
+
+    clock.setReverse(at(110), true);
+    clock.setSpeed(at(110), 1.0);   // Keeps the direction
+    EXPECT_TRUE(clock.isReverse());
+    EXPECT_DOUBLE_EQ(clock.position(at(120)), 810.0);
+}
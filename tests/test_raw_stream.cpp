@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "crsf/crsf.hpp"
+#include "playback/raw_stream.hpp"
+
+using namespace elrs;
+using namespace elrs::playback;
+
+class RawStreamTest : public ::testing::Test {
+protected:
+    // Armed for the whole history, throttle ramping up
+    history::ColumnarHistory createHistory(size_t count, uint32_t interval_ms = 20) {
+        std::vector<HistoryFrame> frames;
+        for (size_t i = 0; i < count; i++) {
+            HistoryFrame frame;
+            frame.timestamp_ms = static_cast<uint32_t>(i * interval_ms);
+            frame.channels.fill(CRSF_CHANNEL_MID);
+            frame.channels[2] = static_cast<int16_t>(CRSF_CHANNEL_MIN + 100 + i);
+            frame.channels[4] = CRSF_CHANNEL_MAX;
+            frames.push_back(frame);
+        }
+        return history::ColumnarHistory::fromFrames(frames);
+    }
+
+    PlaybackOptions options(double rate_hz = 50) {
+        PlaybackOptions opts;
+        opts.rate_hz = rate_hz;
+        return opts;
+    }
+};
+
+// RAW-001: Slots follow the playback slot grid
+TEST_F(RawStreamTest, SlotDeadlines) {
+    auto stream = renderRawStream(createHistory(10), options(), safety::SafetyConfig{});
+
+    EXPECT_EQ(stream.interval_ns, 20000000u);
+    ASSERT_FALSE(stream.slots.empty());
+    for (size_t i = 0; i < stream.slots.size(); i++) {
+        EXPECT_EQ(stream.slots[i].deadline_ns, (i + 1) * stream.interval_ns);
+        EXPECT_EQ(stream.slots[i].size, CRSF_RC_FRAME_SIZE);
+    }
+    // 180ms history at 50Hz: slots at 20..160ms
+    EXPECT_EQ(stream.slots.size(), 8u);
+}
+
+// RAW-002: Safety shaping uses the virtual clock (arm delay in slots)
+TEST_F(RawStreamTest, ArmDelayOnVirtualClock) {
+    safety::SafetyConfig safety_config;
+    safety_config.arm_delay_ms = 100;
+
+    auto stream = renderRawStream(createHistory(50), options(), safety_config);
+    ASSERT_GT(stream.slots.size(), 10u);
+
+    auto throttleAt = [&](size_t slot) {
+        ChannelData channels{};
+        const uint8_t* frame = stream.data.data() + stream.slots[slot].offset;
+        crsf::unpackChannels(frame + 3, channels);
+        return channels[2];
+    };
+
+    // Arm requested at slot 0 (20ms), armed at 120ms (slot 5); throttle
+    // passes through from the following slot
+    EXPECT_EQ(throttleAt(0), CRSF_CHANNEL_MIN);
+    EXPECT_EQ(throttleAt(5), CRSF_CHANNEL_MIN);
+    EXPECT_GT(throttleAt(6), CRSF_CHANNEL_MIN);
+}
+
+// RAW-003: Rendering is reproducible and round-trips through the file layout
+TEST_F(RawStreamTest, EncodeRoundTrip) {
+    auto first = encodeRawStream(renderRawStream(createHistory(20), options(), {}));
+    auto second = encodeRawStream(renderRawStream(createHistory(20), options(), {}));
+    EXPECT_EQ(first, second);
+
+    auto stream = renderRawStream(createHistory(20), options(), {});
+    RawStreamReader reader;
+    ASSERT_TRUE(reader.openBuffer(first.data(), first.size()).ok());
+    EXPECT_EQ(reader.slotCount(), stream.slots.size());
+    EXPECT_EQ(reader.intervalNs(), stream.interval_ns);
+    EXPECT_DOUBLE_EQ(reader.rateHz(), 50.0);
+    for (size_t i = 0; i < reader.slotCount(); i++) {
+        auto slot = reader.slot(i);
+        EXPECT_EQ(slot.deadline_ns, stream.slots[i].deadline_ns);
+        ASSERT_EQ(slot.size, stream.slots[i].size);
+        EXPECT_EQ(std::memcmp(reader.slotData(slot),
+                              stream.data.data() + stream.slots[i].offset, slot.size), 0);
+    }
+}
+
+// RAW-004: Held keyframes share their bytes; infinite loops need a slot limit
+TEST_F(RawStreamTest, HeldFramesAndLoopLimit) {
+    std::vector<HistoryFrame> frames{{0, {}}, {1000, {}}};
+    frames[0].channels.fill(CRSF_CHANNEL_MID);
+    frames[1].channels.fill(CRSF_CHANNEL_MID);
+
+    auto opts = options(500);
+    opts.loop = true;
+    auto stream = renderRawStream(history::ColumnarHistory::fromFrames(frames, true),
+                                  opts, {}, 2000);
+
+    EXPECT_EQ(stream.slots.size(), 2000u);
+    EXPECT_EQ(stream.data.size(), static_cast<size_t>(CRSF_RC_FRAME_SIZE));
+    EXPECT_EQ(stream.slots.back().offset, 0u);
+}
+
+// RAW-005: Corrupt files are rejected on open
+TEST_F(RawStreamTest, RejectCorrupt) {
+    auto bytes = encodeRawStream(renderRawStream(createHistory(10), options(), {}));
+    RawStreamReader reader;
+
+    EXPECT_FALSE(reader.openBuffer(bytes.data(), 16).ok());
+
+    auto truncated = bytes;
+    truncated.resize(bytes.size() - 1);
+    EXPECT_FALSE(reader.openBuffer(truncated.data(), truncated.size()).ok());
+
+    auto bad_offset = bytes;
+    bad_offset[40 + 8] = 0xFF;  // First slot's data offset
+    EXPECT_FALSE(reader.openBuffer(bad_offset.data(), bad_offset.size()).ok());
+
+    auto bad_magic = bytes;
+    bad_magic[0] = 'X';
+    EXPECT_FALSE(reader.openBuffer(bad_magic.data(), bad_magic.size()).ok());
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "scheduling/realtime.hpp"
+
+using namespace elrs::scheduling;
+
+class RealtimeTest : public ::testing::Test {};
+
+// RT-001: Kernel CPU list parsing
+TEST_F(RealtimeTest, ParseCpuList) {
+    EXPECT_EQ(parseCpuList("2"), (std::vector<int>{2}));
+    EXPECT_EQ(parseCpuList("0-2,5"), (std::vector<int>{0, 1, 2, 5}));
+    EXPECT_EQ(parseCpuList("3,1-2\n"), (std::vector<int>{1, 2, 3}));
+    EXPECT_TRUE(parseCpuList("").empty());
+    EXPECT_EQ(parseCpuList("x,2"), (std::vector<int>{2}));
+}
+
+// RT-002: CPU list formatting collapses ranges
+TEST_F(RealtimeTest, FormatCpuList) {
+    EXPECT_EQ(formatCpuList({0, 1, 2, 5}), "0-2,5");
+    EXPECT_EQ(formatCpuList({3}), "3");
+    EXPECT_EQ(formatCpuList({}), "");
+    EXPECT_EQ(formatCpuList(parseCpuList("2-3,6-7")), "2-3,6-7");
+}
+
+// RT-003: Explicit affinity takes precedence over isolated CPUs
+TEST_F(RealtimeTest, SelectExplicitAffinity) {
+    RealtimeOptions options;
+    options.cpu_affinity = {1};
+    EXPECT_EQ(selectRealtimeCpus(options, {2, 3}, {3}), (std::vector<int>{1}));
+}
+
+// RT-004: Isolated + nohz_full CPUs are preferred
+TEST_F(RealtimeTest, SelectIsolatedCpus) {
+    RealtimeOptions options;
+    EXPECT_EQ(selectRealtimeCpus(options, {2, 3}, {3}), (std::vector<int>{3}));
+    EXPECT_EQ(selectRealtimeCpus(options, {2, 3}, {}), (std::vector<int>{2, 3}));
+    EXPECT_TRUE(selectRealtimeCpus(options, {}, {3}).empty());
+
+    options.prefer_isolated_cpus = false;
+    EXPECT_TRUE(selectRealtimeCpus(options, {2, 3}, {3}).empty());
+}
+
+// RT-005: Unknown UART has no IRQ
+TEST_F(RealtimeTest, UnknownUartIrq) {
+    EXPECT_EQ(findUartIrq("/dev/nonexistent_tty"), -1);
+    EXPECT_EQ(findUartIrq(""), -1);
+    EXPECT_EQ(findIrqThread(-1), -1);
+}
+
+// RT-006: Prefault helpers do not crash and fault counters are monotonic
+TEST_F(RealtimeTest, PrefaultAndFaultCounts) {
+    auto before = getPageFaultCounts();
+    prefaultHeap(256 * 1024);
+    prefaultStack(64 * 1024);
+    auto after = getPageFaultCounts();
+
+    EXPECT_GE(after.minor, before.minor);
+    EXPECT_GE(after.major, before.major);
+}
+
+// RT-007: Stack prefault larger than the thread's stack is clamped
+TEST_F(RealtimeTest, PrefaultStackClamped) {
+    // Default std::thread stacks are typically 8MB; ask for more
+    std::thread thread([] { prefaultStack(64 * 1024 * 1024); });
+    thread.join();
+    SUCCEED();
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
+#include <atomic>
 #include <chrono>
+#include <csignal>
 #include <thread>
 
 #include "safety/safety_monitor.hpp"
@@ -197,3 +199,83 @@ TEST_F(SafetyTest, EmergencyStopOverrides) {
     // Should still be in emergency stop
     EXPECT_EQ(monitor.getState(), SafetyState::EmergencyStop);
 }
+
+// SAF-001: A shutdown signal wakes a thread sleeping until its next slot
+TEST_F(SafetyTest, ShutdownSignalWakesSender) {
+    SafetyMonitor::installSignalHandlers(&monitor);
+    EXPECT_EQ(SafetyMonitor::getShutdownSignalTimeNs(), 0);
+
+    // Times out normally without a signal
+    EXPECT_FALSE(SafetyMonitor::waitForShutdown(std::chrono::milliseconds(5)));
+
+    bool woken = false;
+    auto wake_time = std::chrono::steady_clock::time_point{};
+    std::thread sender([&] {
+        woken = SafetyMonitor::waitForShutdown(std::chrono::seconds(5));
+        wake_time = std::chrono::steady_clock::now();
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    auto signal_time = std::chrono::steady_clock::now();
+    std::raise(SIGINT);
+    sender.join();
+
+    EXPECT_TRUE(woken);
+    EXPECT_LT(wake_time - signal_time, std::chrono::milliseconds(500));
+    EXPECT_EQ(monitor.getState(), SafetyState::EmergencyStop);
+
+    // Signal time is on the steady_clock timeline
+    int64_t signal_ns = SafetyMonitor::getShutdownSignalTimeNs();
+    int64_t before_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        signal_time.time_since_epoch()).count();
+    EXPECT_GE(signal_ns, before_ns);
+    EXPECT_LT(signal_ns - before_ns, 500000000);
+
+    // Stays signalled: later waits return immediately
+    EXPECT_TRUE(SafetyMonitor::waitForShutdown(std::chrono::seconds(5)));
+
+    // Reinstalling resets the request
+    SafetyMonitor::installSignalHandlers(nullptr);
+    EXPECT_FALSE(SafetyMonitor::isShutdownRequested());
+    EXPECT_FALSE(SafetyMonitor::waitForShutdown(std::chrono::milliseconds(1)));
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+}
+
+// SAF-002: Sender, watchdog and checker threads share one monitor
+TEST_F(SafetyTest, ConcurrentCallers) {
+    std::atomic<bool> running{true};
+    std::atomic<int> failsafe_seen{0};
+
+    std::thread checker([&] {
+        while (running.load()) {
+            monitor.checkFailsafe();
+            if (monitor.getState() == SafetyState::Failsafe) {
+                failsafe_seen++;
+            }
+        }
+    });
+
+    // Frames are sent continuously, so the failsafe never trips
+    auto channels = createChannels(CRSF_CHANNEL_MAX);
+    auto end = std::chrono::steady_clock::now() +
+               std::chrono::milliseconds(config.arm_delay_ms + 100);
+    while (std::chrono::steady_clock::now() < end) {
+        auto frame = channels;
+        monitor.processChannels(frame);
+        monitor.notifyFrameSent();
+    }
+    EXPECT_EQ(monitor.getState(), SafetyState::Armed);
+
+    // A stalled sender is caught by the checker thread
+    std::this_thread::sleep_for(std::chrono::milliseconds(config.failsafe_timeout_ms + 50));
+    EXPECT_EQ(monitor.getState(), SafetyState::Failsafe);
+
+    // Emergency stop from another thread wins over the checker
+    std::thread([&] { monitor.emergencyStop(); }).join();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    running = false;
+    checker.join();
+
+    EXPECT_GT(failsafe_seen.load(), 0);
+    EXPECT_EQ(monitor.getState(), SafetyState::EmergencyStop);
+}
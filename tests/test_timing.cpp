@@ -4,6 +4,9 @@
 #include <thread>
 
 #include "playback/playback_controller.hpp"
+#include "scheduling/latency_histogram.hpp"
+#include "scheduling/realtime.hpp"
+#include "scheduling/start_barrier.hpp"
 
 using namespace elrs;
 using namespace elrs::playback;
@@ -90,3 +93,141 @@ TEST_F(TimingTest, MaxJitterTracked) {
         EXPECT_GE(stats.max_jitter_us, stats.timing_jitter_us);
     }
 }
+
+// TIM-003: Latency histogram percentiles
+TEST_F(TimingTest, LatencyHistogramPercentiles) {
+    scheduling::LatencyHistogram histogram(1000);
+    for (int i = 1; i <= 100; i++) {
+        histogram.record(i);
+    }
+
+    EXPECT_EQ(histogram.count(), 100u);
+    EXPECT_EQ(histogram.percentile(50.0), 50);
+    EXPECT_EQ(histogram.percentile(99.0), 99);
+    EXPECT_EQ(histogram.percentile(100.0), 100);
+    EXPECT_EQ(histogram.max(), 100);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 50.5);
+}
+
+// TIM-004: Out-of-range samples report the observed maximum
+TEST_F(TimingTest, LatencyHistogramOverflow) {
+    scheduling::LatencyHistogram histogram(100);
+    histogram.record(-5);
+    histogram.record(5000);
+
+    EXPECT_EQ(histogram.percentile(50.0), 0);
+    EXPECT_EQ(histogram.percentile(100.0), 5000);
+
+    histogram.reset();
+    EXPECT_EQ(histogram.count(), 0u);
+    EXPECT_EQ(histogram.percentile(99.0), 0);
+}
+
+// TIM-005: Playback records per-slot latency and reports missed slots
+TEST_F(TimingTest, PlaybackRecordsLatency) {
+    PlaybackController controller;
+    controller.setFrames(createFrames(100, 10));
+
+    PlaybackOptions options;
+    options.rate_hz = 100.0;
+    controller.setOptions(options);
+    controller.setFrameCallback([](const ChannelData&) { return true; });
+
+    scheduling::LatencyHistogram histogram;
+    controller.setLatencyHistogram(&histogram);
+    controller.start();
+
+    // Stall for 5 intervals: the slot clock must snap forward
+    std::this_thread::sleep_for(std::chrono::milliseconds(55));
+    controller.tick();
+
+    auto stats = controller.getStats();
+    EXPECT_EQ(histogram.count(), 1u);
+    EXPECT_GE(histogram.max(), 40000);
+    EXPECT_GE(stats.missed_slots, 3u);
+    EXPECT_GT(controller.getNextSendTime(), std::chrono::steady_clock::now() -
+        std::chrono::milliseconds(10));
+}
+
+// TIM-006: Start barrier releases all parties with one start time
+TEST_F(TimingTest, StartBarrierSharedStartTime) {
+    scheduling::StartBarrier barrier(3);
+    std::chrono::steady_clock::time_point times[3];
+
+    std::thread t1([&] { times[1] = barrier.arriveAndWait(); });
+    std::thread t2([&] { times[2] = barrier.arriveAndWait(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    times[0] = barrier.arriveAndWait();
+    t1.join();
+    t2.join();
+
+    EXPECT_EQ(times[0], times[1]);
+    EXPECT_EQ(times[0], times[2]);
+}
+
+// TIM-007: Anchored start staggers the slot clock
+TEST_F(TimingTest, AnchoredStartStaggersSlots) {
+    PlaybackOptions options;
+    options.rate_hz = 100.0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    PlaybackController a;
+    PlaybackController b;
+    a.setFrames(createFrames(10, 10));
+    b.setFrames(createFrames(10, 10));
+    a.setOptions(options);
+    b.setOptions(options);
+    a.start(t0);
+    b.start(t0 + std::chrono::milliseconds(5));
+
+    EXPECT_EQ(a.getNextSendTime(), t0 + std::chrono::milliseconds(10));
+    EXPECT_EQ(b.getNextSendTime(), t0 + std::chrono::milliseconds(15));
+}
+
+// TIM-008: Barrier with a fixed start time releases at that time
+TEST_F(TimingTest, StartBarrierFixedStartTime) {
+    auto target = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    scheduling::StartBarrier barrier(1);
+    barrier.setStartTime(target);
+    EXPECT_EQ(barrier.arriveAndWait(), target);
+
+    // A start time in the past is clamped to the release time
+    auto past = std::chrono::steady_clock::now() - std::chrono::seconds(5);
+    scheduling::StartBarrier late(1);
+    late.setStartTime(past);
+    EXPECT_GT(late.arriveAndWait(), past);
+}
+
+// TIM-009: Realtime deadline maps onto the monotonic clock
+TEST_F(TimingTest, MapRealtimeToSteady) {
+    auto real_target = std::chrono::system_clock::now() + std::chrono::seconds(2);
+    auto steady_target = scheduling::mapRealtimeToSteady(real_target);
+    auto expected = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+
+    auto error = std::chrono::duration_cast<std::chrono::milliseconds>(
+        steady_target - expected);
+    EXPECT_LE(std::abs(error.count()), 5);
+}
+
+// TIM-010: Start error is measured against the first slot deadline
+TEST_F(TimingTest, StartErrorReported) {
+    PlaybackController controller;
+    controller.setFrames(createFrames(100, 10));
+
+    PlaybackOptions options;
+    options.rate_hz = 100.0;
+    controller.setOptions(options);
+    controller.setFrameCallback([](const ChannelData&) { return true; });
+
+    // First slot 20ms from now
+    controller.start(std::chrono::steady_clock::now() + std::chrono::milliseconds(10));
+    EXPECT_FALSE(controller.tick());
+
+    while (!controller.tick()) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+
+    auto stats = controller.getStats();
+    EXPECT_GE(stats.start_error_us, 0.0);
+    EXPECT_LT(stats.start_error_us, 5000.0);
+}